@@ -0,0 +1,177 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "cargs.h"
+
+#define BUILD_OPTIONS(X)                                                                           \
+    X(BUILD_HELP, HELP_OPTION(FLAGS(FLAG_EXIT)))                                                   \
+    X(BUILD_JOBS, OPTION_INT('j', "jobs", HELP("Parallel jobs")))                                  \
+    X(BUILD_KEEP_GOING, OPTION_FLAG('k', "keep-going", HELP("Keep going after errors")))
+
+CARGS_OPTIONS_X(build_options, BUILD_OPTIONS)
+
+#define ACCESSOR_OPTIONS(X)                                                                        \
+    X(OPT_HELP, HELP_OPTION(FLAGS(FLAG_EXIT)))                                                     \
+    X(OPT_VERSION, VERSION_OPTION(FLAGS(FLAG_EXIT)))                                               \
+    X(OPT_VERBOSE, OPTION_FLAG('v', "verbose", HELP("Verbose output")))                            \
+    X(OPT_QUIET, OPTION_FLAG('q', "quiet", HELP("Quiet output")))                                  \
+    X(OPT_OUTPUT, OPTION_STRING('o', "output", HELP("Output file")))                               \
+    X(OPT_CONFIG, OPTION_STRING('c', "config", HELP("Configuration file")))                        \
+    X(OPT_LEVEL, OPTION_INT('l', "level", HELP("Processing level")))                               \
+    X(OPT_TIMEOUT, OPTION_INT('t', "timeout", HELP("Timeout")))                                    \
+    X(OPT_RATIO, OPTION_FLOAT('r', "ratio", HELP("Ratio")))                                        \
+    X(OPT_PORTS, OPTION_ARRAY_INT('p', "ports", HELP("Ports")))                                    \
+    X(OPT_MEMORY, OPTION_MAP_INT('m', "memory", HELP("Memory limits")))                            \
+    X(OPT_BUILD, SUBCOMMAND("build", build_options, HELP("Build the project")))
+
+CARGS_OPTIONS_X(accessor_options, ACCESSOR_OPTIONS)
+
+static char *command_line[] = {"bench", "-v", "-o", "out.txt", "-l", "3", "-t", "30",
+                               "--ports=80,443,8080", "--memory=heap=512,stack=8", "build",
+                               "-j", "8"};
+#define COMMAND_LINE_ARGC ((int)(sizeof(command_line) / sizeof(command_line[0])))
+
+// Reads done per iteration: a typical configuration pass
+#define READS_PER_ITERATION 8
+
+// Result accumulated by the loops so that the reads are not optimized away
+static volatile long long sink;
+
+double measure_by_value(cargs_t cargs, int iterations)
+{
+    long long sum   = 0;
+    clock_t   start = clock();
+
+    for (int i = 0; i < iterations; ++i) {
+        sum += cargs_get(cargs, "level").as_int;
+        sum += cargs_get(cargs, "timeout").as_int;
+        sum += cargs_is_set(cargs, "verbose");
+        sum += cargs_is_set(cargs, "quiet");
+        sum += cargs_count(cargs, "ports");
+        sum += cargs_array_get(cargs, "ports", 1).as_int;
+        sum += cargs_map_get(cargs, "memory", "heap").as_int;
+        sum += cargs_get(cargs, "build.jobs").as_int;
+    }
+    sink = sum;
+    return ((double)(clock() - start)) / CLOCKS_PER_SEC;
+}
+
+double measure_by_reference(const cargs_t *cargs, int iterations)
+{
+    long long sum   = 0;
+    clock_t   start = clock();
+
+    for (int i = 0; i < iterations; ++i) {
+        sum += cargs_get_ref(cargs, "level").as_int;
+        sum += cargs_get_ref(cargs, "timeout").as_int;
+        sum += cargs_is_set_ref(cargs, "verbose");
+        sum += cargs_is_set_ref(cargs, "quiet");
+        sum += cargs_count_ref(cargs, "ports");
+        sum += cargs_array_get_ref(cargs, "ports", 1).as_int;
+        sum += cargs_map_get_ref(cargs, "memory", "heap").as_int;
+        sum += cargs_get_ref(cargs, "build.jobs").as_int;
+    }
+    sink = sum;
+    return ((double)(clock() - start)) / CLOCKS_PER_SEC;
+}
+
+typedef struct accessor_handles_s
+{
+    cargs_handle_t level, timeout, verbose, quiet, ports, memory, jobs;
+} accessor_handles_t;
+
+double measure_by_handle(const accessor_handles_t *h, int iterations)
+{
+    long long sum   = 0;
+    clock_t   start = clock();
+
+    for (int i = 0; i < iterations; ++i) {
+        sum += cargs_get_h(h->level).as_int;
+        sum += cargs_get_h(h->timeout).as_int;
+        sum += cargs_is_set_h(h->verbose);
+        sum += cargs_is_set_h(h->quiet);
+        sum += cargs_count_h(h->ports);
+        sum += cargs_array_get_h(h->ports, 1).as_int;
+        sum += cargs_map_get_h(h->memory, "heap").as_int;
+        sum += cargs_get_h(h->jobs).as_int;
+    }
+    sink = sum;
+    return ((double)(clock() - start)) / CLOCKS_PER_SEC;
+}
+
+double measure_by_id(const cargs_t *cargs, int iterations)
+{
+    long long      sum    = 0;
+    cargs_handle_t memory = cargs_handle_id(cargs, OPT_MEMORY);
+    cargs_handle_t jobs   = cargs_sub_handle_id(cargs_handle_id(cargs, OPT_BUILD), BUILD_JOBS);
+    clock_t        start  = clock();
+
+    for (int i = 0; i < iterations; ++i) {
+        sum += cargs_get_int_id(cargs, OPT_LEVEL);
+        sum += cargs_get_int_id(cargs, OPT_TIMEOUT);
+        sum += cargs_is_set_id(cargs, OPT_VERBOSE);
+        sum += cargs_is_set_id(cargs, OPT_QUIET);
+        sum += cargs_count_id(cargs, OPT_PORTS);
+        sum += cargs_array_get_id(cargs, OPT_PORTS, 1).as_int;
+        sum += cargs_map_get_h(memory, "heap").as_int;
+        sum += cargs_get_h(jobs).as_int;
+    }
+    sink = sum;
+    return ((double)(clock() - start)) / CLOCKS_PER_SEC;
+}
+
+int main(int argc, char **argv)
+{
+    int iterations = argc > 1 ? atoi(argv[1]) : 1000000;
+    if (iterations <= 0)
+        iterations = 1000000;
+
+    cargs_t cargs = cargs_init(accessor_options, "bench", "1.0.0");
+    if (cargs_parse(&cargs, COMMAND_LINE_ARGC, command_line) != CARGS_SUCCESS) {
+        fprintf(stderr, "Unexpected parse failure\n");
+        return 1;
+    }
+
+    printf("=== CARGS ACCESSOR BENCHMARK ===\n\n");
+    printf("Context size: %zu bytes, %d reads per iteration\n\n", sizeof(cargs_t),
+           READS_PER_ITERATION);
+
+    measure_by_value(cargs, iterations / 10);  // Warm-up
+    double by_value = measure_by_value(cargs, iterations);
+    measure_by_reference(&cargs, iterations / 10);
+    double by_reference = measure_by_reference(&cargs, iterations);
+
+    accessor_handles_t handles = {
+        .level   = cargs_resolve(&cargs, "level"),
+        .timeout = cargs_resolve(&cargs, "timeout"),
+        .verbose = cargs_resolve(&cargs, "verbose"),
+        .quiet   = cargs_resolve(&cargs, "quiet"),
+        .ports   = cargs_resolve(&cargs, "ports"),
+        .memory  = cargs_resolve(&cargs, "memory"),
+        .jobs    = cargs_resolve(&cargs, "build.jobs"),
+    };
+    measure_by_handle(&handles, iterations / 10);
+    double by_handle = measure_by_handle(&handles, iterations);
+
+    measure_by_id(&cargs, iterations / 10);
+    double by_id = measure_by_id(&cargs, iterations);
+
+    double reads = (double)iterations * READS_PER_ITERATION;
+    printf("%-18s | %-12s | %-14s | %-14s\n", "Accessors", "Iterations", "Time/read (ns)",
+           "Reads/s");
+    printf("----------------------------------------------------------------\n");
+    printf("%-18s | %-12d | %-14.2f | %-14.0f\n", "cargs_get", iterations,
+           by_value * 1e9 / reads, by_value > 0 ? reads / by_value : 0.0);
+    printf("%-18s | %-12d | %-14.2f | %-14.0f\n", "cargs_get_ref", iterations,
+           by_reference * 1e9 / reads, by_reference > 0 ? reads / by_reference : 0.0);
+    printf("%-18s | %-12d | %-14.2f | %-14.0f\n", "cargs_get_h", iterations,
+           by_handle * 1e9 / reads, by_handle > 0 ? reads / by_handle : 0.0);
+    printf("%-18s | %-12d | %-14.2f | %-14.0f\n", "cargs_get_int_id", iterations,
+           by_id * 1e9 / reads, by_id > 0 ? reads / by_id : 0.0);
+    printf("\nSpeedup of _ref: %.2fx, of handles: %.2fx, of IDs: %.2fx\n",
+           by_reference > 0 ? by_value / by_reference : 0.0,
+           by_handle > 0 ? by_value / by_handle : 0.0, by_id > 0 ? by_value / by_id : 0.0);
+
+    cargs_free(&cargs);
+    return 0;
+}
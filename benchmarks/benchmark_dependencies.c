@@ -0,0 +1,136 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <string.h>
+#include "cargs.h"
+
+// Each "f" flag requires the next DEPS_PER_OPTION flags and conflicts with
+// as many "g" flags. Every "f" flag is set on the command line and no "g"
+// flag is, so validation has to check every dependency and succeeds.
+#define DEPS_PER_OPTION 4
+
+typedef struct dependency_set_s
+{
+    cargs_option_t *options;
+    char          **names;
+    const char   ***lists;
+    char          **argv;
+    int             argc;
+    size_t          count;
+} dependency_set_t;
+
+// Help option copied at the head of every generated array
+CARGS_OPTIONS(
+    help_options,
+    HELP_OPTION(FLAGS(FLAG_EXIT))
+)
+
+static char *make_name(char prefix, size_t index)
+{
+    char *name = malloc(24);
+    snprintf(name, 24, "%c%zu", prefix, index);
+    return name;
+}
+
+// Build 2 * count flags at runtime: count "f" flags and count "g" flags
+dependency_set_t build_dependency_set(size_t count)
+{
+    dependency_set_t set = {.count = count};
+
+    set.options = calloc(2 * count + 2, sizeof(cargs_option_t));
+    set.names   = calloc(2 * count, sizeof(char *));
+    set.lists   = calloc(2 * count, sizeof(char **));
+    set.argv    = calloc(count + 1, sizeof(char *));
+
+    set.options[0] = help_options[0];
+    for (size_t i = 0; i < 2 * count; ++i) {
+        set.names[i]       = make_name(i < count ? 'f' : 'g', i % count);
+        set.options[i + 1] = OPTION_FLAG('\0', set.names[i], HELP("Generated flag"));
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        const char **requires  = calloc(DEPS_PER_OPTION + 1, sizeof(char *));
+        const char **conflicts = calloc(DEPS_PER_OPTION + 1, sizeof(char *));
+
+        for (size_t d = 0; d < DEPS_PER_OPTION; ++d) {
+            requires[d]  = set.names[(i + d + 1) % count];
+            conflicts[d] = set.names[count + (i * 7 + d) % count];
+        }
+        set.options[i + 1].requires  = requires;
+        set.options[i + 1].conflicts = conflicts;
+        set.lists[2 * i]             = requires;
+        set.lists[2 * i + 1]         = conflicts;
+    }
+    set.options[2 * count + 1] = OPTION_END();
+
+    set.argv[0] = "benchmark";
+    for (size_t i = 0; i < count; ++i) {
+        set.argv[i + 1] = malloc(strlen(set.names[i]) + 3);
+        sprintf(set.argv[i + 1], "--%s", set.names[i]);
+    }
+    set.argc = count + 1;
+    return set;
+}
+
+void free_dependency_set(dependency_set_t *set)
+{
+    for (size_t i = 0; i < 2 * set->count; ++i) {
+        free(set->names[i]);
+        free(set->lists[i]);
+    }
+    for (int i = 1; i < set->argc; ++i)
+        free(set->argv[i]);
+    free(set->names);
+    free(set->lists);
+    free(set->argv);
+    free(set->options);
+}
+
+// Measure the time of one init + parse + free cycle
+double measure_parse_time(dependency_set_t *set, int iterations)
+{
+    clock_t start, end;
+    double  total_time = 0.0;
+
+    for (int i = 0; i < iterations; i++) {
+        start = clock();
+
+        cargs_t cargs  = cargs_init(set->options, "benchmark", "1.0.0");
+        int     status = cargs_parse(&cargs, set->argc, set->argv);
+        cargs_free(&cargs);
+
+        end = clock();
+        total_time += ((double)(end - start)) / CLOCKS_PER_SEC;
+
+        if (status != CARGS_SUCCESS) {
+            fprintf(stderr, "Unexpected parse failure (%d)\n", status);
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    return total_time / iterations;
+}
+
+int main(void)
+{
+    const size_t sizes[]    = {50, 150, 300, 600};
+    const int    iterations = 200;
+
+    printf("=== CARGS DEPENDENCY VALIDATION BENCHMARK ===\n\n");
+    printf("%-10s | %-14s | %-16s | %-14s\n", "Options", "Dependencies", "Time/parse (s)",
+           "Parses/s");
+    printf("------------------------------------------------------------\n");
+
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); ++i) {
+        dependency_set_t set = build_dependency_set(sizes[i]);
+
+        measure_parse_time(&set, iterations / 10);  // Warm-up
+        double time = measure_parse_time(&set, iterations);
+
+        printf("%-10zu | %-14zu | %-16.9f | %-14.0f\n", 2 * sizes[i] + 1,
+               sizes[i] * DEPS_PER_OPTION * 2, time, time > 0 ? 1.0 / time : 0.0);
+        free_dependency_set(&set);
+    }
+
+    return 0;
+}
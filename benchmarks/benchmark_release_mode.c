@@ -3,6 +3,7 @@
 #include <time.h>
 #include <stdbool.h>
 #include <string.h>
+#include <unistd.h>
 #include "cargs.h"
 
 // Test with a large and complex options structure to make the 
@@ -59,6 +60,56 @@ CARGS_OPTIONS(
     POSITIONAL_STRING("input", HELP("Input file"))
 )
 
+// Generated schemas used to check that init time grows linearly
+CARGS_OPTIONS(
+    help_options,
+    HELP_OPTION(FLAGS(FLAG_EXIT))
+)
+
+static char *generated_choices[] = {"alpha", "bravo", "charlie", "delta", "echo",
+                                     "foxtrot", "golf", "hotel", "india", "juliett"};
+
+typedef struct generated_schema_s
+{
+    cargs_option_t *options;
+    char          **names;
+    size_t          count;
+} generated_schema_t;
+
+// Build count options with unique names and short names for the first 26.
+// One option in four is a string restricted to a list of choices.
+generated_schema_t build_schema(size_t count)
+{
+    generated_schema_t schema = {.count = count};
+
+    schema.options = calloc(count + 2, sizeof(cargs_option_t));
+    schema.names   = calloc(count, sizeof(char *));
+
+    schema.options[0] = help_options[0];
+    for (size_t i = 0; i < count; ++i) {
+        schema.names[i] = malloc(32);
+        snprintf(schema.names[i], 32, "option-%zu", i);
+        char sname = i < 26 ? (char)('A' + i) : '\0';
+        if (i % 4 == 0)
+            schema.options[i + 1] =
+                OPTION_STRING(sname, schema.names[i], HELP("Generated option"),
+                              .choices.as_array_string = generated_choices,
+                              .choices_count = sizeof(generated_choices) / sizeof(char *));
+        else
+            schema.options[i + 1] = OPTION_FLAG(sname, schema.names[i], HELP("Generated option"));
+    }
+    schema.options[count + 1] = OPTION_END();
+    return schema;
+}
+
+void free_schema(generated_schema_t *schema)
+{
+    for (size_t i = 0; i < schema->count; ++i)
+        free(schema->names[i]);
+    free(schema->names);
+    free(schema->options);
+}
+
 // Forward declaration of the function
 cargs_t cargs_init_mode(cargs_option_t *options, const char *program_name, const char *version, bool release_mode);
 
@@ -85,6 +136,25 @@ double measure_init_time(cargs_option_t *options, const char *program_name,
     return total_time / iterations;
 }
 
+// Measure release mode init time using the precompiled indexes of a schema blob
+double measure_schema_init_time(cargs_option_t *options, const void *schema, size_t size,
+                                int iterations)
+{
+    clock_t start, end;
+    double  total_time = 0.0;
+
+    for (int i = 0; i < iterations; i++) {
+        start = clock();
+        cargs_t cargs =
+            cargs_init_schema_mode(options, "test_program", "1.0.0", schema, size, true);
+        end = clock();
+        total_time += ((double)(end - start)) / CLOCKS_PER_SEC;
+        cargs_free(&cargs);
+    }
+
+    return total_time / iterations;
+}
+
 // Global variables to store timing results for comparison
 double release_simple_time = 0.0;
 double release_complex_time = 0.0;
@@ -136,6 +206,46 @@ void run_benchmark(bool release_mode)
     }
 }
 
+// Measure init time on schemas of increasing size: normal mode, release mode
+// building the indexes, and release mode reading them from a schema blob
+void run_scaling_benchmark(void)
+{
+    const size_t sizes[] = {10, 100, 1000, 10000};
+    char         path[]  = "/tmp/cargs_benchmark_schema_XXXXXX";
+    int          fd      = mkstemp(path);
+
+    if (fd < 0)
+        return;
+    close(fd);
+
+    printf("===== INIT SCALING =====\n");
+    printf("%-10s | %-12s | %-14s | %-14s | %-14s | %-14s\n", "Options", "Iterations",
+           "Normal (s)", "Per option (s)", "Release (s)", "Schema (s)");
+    printf("--------------------------------------------------------------------------------------\n");
+
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); ++i) {
+        generated_schema_t schema     = build_schema(sizes[i]);
+        int                iterations = (int)(100000 / sizes[i]);
+        size_t             blob_size  = 0;
+        const void        *blob       = NULL;
+
+        if (cargs_schema_save(schema.options, path) == CARGS_SUCCESS)
+            blob = cargs_schema_map(path, &blob_size);
+
+        measure_init_time(schema.options, "test_program", "1.0.0", false, iterations / 10 + 1);
+        double normal  = measure_init_time(schema.options, "test_program", "1.0.0", false, iterations);
+        double release = measure_init_time(schema.options, "test_program", "1.0.0", true, iterations);
+        double mapped  = measure_schema_init_time(schema.options, blob, blob_size, iterations);
+
+        printf("%-10zu | %-12d | %-14.9f | %-14.3e | %-14.9f | %-14.9f\n", sizes[i] + 1, iterations,
+               normal, normal / (double)(sizes[i] + 1), release, mapped);
+        cargs_schema_unmap(blob, blob_size);
+        free_schema(&schema);
+    }
+    unlink(path);
+    printf("======================================================\n\n");
+}
+
 // Function to display comparison between modes
 void display_mode_comparison() {
     printf("\n===== PERFORMANCE COMPARISON: NORMAL vs RELEASE MODE =====\n");
@@ -177,6 +287,7 @@ int main(int argc, char **argv)
         printf("Running benchmarks in NORMAL mode (validation enabled)...\n");
         run_benchmark(false);  // Normal mode (validation enabled)
         printf("\n");
+        run_scaling_benchmark();
     }
     
     // Run release mode
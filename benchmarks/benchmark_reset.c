@@ -0,0 +1,111 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <string.h>
+#ifdef __GLIBC__
+    #include <malloc.h>
+#endif
+#include "cargs.h"
+
+// Command lines of a control-plane daemon: every parse uses the same schema
+CARGS_OPTIONS(
+    route_options,
+    HELP_OPTION(FLAGS(FLAG_EXIT)),
+    OPTION_STRING('g', "gateway", HELP("Gateway address")),
+    OPTION_INT('w', "weight", HELP("Route weight"), DEFAULT(1)),
+    OPTION_ARRAY_INT('p', "ports", HELP("Ports to route")),
+    OPTION_FLAG('f', "force", HELP("Replace an existing route"))
+)
+
+CARGS_OPTIONS(
+    daemon_options,
+    HELP_OPTION(FLAGS(FLAG_EXIT)),
+    OPTION_FLAG('v', "verbose", HELP("Verbose output")),
+    OPTION_STRING('z', "zone", HELP("Zone"),
+                  CHOICES_STRING("eu-west", "eu-east", "us-west", "us-east", "ap-south",
+                                 "ap-north", "sa-east", "af-south")),
+    OPTION_INT('t', "timeout", HELP("Timeout in milliseconds"), DEFAULT(500)),
+    OPTION_ARRAY_INT('i', "ids", HELP("Target ids")),
+    SUBCOMMAND("route", route_options, HELP("Manage routes"))
+)
+
+static char *command_line[] = {"daemon", "-v", "--zone=us-east", "-t", "250", "-i", "1-12",
+                               "-i", "40", "route", "-g", "10.0.0.1", "-w", "3", "-p",
+                               "80", "-p", "443", "--force"};
+#define COMMAND_LINE_ARGC ((int)(sizeof(command_line) / sizeof(command_line[0])))
+
+static void check_parse(cargs_t *cargs, int status)
+{
+    if (status != CARGS_SUCCESS || cargs_count(*cargs, "ids") != 13 ||
+        cargs_get(*cargs, "route.weight").as_int != 3) {
+        fprintf(stderr, "Unexpected parse result (%d)\n", status);
+        exit(EXIT_FAILURE);
+    }
+}
+
+// One context per command line: init + parse + free
+double measure_fresh_parses(int iterations)
+{
+    clock_t start = clock();
+
+    for (int i = 0; i < iterations; ++i) {
+        cargs_t cargs = cargs_init(daemon_options, "daemon", "1.0.0");
+        check_parse(&cargs, cargs_parse(&cargs, COMMAND_LINE_ARGC, command_line));
+        cargs_free(&cargs);
+    }
+    return ((double)(clock() - start)) / CLOCKS_PER_SEC;
+}
+
+// One context for every command line: parse + reset
+double measure_reset_parses(cargs_t *cargs, int iterations)
+{
+    clock_t start = clock();
+
+    for (int i = 0; i < iterations; ++i) {
+        check_parse(cargs, cargs_parse(cargs, COMMAND_LINE_ARGC, command_line));
+        cargs_reset(cargs);
+    }
+    return ((double)(clock() - start)) / CLOCKS_PER_SEC;
+}
+
+// Bytes allocated on the heap, when the C library can tell
+static long heap_in_use(void)
+{
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+    return (long)mallinfo2().uordblks;
+#else
+    return -1;
+#endif
+}
+
+int main(int argc, char **argv)
+{
+    int iterations = argc > 1 ? atoi(argv[1]) : 200000;
+    if (iterations <= 0)
+        iterations = 200000;
+
+    printf("=== CARGS REPEATED PARSING BENCHMARK ===\n\n");
+
+    measure_fresh_parses(iterations / 10);  // Warm-up
+    double fresh = measure_fresh_parses(iterations);
+
+    cargs_t cargs = cargs_init(daemon_options, "daemon", "1.0.0");
+    measure_reset_parses(&cargs, iterations / 10);  // Warm-up: buffers reach their size
+    long   heap_before = heap_in_use();
+    double reset       = measure_reset_parses(&cargs, iterations);
+    long   heap_after  = heap_in_use();
+    cargs_free(&cargs);
+
+    printf("%-22s | %-12s | %-16s | %-14s\n", "Strategy", "Iterations", "Time/parse (s)",
+           "Parses/s");
+    printf("--------------------------------------------------------------------------\n");
+    printf("%-22s | %-12d | %-16.9f | %-14.0f\n", "init + parse + free", iterations,
+           fresh / iterations, fresh > 0 ? iterations / fresh : 0.0);
+    printf("%-22s | %-12d | %-16.9f | %-14.0f\n", "parse + reset", iterations,
+           reset / iterations, reset > 0 ? iterations / reset : 0.0);
+    printf("\nSpeedup: %.2fx\n", reset > 0 ? fresh / reset : 0.0);
+
+    if (heap_before >= 0)
+        printf("Heap growth over the steady-state parses: %ld bytes\n", heap_after - heap_before);
+    return 0;
+}
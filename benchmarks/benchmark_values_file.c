@@ -0,0 +1,93 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "cargs.h"
+
+CARGS_OPTIONS(
+    file_options,
+    HELP_OPTION(FLAGS(FLAG_EXIT)),
+    OPTION_ARRAY_INT('i', "ids", HELP("Ids"), FLAGS(FLAG_VALUES_FILE)),
+    OPTION_ARRAY_STRING('I', "include", HELP("Include paths"), FLAGS(FLAG_VALUES_FILE))
+)
+
+// Write lines until the file reaches size bytes, returns the number of lines
+static size_t write_file(const char *path, size_t size, int paths)
+{
+    FILE  *file    = fopen(path, "w");
+    size_t written = 0;
+    size_t lines   = 0;
+
+    if (file == NULL) {
+        perror(path);
+        exit(EXIT_FAILURE);
+    }
+    while (written < size) {
+        int length = paths ? fprintf(file, "/usr/src/project/module%zu/include\n", lines % 4096)
+                           : fprintf(file, "%zu\n", lines * 7);
+        written += (size_t)length;
+        lines++;
+    }
+    fclose(file);
+    return (lines);
+}
+
+// One parse of "--<name>=@path", returns the number of elements read
+static size_t parse_file(const char *name, const char *path, double *seconds)
+{
+    char argument[256];
+    snprintf(argument, sizeof(argument), "--%s=@%s", name, path);
+    char *argv[] = {"bench", argument};
+
+    cargs_t cargs = cargs_init(file_options, "bench", "1.0.0");
+    clock_t start = clock();
+    if (cargs_parse(&cargs, 2, argv) != CARGS_SUCCESS) {
+        fprintf(stderr, "Unexpected parse failure\n");
+        exit(EXIT_FAILURE);
+    }
+    *seconds     = ((double)(clock() - start)) / CLOCKS_PER_SEC;
+    size_t count = cargs_count(cargs, name);
+    cargs_free(&cargs);
+    return (count);
+}
+
+static void run(const char *label, const char *name, int paths, size_t size)
+{
+    char path[] = "/tmp/cargs_bench_XXXXXX";
+    int  fd     = mkstemp(path);
+    if (fd < 0) {
+        perror("mkstemp");
+        exit(EXIT_FAILURE);
+    }
+    close(fd);
+
+    size_t lines = write_file(path, size, paths);
+    double seconds;
+    size_t count = parse_file(name, path, &seconds);
+    unlink(path);
+    if (count != lines) {
+        fprintf(stderr, "Read %zu elements instead of %zu\n", count, lines);
+        exit(EXIT_FAILURE);
+    }
+
+    double megabytes = (double)size / (1024 * 1024);
+    printf("%-14s | %-10.0f | %-12zu | %-10.3f | %-10.1f\n", label, megabytes, lines, seconds,
+           seconds > 0 ? megabytes / seconds : 0.0);
+}
+
+int main(int argc, char **argv)
+{
+    long megabytes = argc > 1 ? atol(argv[1]) : 1024;
+    if (megabytes <= 0)
+        megabytes = 1024;
+    size_t size = (size_t)megabytes * 1024 * 1024;
+
+    printf("=== CARGS VALUES FILE BENCHMARK ===\n\n");
+    printf("%-14s | %-10s | %-12s | %-10s | %-10s\n", "Elements", "Size (MB)", "Lines",
+           "Time (s)", "MB/s");
+    printf("----------------------------------------------------------------\n");
+    run("integers", "ids", 0, size);
+    run("paths", "include", 1, size);
+    return 0;
+}
@@ -0,0 +1,6 @@
+#include "cargs.h"
+
+// Options array of the example linked with this tool
+extern cargs_option_t options[];
+
+CARGS_SCHEMA_CHECK(options)
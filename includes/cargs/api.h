@@ -14,6 +14,9 @@
 
 cargs_t cargs_init_mode(cargs_option_t *options, const char *program_name, const char *version,
                         bool release_mode);
+cargs_t cargs_init_schema_mode(cargs_option_t *options, const char *program_name,
+                               const char *version, const void *schema, size_t schema_size,
+                               bool release_mode);
 
 #ifdef CARGS_RELEASE
 /**
@@ -33,12 +36,27 @@ cargs_t cargs_init_mode(cargs_option_t *options, const char *program_name, const
  * Example: `gcc -DCARGS_RELEASE my_program.c -o my_program -lcargs`
  *
  * Note: Only use this in production. During development, leave validation
- * enabled to catch configuration errors early.
+ * enabled to catch configuration errors early, or check the options at build
+ * time with CARGS_SCHEMA_CHECK.
  */
-cargs_t cargs_init(cargs_option_t *options, const char *program_name, const char *version)
+static inline cargs_t cargs_init(cargs_option_t *options, const char *program_name,
+                                 const char *version)
 {
     return cargs_init_mode(options, program_name, version, true);
 }
+
+/**
+ * cargs_init_schema - Initialize the cargs context with precompiled indexes
+ *
+ * Same as cargs_init, using the lookup tables of a schema blob written by
+ * cargs_schema_save instead of building them. Structure validation is skipped.
+ */
+static inline cargs_t cargs_init_schema(cargs_option_t *options, const char *program_name,
+                                        const char *version, const void *schema,
+                                        size_t schema_size)
+{
+    return cargs_init_schema_mode(options, program_name, version, schema, schema_size, true);
+}
 #else
 /**
  * cargs_init - Initialize the cargs context
@@ -59,10 +77,34 @@ cargs_t cargs_init(cargs_option_t *options, const char *program_name, const char
  * Note: Only use this in production. During development, leave validation
  * enabled to catch configuration errors early.
  */
-cargs_t cargs_init(cargs_option_t *options, const char *program_name, const char *version)
+static inline cargs_t cargs_init(cargs_option_t *options, const char *program_name,
+                                 const char *version)
 {
     return cargs_init_mode(options, program_name, version, false);
 }
+
+/**
+ * cargs_init_schema - Initialize the cargs context with precompiled indexes
+ *
+ * @param options      Array of command-line options
+ * @param program_name Name of the program
+ * @param version      Version string
+ * @param schema       Schema blob written by cargs_schema_save, 8-byte aligned
+ * @param schema_size  Size of the schema blob
+ *
+ * @return Initialized cargs_t context
+ *
+ * The lookup tables of each level are used in place from the blob instead
+ * of being built. A level whose options changed since the blob was written
+ * is built at runtime as with cargs_init. The blob must stay valid until
+ * cargs_free and must come from a trusted source.
+ */
+static inline cargs_t cargs_init_schema(cargs_option_t *options, const char *program_name,
+                                        const char *version, const void *schema,
+                                        size_t schema_size)
+{
+    return cargs_init_schema_mode(options, program_name, version, schema, schema_size, false);
+}
 #endif
 
 /**
@@ -73,9 +115,99 @@ cargs_t cargs_init(cargs_option_t *options, const char *program_name, const char
  * @param argv   Argument values (from main)
  *
  * @return Status code (0 for success, non-zero for error)
+ *
+ * With cargs->response_files set, "@file" arguments are replaced by the
+ * arguments written in file. Leave it off in programs running with more
+ * privileges than their caller: the file is read on the caller's behalf.
  */
 int cargs_parse(cargs_t *cargs, int argc, char **argv);
 
+/**
+ * cargs_parse_string - Parse arguments given as a single command string
+ *
+ * @param cargs   Cargs context
+ * @param line    Arguments without the program name, e.g. "scale -r 3 --tags 'a b'"
+ * @param length  Length of line, which does not need a terminator
+ *
+ * @return Status code, as cargs_parse
+ *
+ * Arguments are separated by whitespace, quotes and backslashes work as in a
+ * POSIX shell. The command is copied into a buffer kept by the context and
+ * split in place: string values point into it until the next parse, so call
+ * cargs_reset between commands. The buffer only grows for a longer command.
+ * Response files are not expanded.
+ */
+int cargs_parse_string(cargs_t *cargs, const char *line, size_t length);
+
+/**
+ * cargs_parse_buffer - Parse a command string in place, without copying it
+ *
+ * @param cargs   Cargs context
+ * @param buffer  Command, split in place: quotes are removed and tokens are
+ *                terminated by overwriting the separators
+ * @param length  Length of the command, buffer must hold length + 1 bytes
+ *
+ * @return Status code, as cargs_parse
+ *
+ * Same as cargs_parse_string, but string values point into buffer, which
+ * must stay valid until cargs_reset or cargs_free.
+ */
+int cargs_parse_buffer(cargs_t *cargs, char *buffer, size_t length);
+
+/**
+ * cargs_parser_begin - Start parsing arguments pushed one at a time
+ *
+ * @param cargs   Cargs context
+ * @param parser  Parser state, usually kept next to the connection it reads
+ *
+ * The push API parses like cargs_parse, but the caller gives each argument
+ * when it arrives with cargs_parser_feed, then calls cargs_parser_end. The
+ * parser state lives in parser, so parsing can be interleaved with other
+ * work without threads or buffering the whole command. Response files are
+ * not expanded, and nothing exits the program: FLAG_EXIT options return
+ * CARGS_SOULD_EXIT, and a subcommand whose options are invalid returns its
+ * structure error when first entered.
+ */
+void cargs_parser_begin(cargs_t *cargs, cargs_parser_t *parser);
+
+/**
+ * cargs_parser_feed - Parse the next argument
+ *
+ * @param parser  Parser started by cargs_parser_begin
+ * @param token   Argument, string values point to it until cargs_reset
+ *
+ * @return Status code. After a failure, later tokens are ignored and the
+ *         same status is returned.
+ *
+ * An option that needs a value waits for the next token.
+ */
+int cargs_parser_feed(cargs_parser_t *parser, char *token);
+
+/**
+ * cargs_parser_end - Finish a pushed parse
+ *
+ * @param parser  Parser started by cargs_parser_begin
+ *
+ * @return Status code, as cargs_parse: an option still waiting for its
+ *         value fails, then environment variables, validation and binding
+ *         are applied.
+ */
+int cargs_parser_end(cargs_parser_t *parser);
+
+/**
+ * cargs_bind - Set the struct receiving the values of bound options
+ *
+ * @param cargs   Cargs context
+ * @param target  Struct whose type was given to the BIND of the options, or
+ *                NULL to stop binding
+ *
+ * After each successful cargs_parse, every set option declared with
+ * BIND(type, field) has its value written to that field of target. Fields
+ * of options that are not set keep their previous content. Bound strings
+ * point into argv or into the defaults, like cargs_get.
+ */
+void cargs_bind(cargs_t *cargs, void *target);
+
 /**
  * cargs_free - Clean up and free resources
  *
@@ -83,6 +215,108 @@ int cargs_parse(cargs_t *cargs, int argc, char **argv);
  */
 void cargs_free(cargs_t *cargs);
 
+/**
+ * cargs_reset - Clear the results of a parse to parse again with the same context
+ *
+ * @param cargs  Cargs context
+ *
+ * Options go back to their default values and the error and subcommand
+ * stacks are emptied. Lookup indexes are kept and arrays and maps keep their
+ * allocated capacity, so parsing again does not repeat the work of
+ * cargs_init. Values obtained before the reset must not be used afterwards.
+ */
+void cargs_reset(cargs_t *cargs);
+
+/**
+ * cargs_validate_schema - Validate an options structure and all its subcommands
+ *
+ * @param options       Array of command-line options
+ * @param program_name  Name used when printing errors
+ *
+ * @return Status code (0 for success, non-zero for error)
+ *
+ * Runs the structure validation done by cargs_init in development mode, on
+ * every subcommand level at once, and prints the errors found. Meant to be
+ * run at build time so that release binaries can skip it safely.
+ */
+int cargs_validate_schema(cargs_option_t *options, const char *program_name);
+
+/**
+ * CARGS_SCHEMA_CHECK - Define the main function of a schema checking tool
+ *
+ * @param options  Options array to validate, usually declared extern
+ *
+ * The tool exits with a non-zero status if the schema is invalid. When
+ * given a path, it writes the schema blob of the options there on success,
+ * so it can be used as the output of a build step.
+ */
+#define CARGS_SCHEMA_CHECK(options)                                                              \
+    int main(int argc, char **argv)                                                              \
+    {                                                                                            \
+        if (cargs_validate_schema(options, argc > 0 ? argv[0] : #options) != CARGS_SUCCESS)      \
+            return (1);                                                                          \
+        if (argc > 1 && cargs_schema_save(options, argv[1]) != CARGS_SUCCESS)                    \
+            return (1);                                                                          \
+        return (0);                                                                              \
+    }
+
+/**
+ * cargs_schema_save - Write the precompiled indexes of an options tree
+ *
+ * @param options  Root options array, validated beforehand
+ * @param path     File to write the schema blob to
+ *
+ * @return Status code (0 for success, non-zero for error)
+ *
+ * The blob holds the lookup tables of every level (names, choices,
+ * dependency bitsets) with a fingerprint of each options array. It is only
+ * valid for the same library version and byte order.
+ */
+int cargs_schema_save(cargs_option_t *options, const char *path);
+
+/**
+ * cargs_schema_map - Map a schema blob file in memory, read-only
+ *
+ * @param path  File written by cargs_schema_save
+ * @param size  Set to the size of the mapping
+ *
+ * @return The blob, or NULL if the file cannot be mapped
+ */
+const void *cargs_schema_map(const char *path, size_t *size);
+
+/**
+ * cargs_schema_unmap - Release a blob mapped by cargs_schema_map
+ *
+ * @param schema  Mapped blob, may be NULL
+ * @param size    Size returned by cargs_schema_map
+ */
+void cargs_schema_unmap(const void *schema, size_t size);
+
+/**
+ * cargs_options_clone - Copy an options tree for another parsing context
+ *
+ * @param options  Root options array, left untouched
+ *
+ * @return The copy with every value reset to its default, or NULL if it
+ *         could not be allocated. Release it with cargs_options_destroy.
+ *
+ * Parsed values are stored in the options arrays, so two contexts parsing at
+ * the same time need their own copy. Strings, choices and callbacks are
+ * shared with the original, and a copy matches the schema blob of the
+ * original: threads can share one mapped blob. Only the root array is
+ * copied here, the options of a subcommand are copied when the copy first
+ * enters or resolves into it. The original must outlive its copies.
+ */
+cargs_option_t *cargs_options_clone(const cargs_option_t *options);
+
+/**
+ * cargs_options_destroy - Release a copy made by cargs_options_clone
+ *
+ * @param options  Copied options, may be NULL. cargs_free must have been
+ *                 called on the contexts that used it.
+ */
+void cargs_options_destroy(cargs_option_t *options);
+
 /**
  * Display functions
  */
@@ -213,4 +447,355 @@ bool cargs_map_next(cargs_map_it_t *it);
  */
 void cargs_map_reset(cargs_map_it_t *it);
 
+/**
+ * cargs_set_it - Create an iterator over the options set by the parse
+ *
+ * @param cargs  Cargs context
+ *
+ * @return Iterator visiting the root options first, then those of each
+ *         active subcommand, in the order they were set. Options holding a
+ *         default value come first, as they are set from the start.
+ */
+cargs_set_it_t cargs_set_it(cargs_t cargs);
+
+/**
+ * cargs_set_next - Get the next set option from a set options iterator
+ *
+ * @param it  Set options iterator
+ *
+ * @return true if an option was retrieved, false if no set option is left
+ */
+bool cargs_set_next(cargs_set_it_t *it);
+
+/**
+ * cargs_set_reset - Reset a set options iterator to the beginning
+ *
+ * @param it  Set options iterator to reset
+ */
+void cargs_set_reset(cargs_set_it_t *it);
+
+/**
+ * Pointer-based accessors
+ *
+ * Same behavior as the functions above, but the context is passed by
+ * address: the by-value versions copy the whole cargs_t, error stack
+ * included, on every call.
+ */
+bool             cargs_is_set_ref(const cargs_t *cargs, const char *option_path);
+cargs_value_t    cargs_get_ref(const cargs_t *cargs, const char *option_path);
+size_t           cargs_count_ref(const cargs_t *cargs, const char *option_path);
+bool             cargs_has_command_ref(const cargs_t *cargs);
+cargs_value_t    cargs_array_get_ref(const cargs_t *cargs, const char *option_path, size_t index);
+cargs_value_t    cargs_map_get_ref(const cargs_t *cargs, const char *option_path, const char *key);
+cargs_array_it_t cargs_array_it_ref(const cargs_t *cargs, const char *option_path);
+cargs_map_it_t   cargs_map_it_ref(const cargs_t *cargs, const char *option_path);
+cargs_set_it_t   cargs_set_it_ref(const cargs_t *cargs);
+void             cargs_print_help_ref(const cargs_t *cargs);
+void             cargs_print_usage_ref(const cargs_t *cargs);
+void             cargs_print_version_ref(const cargs_t *cargs);
+
+/**
+ * cargs_resolve - Resolve an option path once, for repeated reads
+ *
+ * @param cargs        Cargs context
+ * @param option_path  Option path (name or subcommand.name format)
+ *
+ * @return Handle to the option, invalid if the path matches nothing
+ *
+ * The path is resolved as cargs_get would resolve it now. A path into a
+ * subcommand that is not active is resolved through the options tree, so
+ * handles can be resolved before parsing. A handle stays valid as long as
+ * the options array, across cargs_reset.
+ */
+cargs_handle_t cargs_resolve(const cargs_t *cargs, const char *option_path);
+
+/**
+ * cargs_map_get_h - Get a value from the map option of a handle
+ *
+ * @param handle  Resolved option
+ * @param key     Key to look up in the map
+ *
+ * @return Value associated with the key, or {0} if not found
+ */
+cargs_value_t cargs_map_get_h(cargs_handle_t handle, const char *key);
+
+/**
+ * Handle accessors
+ *
+ * Same results as the path-based functions, read directly from the
+ * resolved option. An invalid handle reads as an option that is not set.
+ */
+static inline bool cargs_handle_valid(cargs_handle_t handle)
+{
+    return (handle._option != NULL);
+}
+
+static inline cargs_value_t cargs_get_h(cargs_handle_t handle)
+{
+    return (handle._option ? handle._option->value : (cargs_value_t){.raw = 0});
+}
+
+static inline bool cargs_is_set_h(cargs_handle_t handle)
+{
+    return (handle._option ? handle._option->is_set : false);
+}
+
+static inline size_t cargs_count_h(cargs_handle_t handle)
+{
+    return (handle._option ? handle._option->value_count : 0);
+}
+
+/* Element of an array stored with FLAG_PACKED, used by the accessors below */
+cargs_value_t cargs_packed_get(const cargs_option_t *option, size_t index);
+
+static inline cargs_value_t cargs_array_get_h(cargs_handle_t handle, size_t index)
+{
+    const cargs_option_t *option = handle._option;
+
+    if (option == NULL || !(option->value_type & VALUE_TYPE_ARRAY) || index >= option->value_count)
+        return ((cargs_value_t){.raw = 0});
+    if (option->is_packed)
+        return (cargs_packed_get(option, index));
+    return (option->value.as_array[index]);
+}
+
+static inline cargs_array_it_t cargs_array_it_h(cargs_handle_t handle)
+{
+    cargs_array_it_t      it     = {0};
+    const cargs_option_t *option = handle._option;
+
+    if (option != NULL && (option->value_type & VALUE_TYPE_ARRAY)) {
+        if (option->is_packed)
+            it._packed = (const struct cargs_packed_s *)option->value.as_ptr;
+        else
+            it._array = option->value.as_array;
+        it._count = option->value_count;
+    }
+    return (it);
+}
+
+static inline cargs_map_it_t cargs_map_it_h(cargs_handle_t handle)
+{
+    cargs_map_it_t        it     = {0};
+    const cargs_option_t *option = handle._option;
+
+    if (option != NULL && (option->value_type & VALUE_TYPE_MAP)) {
+        it._map   = option->value.as_map;
+        it._count = option->value_count;
+    }
+    return (it);
+}
+
+/**
+ * cargs_map_prefix_it - Iterate over the map entries whose key has a prefix
+ *
+ * @param cargs        Cargs context
+ * @param option_path  Path of a map option
+ * @param prefix       Key prefix, "" for every entry
+ *
+ * @return Iterator for cargs_map_next, empty if the option is not a map
+ *
+ * With FLAG_SORTED_KEY the map is kept sorted and the matching keys are
+ * found by bisection: the iterator never visits other keys. Without it,
+ * cargs_map_next skips the keys that do not match.
+ */
+cargs_map_it_t cargs_map_prefix_it(const cargs_t *cargs, const char *option_path,
+                                   const char *prefix);
+cargs_map_it_t cargs_map_prefix_it_h(cargs_handle_t handle, const char *prefix);
+
+/**
+ * Array spans
+ *
+ * @param cargs        Cargs context
+ * @param option_path  Path of an array option
+ *
+ * @return View over the values of the array, without copy: {NULL, 0} if the
+ *         option is not set, is not found or is not an array of this type.
+ *         The view is valid until the option is parsed again, reset or freed.
+ *         String spans are only available where pointers are as large as
+ *         long long, and are empty elsewhere. Arrays stored with FLAG_PACKED
+ *         have no plain storage to view: use cargs_array_copy_i64.
+ */
+cargs_span_i64_t cargs_array_span_i64(const cargs_t *cargs, const char *option_path);
+cargs_span_f64_t cargs_array_span_f64(const cargs_t *cargs, const char *option_path);
+cargs_span_str_t cargs_array_span_str(const cargs_t *cargs, const char *option_path);
+
+static inline cargs_span_i64_t cargs_array_span_i64_h(cargs_handle_t handle)
+{
+    const cargs_option_t *option = handle._option;
+
+    if (option == NULL || option->value_type != VALUE_TYPE_ARRAY_INT || option->value_count == 0 ||
+        option->is_packed)
+        return ((cargs_span_i64_t){NULL, 0});
+    return ((cargs_span_i64_t){&option->value.as_array->as_int64, option->value_count});
+}
+
+static inline cargs_span_f64_t cargs_array_span_f64_h(cargs_handle_t handle)
+{
+    const cargs_option_t *option = handle._option;
+
+    if (option == NULL || option->value_type != VALUE_TYPE_ARRAY_FLOAT || option->value_count == 0)
+        return ((cargs_span_f64_t){NULL, 0});
+    return ((cargs_span_f64_t){&option->value.as_array->as_float, option->value_count});
+}
+
+static inline cargs_span_str_t cargs_array_span_str_h(cargs_handle_t handle)
+{
+    const cargs_option_t *option = handle._option;
+
+    if (sizeof(char *) != sizeof(cargs_value_t) || option == NULL ||
+        option->value_type != VALUE_TYPE_ARRAY_STRING || option->value_count == 0)
+        return ((cargs_span_str_t){NULL, 0});
+    return ((cargs_span_str_t){(const char *const *)&option->value.as_array->as_string,
+                               option->value_count});
+}
+
+/**
+ * cargs_array_copy_i64 - Copy a range of an integer array option
+ *
+ * @param cargs        Cargs context
+ * @param option_path  Path of an integer array option
+ * @param start        Position of the first value to copy
+ * @param out          Destination, room for length values
+ * @param length       Number of values wanted
+ *
+ * @return Number of values copied: 0 if the option is not an integer array
+ *         or start is past its end, fewer than length at the end of the array
+ *
+ * Works whether the array is plain or stored with FLAG_PACKED, which is
+ * decoded one block at a time.
+ */
+size_t cargs_array_copy_i64(const cargs_t *cargs, const char *option_path, size_t start,
+                            long long *out, size_t length);
+size_t cargs_array_copy_i64_h(cargs_handle_t handle, size_t start, long long *out, size_t length);
+
+/**
+ * Typed resolution
+ *
+ * @param cargs        Cargs context
+ * @param option_path  Option path, resolved as by cargs_resolve
+ *
+ * @return Handle reading the value of the option as a native type. The
+ *         option must be an INT option for _i64, a FLOAT option for _f64, a
+ *         STRING option for _str, a FLAG or BOOL option for _bool. Any other
+ *         option, or a path matching nothing, gives an invalid handle that
+ *         reads as 0, 0.0, NULL or false.
+ */
+cargs_i64_t  cargs_resolve_i64(const cargs_t *cargs, const char *option_path);
+cargs_f64_t  cargs_resolve_f64(const cargs_t *cargs, const char *option_path);
+cargs_str_t  cargs_resolve_str(const cargs_t *cargs, const char *option_path);
+cargs_bool_t cargs_resolve_bool(const cargs_t *cargs, const char *option_path);
+
+/* Zero value read through invalid typed handles */
+extern const cargs_value_t cargs_nil_value;
+
+/**
+ * Typed accessors
+ *
+ * The type was checked when resolving: each read is a single load, with no
+ * type switch and no truncation to int.
+ */
+static inline long long cargs_get_i64(cargs_i64_t handle)
+{
+    return (*handle._value);
+}
+
+static inline double cargs_get_f64(cargs_f64_t handle)
+{
+    return (*handle._value);
+}
+
+static inline const char *cargs_get_str(cargs_str_t handle)
+{
+    return (*handle._value);
+}
+
+static inline bool cargs_get_bool(cargs_bool_t handle)
+{
+    return (*handle._value);
+}
+
+/*
+ * cargs_value - Read a typed handle as its native type
+ * cargs_typed_valid - Check that a typed handle was resolved
+ */
+#define cargs_value(handle)                                                                        \
+    _Generic((handle),                                                                             \
+        cargs_i64_t: cargs_get_i64,                                                                \
+        cargs_f64_t: cargs_get_f64,                                                                \
+        cargs_str_t: cargs_get_str,                                                                \
+        cargs_bool_t: cargs_get_bool)(handle)
+
+#define cargs_typed_valid(handle)                                                                  \
+    ((const void *)(handle)._value != (const void *)&cargs_nil_value)
+
+/**
+ * Option ID accessors
+ *
+ * Read an option of the root options array from its position, given by the
+ * enum generated by CARGS_OPTIONS_X. No name is compared: a misspelled ID
+ * does not compile. The ID must come from the enum of the array given to
+ * cargs_init, or of the array it was cloned from. CARGS_CHECK_ID catches an
+ * ID of another enum at compile time when it is out of range, and an ID past
+ * the end of the options array gives an invalid handle, read as an option
+ * that is not set.
+ */
+static inline cargs_handle_t cargs_handle_id(const cargs_t *cargs, size_t id)
+{
+    if (id >= cargs->option_count)
+        return ((cargs_handle_t){._option = NULL});
+    return ((cargs_handle_t){._option = &cargs->options[id]});
+}
+
+/**
+ * cargs_sub_handle_id - Handle to an option of a subcommand from its ID
+ *
+ * @param subcommand  Handle to a subcommand option
+ * @param id          ID from the enum generated for its sub_options
+ *
+ * @return Handle to the option, invalid if subcommand is not a subcommand or
+ *         id is past the end of its sub_options
+ */
+cargs_handle_t cargs_sub_handle_id(cargs_handle_t subcommand, size_t id);
+
+static inline cargs_value_t cargs_get_id(const cargs_t *cargs, size_t id)
+{
+    return (cargs_get_h(cargs_handle_id(cargs, id)));
+}
+
+static inline bool cargs_is_set_id(const cargs_t *cargs, size_t id)
+{
+    return (cargs_is_set_h(cargs_handle_id(cargs, id)));
+}
+
+static inline size_t cargs_count_id(const cargs_t *cargs, size_t id)
+{
+    return (cargs_count_h(cargs_handle_id(cargs, id)));
+}
+
+static inline long long cargs_get_int_id(const cargs_t *cargs, size_t id)
+{
+    return (cargs_get_h(cargs_handle_id(cargs, id)).as_int64);
+}
+
+static inline double cargs_get_float_id(const cargs_t *cargs, size_t id)
+{
+    return (cargs_get_h(cargs_handle_id(cargs, id)).as_float);
+}
+
+static inline bool cargs_get_bool_id(const cargs_t *cargs, size_t id)
+{
+    return (cargs_get_h(cargs_handle_id(cargs, id)).as_bool);
+}
+
+static inline const char *cargs_get_string_id(const cargs_t *cargs, size_t id)
+{
+    return (cargs_get_h(cargs_handle_id(cargs, id)).as_string);
+}
+
+static inline cargs_value_t cargs_array_get_id(const cargs_t *cargs, size_t id, size_t index)
+{
+    return (cargs_array_get_h(cargs_handle_id(cargs, id), index));
+}
+
 #endif /* CARGS_API_H */
@@ -49,4 +49,45 @@
     #define PRAGMA_RESTORE()
 #endif
 
+/**
+ * CARGS_CTZ64 - Index of the lowest set bit of a non-zero 64-bit word
+ */
+#if defined(__clang__) || defined(__GNUC__)
+    #define CARGS_CTZ64(x) ((size_t)__builtin_ctzll(x))
+#else
+    #include <stddef.h>
+    #include <stdint.h>
+
+static inline size_t cargs_ctz64(uint64_t x)
+{
+    size_t n = 0;
+
+    while ((x & 1) == 0) {
+        x >>= 1;
+        n++;
+    }
+    return (n);
+}
+    #define CARGS_CTZ64(x) cargs_ctz64(x)
+#endif
+
+/**
+ * CARGS_BIT_WIDTH64 - Number of bits needed to write a 64-bit word, 0 for 0
+ */
+#if defined(__clang__) || defined(__GNUC__)
+    #define CARGS_BIT_WIDTH64(x) ((x) == 0 ? (size_t)0 : (size_t)(64 - __builtin_clzll(x)))
+#else
+static inline size_t cargs_bit_width64(uint64_t x)
+{
+    size_t n = 0;
+
+    while (x != 0) {
+        x >>= 1;
+        n++;
+    }
+    return (n);
+}
+    #define CARGS_BIT_WIDTH64(x) cargs_bit_width64(x)
+#endif
+
 #endif /* CARGS_INTERNAL_COMPILER_H */
@@ -24,7 +24,7 @@ void context_init(cargs_t *cargs);
  * Subcommand stack management
  */
 void                  context_init_subcommands(cargs_t *cargs);
-const cargs_option_t *context_get_subcommand(cargs_t *cargs);
+const cargs_option_t *context_get_subcommand(const cargs_t *cargs);
 void                  context_push_subcommand(cargs_t *cargs, const cargs_option_t *cmd);
 const cargs_option_t *context_pop_subcommand(cargs_t *cargs);
 
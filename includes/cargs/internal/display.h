@@ -25,7 +25,7 @@
  * @param cargs  	Cargs context
  * @param command   Specific subcommand to display help for, or NULL for general help
  */
-void display_help(cargs_t *cargs, const cargs_option_t *command);
+void display_help(const cargs_t *cargs, const cargs_option_t *command);
 
 /**
  * display_usage - Display short usage information
@@ -33,13 +33,13 @@ void display_help(cargs_t *cargs, const cargs_option_t *command);
  * @param cargs  	Cargs context
  * @param command   Specific subcommand to display usage for, or NULL for general usage
  */
-void display_usage(cargs_t *cargs, const cargs_option_t *command);
+void display_usage(const cargs_t *cargs, const cargs_option_t *command);
 
 /**
  * display_version - Display version information
  *
  * @param cargs  Cargs context
  */
-void display_version(cargs_t *cargs);
+void display_version(const cargs_t *cargs);
 
 #endif /* CARGS_INTERNAL_DISPLAY_H */
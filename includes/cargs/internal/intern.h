@@ -0,0 +1,111 @@
+/**
+ * cargs/internal/intern.h - Per-context string interning and chunked string storage
+ *
+ * INTERNAL HEADER - NOT PART OF THE PUBLIC API
+ * Map keys are interned: each distinct key is stored once per context, and
+ * two keys are equal if and only if they are the same pointer. Interned
+ * strings belong to the context and last until the next cargs_reset, which
+ * empties or frees every map, or cargs_free. Maps filled by the built-in map
+ * handlers never own their keys.
+ *
+ * String elements of array and map options are packed into chunks owned by
+ * their option instead of being allocated one by one. Chunks never move, so
+ * the element pointers stay valid until the option is reset or freed.
+ *
+ * MIT License - Copyright (c) 2024 lucocozz
+ */
+
+#ifndef CARGS_INTERNAL_INTERN_H
+#define CARGS_INTERNAL_INTERN_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "cargs/types.h"
+
+/* Size of the blocks strings are copied into, longer strings get their own */
+#ifndef CARGS_INTERN_CHUNK_SIZE
+    #define CARGS_INTERN_CHUNK_SIZE 4096
+#endif
+
+typedef struct cargs_intern_chunk_s
+{
+    struct cargs_intern_chunk_s *next;
+    size_t                       used;
+    size_t                       size;
+    char                         data[];
+} cargs_intern_chunk_t;
+
+typedef struct cargs_intern_s
+{
+    const char          **slots;    /* Open addressing table, NULL for empty slots */
+    uint64_t             *hashes;   /* Hash of the string in each slot */
+    size_t                capacity; /* Number of slots, a power of two */
+    size_t                count;    /* Number of interned strings */
+    cargs_intern_chunk_t *chunks;   /* Storage, the current chunk first */
+} cargs_intern_t;
+
+/**
+ * chunks_store - Copy a string into a chunk list, starting a chunk if needed
+ *
+ * @param chunks  Chunk list, the current chunk first
+ * @param str     String to copy, need not be NUL-terminated
+ * @param length  Number of bytes of str
+ *
+ * @return The NUL-terminated copy, or NULL if memory could not be allocated
+ */
+char *chunks_store(cargs_intern_chunk_t **chunks, const char *str, size_t length);
+
+/**
+ * chunks_clear - Drop every string of a chunk list but keep its current chunk
+ *
+ * @param chunks  Chunk list
+ */
+void chunks_clear(cargs_intern_chunk_t **chunks);
+
+/**
+ * chunks_free - Release a chunk list
+ *
+ * @param chunks  Chunk list, set to NULL
+ */
+void chunks_free(cargs_intern_chunk_t **chunks);
+
+/**
+ * intern_string - Get the interned copy of a string, adding it if needed
+ *
+ * @param cargs   Cargs context owning the pool
+ * @param str     String to intern, need not be NUL-terminated
+ * @param length  Number of bytes of str
+ *
+ * @return The interned string, or NULL if memory could not be allocated
+ */
+const char *intern_string(cargs_t *cargs, const char *str, size_t length);
+
+/**
+ * intern_find - Get the interned copy of a string without adding it
+ *
+ * @param cargs  Cargs context owning the pool
+ * @param str    NUL-terminated string
+ *
+ * @return The interned string, or NULL if it was never interned
+ */
+const char *intern_find(const cargs_t *cargs, const char *str);
+
+/**
+ * intern_clear - Forget every interned string, for cargs_reset
+ *
+ * The table is emptied in place and the current chunk is rewound, so a
+ * context parsing distinct keys over and over neither grows nor allocates.
+ *
+ * @param cargs  Cargs context
+ */
+void intern_clear(cargs_t *cargs);
+
+/**
+ * intern_free - Release every string interned for a context
+ *
+ * @param cargs  Cargs context
+ */
+void intern_free(cargs_t *cargs);
+
+#endif /* CARGS_INTERNAL_INTERN_H */
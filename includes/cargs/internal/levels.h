@@ -0,0 +1,216 @@
+/**
+ * cargs/internal/levels.h - Per-level lookup indexes
+ *
+ * INTERNAL HEADER - NOT PART OF THE PUBLIC API
+ * A level is one options array: the root array given to cargs_init or the
+ * sub_options of a subcommand. Lookup structures derived from a level are
+ * built once, kept in the context and released by cargs_free.
+ *
+ * MIT License - Copyright (c) 2024 lucocozz
+ */
+
+#ifndef CARGS_INTERNAL_LEVELS_H
+#define CARGS_INTERNAL_LEVELS_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "cargs/types.h"
+
+/* Options with fewer choices are checked with a linear scan */
+#ifndef CARGS_CHOICES_INDEX_MIN
+    #define CARGS_CHOICES_INDEX_MIN 8
+#endif
+
+/* Marks an option without a lookup index */
+#define CARGS_NO_INDEX UINT32_MAX
+
+typedef struct cargs_level_s
+{
+    cargs_option_t *options;     /* Options array described by this level */
+    size_t          count;       /* Number of entries before OPTION_END */
+    bool            validated;   /* Structure already checked by validate_structure */
+    bool            from_schema; /* Read-only tables point into a schema blob */
+
+    /* Choices */
+    uint32_t *choice_offset; /* Start of each option in choice_order */
+    uint32_t *choice_order;  /* Choice indices of each option, sorted by value */
+
+    /* Names */
+    uint32_t *by_name; /* Indices of named options, sorted by name then position */
+    size_t    named;   /* Number of entries in by_name */
+
+    /* Bitsets below are made of `words` 64-bit words, one bit per option */
+    size_t words;
+
+    /* Dependencies */
+    uint32_t *dep_slot;  /* Bitset slot of each option, CARGS_NO_INDEX without dependencies */
+    uint64_t *requires;  /* Resolved REQUIRES of each slot */
+    uint64_t *conflicts; /* Resolved CONFLICTS of each slot */
+
+    /* Options checked after parsing even when they are not set */
+    uint64_t *required_bits; /* Required positionals */
+    uint32_t *group_of;      /* Group entry of each option, CARGS_NO_INDEX outside groups */
+    uint32_t *env_options;   /* Options that can be read from the environment */
+    size_t    env_count;
+
+    /* Schema level of each subcommand option, only for levels read from a schema blob */
+    const uint32_t *sub_levels;
+
+    /*
+     * Options touched by the current parse: preset ones (defaults) and those
+     * whose handler ran. A handler that failed leaves its option touched but
+     * not set, so the parse stops before these are used for validation.
+     */
+    uint64_t *set_bits;      /* Bitmap of touched options */
+    uint32_t *touched;       /* Indices of touched options, in the order they were touched */
+    size_t    touched_count; /* Number of entries in touched */
+    bool      recycled;      /* Untouched options may hold buffers kept by cargs_reset */
+
+    struct cargs_level_s *next;
+} cargs_level_t;
+
+#define LEVEL_BIT_WORD(index) ((index) / 64)
+#define LEVEL_BIT_MASK(index) ((uint64_t)1 << ((index) % 64))
+
+/**
+ * level_get - Get the level of an options array, building it on first use
+ *
+ * @param cargs    Cargs context
+ * @param options  Options array
+ *
+ * @return The level, or NULL if it could not be allocated
+ */
+cargs_level_t *level_get(cargs_t *cargs, cargs_option_t *options);
+
+/**
+ * level_enter - Get the level of a subcommand, building it on first use
+ *
+ * @param cargs       Cargs context
+ * @param subcommand  Subcommand option whose sub_options are entered
+ *
+ * @return The level, or NULL if it could not be allocated
+ *
+ * When the level of the subcommand's parent was read from a schema blob, the
+ * subcommand level is read from the blob too if its fingerprint matches.
+ */
+cargs_level_t *level_enter(cargs_t *cargs, cargs_option_t *subcommand);
+
+/**
+ * level_link - Add a level to the levels of a context
+ *
+ * @param cargs  Cargs context
+ * @param level  Level whose read-only tables are ready
+ *
+ * Allocates the set tracking tables, seeded with the options already set,
+ * then links the level. Without memory the level is linked untracked.
+ */
+void level_link(cargs_t *cargs, cargs_level_t *level);
+
+/**
+ * level_find - Get the level of an options array if it was already built
+ *
+ * @param cargs    Cargs context
+ * @param options  Options array
+ *
+ * @return The level, or NULL if it was not built
+ */
+cargs_level_t *level_find(const cargs_t *cargs, const cargs_option_t *options);
+
+/**
+ * level_of - Find the built level containing an option
+ *
+ * @param cargs   Cargs context
+ * @param option  Option to locate
+ * @param index   Set to the position of the option in its level
+ *
+ * @return The level, or NULL if the option belongs to no built level
+ */
+cargs_level_t *level_of(const cargs_t *cargs, const cargs_option_t *option, size_t *index);
+
+/**
+ * level_find_option - Find an option by name in an options array
+ *
+ * @param cargs    Cargs context
+ * @param options  Options array
+ * @param name     Internal name of the option
+ *
+ * @return The first option with this name, or NULL if not found
+ *
+ * Uses the name index of the level when it exists and scans the array
+ * otherwise.
+ */
+cargs_option_t *level_find_option(const cargs_t *cargs, cargs_option_t *options,
+                                  const char *name);
+
+/**
+ * level_tracks_set - Check whether a level records the options being set
+ *
+ * @param level  Level to check, may be NULL
+ *
+ * @return true if set_bits, touched and the post-parse tables are available
+ */
+bool level_tracks_set(const cargs_level_t *level);
+
+/**
+ * level_mark_set - Record that an option has been touched
+ *
+ * @param cargs   Cargs context
+ * @param option  Option whose handler just ran
+ *
+ * Options outside any built level are ignored.
+ */
+void level_mark_set(cargs_t *cargs, const cargs_option_t *option);
+
+/**
+ * level_requires_met - Check that every option required by an option is set
+ *
+ * @param level  Level of the option
+ * @param index  Position of the option in the level
+ *
+ * @return true if the bitsets prove nothing is missing. false means an option
+ *         is missing or the level has no dependency index: the caller then
+ *         walks the names to find which one.
+ */
+bool level_requires_met(const cargs_level_t *level, size_t index);
+
+/**
+ * level_conflicts_free - Check that no option conflicting with an option is set
+ *
+ * @param level  Level of the option
+ * @param index  Position of the option in the level
+ *
+ * @return true if the bitsets prove no conflicting option is set. false means
+ *         a conflict or no dependency index: the caller then walks the names.
+ */
+bool level_conflicts_free(const cargs_level_t *level, size_t index);
+
+/**
+ * levels_free - Release every level built for a context
+ *
+ * @param cargs  Cargs context
+ */
+void levels_free(cargs_t *cargs);
+
+/**
+ * choices_contain - Check whether a value is one of the choices of an option
+ *
+ * @param cargs   Cargs context
+ * @param option  Option defining the choices
+ * @param value   Scalar value, or one element of an array option
+ *
+ * @return true if the value matches a choice
+ */
+bool choices_contain(const cargs_t *cargs, const cargs_option_t *option, cargs_value_t value);
+
+/**
+ * choice_type - Scalar type of the choices of an option
+ *
+ * @param type  Value type of the option
+ *
+ * @return The element type for array options, the type itself otherwise
+ */
+cargs_valtype_t choice_type(cargs_valtype_t type);
+
+#endif /* CARGS_INTERNAL_LEVELS_H */
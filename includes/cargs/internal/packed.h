@@ -0,0 +1,86 @@
+/**
+ * cargs/internal/packed.h - Delta-packed storage of sorted integer arrays
+ *
+ * INTERNAL HEADER - NOT PART OF THE PUBLIC API
+ * Options with FLAG_PACKED are collected as a plain array, then packed once
+ * the parse succeeded. Values are cut into blocks of CARGS_PACKED_BLOCK. A
+ * block stores its first value as is, then the gaps between consecutive
+ * values minus the smallest gap of the block, bit-packed at the width of the
+ * largest one. Gaps wrap around 64 bits, so any order is stored exactly, but
+ * only sorted arrays pack well. The block entries double as skip entries:
+ * random access goes to the block first, then sums at most one block of gaps.
+ *
+ * MIT License - Copyright (c) 2024 lucocozz
+ */
+
+#ifndef CARGS_INTERNAL_PACKED_H
+#define CARGS_INTERNAL_PACKED_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "cargs/types.h"
+
+/* Number of values per block */
+#define CARGS_PACKED_BLOCK 128
+
+typedef struct cargs_packed_block_s
+{
+    long long first;  /* First value of the block */
+    uint64_t  step;   /* Smallest gap between two values of the block */
+    uint64_t  offset; /* Bit offset of the packed gaps of the block */
+    uint8_t   bits;   /* Width of each packed gap, 0 when every gap is step */
+} cargs_packed_block_t;
+
+typedef struct cargs_packed_s
+{
+    size_t               count;       /* Number of values */
+    size_t               block_count; /* Number of blocks */
+    size_t               size;        /* Size of the whole allocation in bytes */
+    cargs_packed_block_t blocks[];    /* Skip entries, followed by the packed gaps */
+} cargs_packed_t;
+
+/**
+ * packed_encode - Pack a sorted integer array
+ *
+ * @param values  Values, sorted in ascending order to pack well
+ * @param count   Number of values, at least 1
+ *
+ * @return A single allocation released with free(), or NULL without memory
+ */
+cargs_packed_t *packed_encode(const cargs_value_t *values, size_t count);
+
+/**
+ * packed_at - Get one value of a packed array
+ *
+ * @param packed  Packed array
+ * @param index   Position of the value, below packed->count
+ *
+ * @return The value
+ */
+long long packed_at(const cargs_packed_t *packed, size_t index);
+
+/**
+ * packed_next - Get the value following another one
+ *
+ * @param packed    Packed array
+ * @param index     Position of the value to get, below packed->count
+ * @param previous  Value at index - 1, ignored at the start of a block
+ *
+ * @return The value at index, in constant time
+ */
+long long packed_next(const cargs_packed_t *packed, size_t index, long long previous);
+
+/**
+ * packed_copy - Decode a range of a packed array, one block at a time
+ *
+ * @param packed  Packed array
+ * @param start   Position of the first value to decode
+ * @param out     Destination, room for length values
+ * @param length  Number of values wanted
+ *
+ * @return Number of values written, fewer than length at the end of the array
+ */
+size_t packed_copy(const cargs_packed_t *packed, size_t start, long long *out, size_t length);
+
+#endif /* CARGS_INTERNAL_PACKED_H */
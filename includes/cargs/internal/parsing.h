@@ -10,6 +10,7 @@
 #ifndef CARGS_INTERNAL_PARSING_H
 #define CARGS_INTERNAL_PARSING_H
 
+#include "cargs/internal/tokens.h"
 #include "cargs/types.h"
 
 /**
@@ -25,14 +26,47 @@
 int parse_args(cargs_t *cargs, cargs_option_t *options, int argc, char **argv);
 
 /**
- * Handle different types of arguments
+ * parse_tokens - Parse the arguments of a token source
+ *
+ * @param cargs    Cargs context
+ * @param options  Options array
+ * @param tokens   Token source, response files are expanded as they come
+ *
+ * @return Status code
+ */
+int parse_tokens(cargs_t *cargs, cargs_option_t *options, cargs_tokens_t *tokens);
+
+/**
+ * parse_token - Parse one argument
+ *
+ * @param state   Parser state, moved to the subcommand level when arg names one
+ * @param arg     Argument
+ * @param tokens  Source of the value when arg is an option that needs one
+ *
+ * @return Status code
+ */
+int parse_token(cargs_parser_t *state, char *arg, cargs_tokens_t *tokens);
+
+/**
+ * parse_complete - Environment, validation, packing and binding once every
+ * argument was parsed
+ */
+int parse_complete(cargs_t *cargs);
+
+/**
+ * enter_subcommand - Make the options of a subcommand the current level
+ *
+ * @return Status code, an invalid subcommand structure is printed and
+ *         returned rather than exiting, whatever parse function runs
+ */
+int enter_subcommand(cargs_t *cargs, cargs_option_t *option);
+
+/**
+ * Handle different types of arguments, option values are taken from tokens
  */
-int handle_subcommand(cargs_t *cargs, cargs_option_t *option, int argc, char **argv);
 int handle_positional(cargs_t *cargs, cargs_option_t *options, char *value, int position);
-int handle_long_option(cargs_t *cargs, cargs_option_t *options, char *arg, char **argv, int argc,
-                       int *current_index);
-int handle_short_option(cargs_t *cargs, cargs_option_t *options, char *arg, char **argv, int argc,
-                        int *current_index);
+int handle_long_option(cargs_t *cargs, cargs_option_t *options, char *arg, cargs_tokens_t *tokens);
+int handle_short_option(cargs_t *cargs, cargs_option_t *options, char *arg, cargs_tokens_t *tokens);
 
 /**
  * Validation and callback execution
@@ -40,9 +74,33 @@ int handle_short_option(cargs_t *cargs, cargs_option_t *options, char *arg, char
 int post_parse_validation(cargs_t *cargs);
 int execute_callbacks(cargs_t *cargs, cargs_option_t *option, char *value);
 
+/**
+ * validate_level - Validate the structure of an options array on first use
+ *
+ * @param cargs    Cargs context
+ * @param options  Options array about to be parsed
+ *
+ * Builds the level of the array in every mode, then does nothing in release
+ * mode or when the array was already validated.
+ *
+ * @return Status code, the errors of an invalid structure are in the error stack
+ */
+int validate_level(cargs_t *cargs, cargs_option_t *options);
+
 /**
  * Load option values from environment variables
  */
 int load_env_vars(cargs_t *cargs);
 
+/**
+ * Write the values of bound options into the struct given to cargs_bind
+ */
+void bind_values(cargs_t *cargs);
+
+/**
+ * Pack the arrays of options with FLAG_PACKED once the parse succeeded.
+ * Arrays that cannot be packed for lack of memory are left as they are.
+ */
+void pack_values(cargs_t *cargs);
+
 #endif /* CARGS_INTERNAL_PARSING_H */
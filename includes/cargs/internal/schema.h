@@ -0,0 +1,92 @@
+/**
+ * cargs/internal/schema.h - Precompiled level indexes
+ *
+ * INTERNAL HEADER - NOT PART OF THE PUBLIC API
+ * A schema blob holds the read-only tables of every level of an options
+ * tree, so that a context can use them in place instead of building them.
+ * The blob only holds offsets, never pointers, and can be mapped at any
+ * address. Each level carries a fingerprint of its options array: a level
+ * whose options changed since the blob was written is built at runtime.
+ *
+ * MIT License - Copyright (c) 2024 lucocozz
+ */
+
+#ifndef CARGS_INTERNAL_SCHEMA_H
+#define CARGS_INTERNAL_SCHEMA_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "cargs/internal/levels.h"
+#include "cargs/types.h"
+
+#define CARGS_SCHEMA_MAGIC   0x42534743u /* "CGSB" */
+#define CARGS_SCHEMA_VERSION 1u
+#define CARGS_SCHEMA_ORDER   0x01020304u /* Rejects blobs written with another byte order */
+
+typedef struct cargs_schema_header_s
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t byte_order;
+    uint32_t level_count; /* Entries in the level directory following the header */
+    uint64_t fingerprint; /* Fingerprint of the whole tree */
+    uint64_t size;        /* Total size of the blob in bytes */
+} cargs_schema_header_t;
+
+/* Table offsets are counted from the start of the blob, 0 when absent */
+typedef struct cargs_schema_level_s
+{
+    uint64_t fingerprint;
+    uint32_t count;
+    uint32_t named;
+    uint32_t words;
+    uint32_t env_count;
+    uint32_t choice_total; /* Entries in choice_order */
+    uint32_t slots;        /* Options having dependencies */
+    uint32_t choice_offset;
+    uint32_t choice_order;
+    uint32_t by_name;
+    uint32_t dep_slot;
+    uint32_t requires;
+    uint32_t conflicts;
+    uint32_t required_bits;
+    uint32_t group_of;
+    uint32_t env_options;
+    uint32_t sub_levels;
+} cargs_schema_level_t;
+
+/**
+ * schema_fingerprint - Fingerprint the definition of an options array
+ *
+ * @param options  Options array
+ * @param count    Set to the number of entries before OPTION_END
+ *
+ * @return 64-bit hash of everything the level tables are derived from
+ */
+uint64_t schema_fingerprint(const cargs_option_t *options, size_t *count);
+
+/**
+ * schema_serialize - Build the schema blob of an options tree
+ *
+ * @param options  Root options array
+ * @param blob     Set to the allocated blob, to be released with free()
+ * @param size     Set to the size of the blob
+ *
+ * @return Status code (0 for success, non-zero for error)
+ */
+int schema_serialize(cargs_option_t *options, void **blob, size_t *size);
+
+/**
+ * schema_load_level - Use a level of the schema blob attached to a context
+ *
+ * @param cargs    Cargs context with a schema blob
+ * @param options  Options array the level should describe
+ * @param number   Level number in the blob, 0 being the root
+ *
+ * @return The linked level, or NULL if there is no blob, the blob is invalid
+ *         or the level does not match the options array
+ */
+cargs_level_t *schema_load_level(cargs_t *cargs, cargs_option_t *options, uint32_t number);
+
+#endif /* CARGS_INTERNAL_SCHEMA_H */
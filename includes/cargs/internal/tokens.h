@@ -0,0 +1,117 @@
+/**
+ * cargs/internal/tokens.h - Sources of command-line tokens
+ *
+ * INTERNAL HEADER - NOT PART OF THE PUBLIC API
+ * The parser takes its arguments from a token source rather than from argv
+ * directly. A source walks argv and, when cargs->response_files is set,
+ * expands "@file" response files on the way: the file is mapped and
+ * tokenized in place one token at a time, so a response file is never
+ * turned into an argv array. Tokens point into the mapping, which lives
+ * until cargs_reset or cargs_free. A source can also split a command string
+ * in place, see cargs_parse_string.
+ *
+ * MIT License - Copyright (c) 2024 lucocozz
+ */
+
+#ifndef CARGS_INTERNAL_TOKENS_H
+#define CARGS_INTERNAL_TOKENS_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "cargs/types.h"
+
+/* Response files read from another response file, a file that includes itself stops here */
+#ifndef CARGS_MAX_RESPONSE_DEPTH
+    #define CARGS_MAX_RESPONSE_DEPTH 8
+#endif
+
+typedef struct cargs_response_s
+{
+    struct cargs_response_s *next; /* Other response files of the context */
+    char                    *data; /* Private writable mapping of the file */
+    size_t                   size; /* Size of the file */
+    char                    *last; /* Copy of a last token with no room for its terminator */
+} cargs_response_t;
+
+typedef struct cargs_tokens_s
+{
+    char          **argv;
+    int             argc;
+    int             index;         /* Position of the last token taken from argv, -1 before */
+    char           *text;          /* Command string left to split, NULL for argv */
+    char           *text_end;      /* End of the command string, one writable byte follows */
+    bool            responses;     /* Expand "@file" arguments */
+    size_t          depth;         /* Number of response files being read */
+    bool            more;          /* Pushed tokens: a missing value comes with the next one */
+    cargs_option_t *pending;       /* Option left without its value, when more is set */
+    bool            pending_short; /* pending was given by its short name */
+    struct
+    {
+        cargs_response_t *file;
+        const char       *path;   /* Name of the file, for error messages */
+        char             *cursor; /* Start of the text left to tokenize */
+    } files[CARGS_MAX_RESPONSE_DEPTH];
+} cargs_tokens_t;
+
+/**
+ * tokens_init - Start a token source over argv, response files are off
+ */
+void tokens_init(cargs_tokens_t *tokens, int argc, char **argv);
+
+/**
+ * tokens_init_text - Start a token source over a command string
+ *
+ * @param text    Command, split in place with tokens_split
+ * @param length  Length of the command, text[length] must be writable
+ *
+ * Response files are not expanded: the command may come from a less trusted
+ * party than the process, which should not read files on its behalf.
+ */
+void tokens_init_text(cargs_tokens_t *tokens, char *text, size_t length);
+
+/**
+ * tokens_next - Take the next token as it is, for option values
+ *
+ * @param token  Set to the token, or NULL once the source is exhausted
+ *
+ * @return Status code, an error for malformed quoting in a response file
+ */
+int tokens_next(cargs_t *cargs, cargs_tokens_t *tokens, char **token);
+
+/**
+ * tokens_next_arg - Take the next argument, expanding response files
+ *
+ * When responses is set, "@file" is replaced by the tokens of file. Like GCC,
+ * an argument that does not name a regular file is kept as it is. "@@" stands
+ * for a literal '@' at the start of an argument.
+ *
+ * @param token  Set to the argument, or NULL once the source is exhausted
+ *
+ * @return Status code
+ */
+int tokens_next_arg(cargs_t *cargs, cargs_tokens_t *tokens, char **token);
+
+/**
+ * tokens_split - Take the next shell-like token of a buffer, in place
+ *
+ * Whitespace separates tokens, single quotes keep everything literal, double
+ * quotes and backslashes escape as in a POSIX shell. Quotes and escapes are
+ * removed by moving the token text down, and the terminator is written after
+ * it when there is room before end.
+ *
+ * @param cursor  Start of the text left, moved past the token
+ * @param end     End of the text
+ * @param token   Set to the token, or NULL when only whitespace is left
+ * @param length  Set to the length of the token
+ *
+ * @return CARGS_SUCCESS, or CARGS_ERROR_INVALID_FORMAT for an unterminated quote
+ */
+int tokens_split(char **cursor, char *end, char **token, size_t *length);
+
+/**
+ * responses_free - Unmap the response files read by the last parse
+ */
+void responses_free(cargs_t *cargs);
+
+#endif /* CARGS_INTERNAL_TOKENS_H */
@@ -63,9 +63,42 @@ void   free_split(char **split);
 #define MULTI_VALUE_INITIAL_CAPACITY 8
 void adjust_array_size(cargs_option_t *option);
 void adjust_map_size(cargs_option_t *option);
-int  map_find_key(cargs_option_t *option, const char *key);
+bool   map_keys_interned(const cargs_option_t *option);
+int    map_find_key(const cargs_option_t *option, const char *key);
+int    map_find_interned(const cargs_option_t *option, const char *key);
+size_t map_insert_key(cargs_option_t *option, const char *key);
+void   map_prefix_range(const cargs_option_t *option, const char *prefix, size_t *start,
+                        size_t *end);
 void apply_array_flags(cargs_option_t *option);
 void apply_map_flags(cargs_option_t *option);
+bool recycle_option_values(cargs_option_t *option);
+
+/**
+ * Values files: with FLAG_VALUES_FILE, "@bin:path" gives a numeric array the
+ * raw little-endian 64-bit values of a file. The first values of an option
+ * are mapped as its storage (is_mapped), adding more turns the mapping into
+ * a heap copy.
+ */
+#define CARGS_BIN_PREFIX "@bin:"
+const char *values_bin_path(const cargs_option_t *option, const char *value);
+int         array_load_bin(cargs_t *cargs, cargs_option_t *option, const char *path);
+bool        copy_mapped_values(cargs_option_t *option);
+void        unmap_values(cargs_option_t *option);
+
+/**
+ * Streamed values: with FLAG_VALUES_FILE, "@path" gives an array or map
+ * option one element per line of a file, "@nul:path" one per NUL-terminated
+ * record, "-" reads stdin. The file is read in chunks of
+ * CARGS_FILE_CHUNK_SIZE and each element goes through add, the element
+ * function of the handler. "@@" escapes a value that starts with '@', other
+ * options take every value as it is.
+ */
+#define CARGS_FILE_PREFIX     '@'
+#define CARGS_NUL_PREFIX      "nul:"
+#define CARGS_FILE_CHUNK_SIZE (64 * 1024)
+const char *values_file_path(const cargs_option_t *option, const char *value);
+char       *values_unescape(const cargs_option_t *option, char *value);
+int stream_values(cargs_t *cargs, cargs_option_t *option, const char *path, cargs_handler_t add);
 
 /**
  * Value manipulation functions
@@ -74,6 +107,9 @@ int           cmp_value(cargs_valtype_t type, cargs_value_t a, cargs_value_t b);
 cargs_value_t choices_to_value(cargs_valtype_t type, cargs_value_t choices, size_t choices_count,
                                int index);
 void          free_option_value(cargs_option_t *option);
+void          reset_option_value(cargs_option_t *option);
+bool          bind_supported(cargs_valtype_t type, size_t size);
+void          bind_value(void *target, const cargs_option_t *option);
 void          print_value(FILE *stream, cargs_valtype_t type, cargs_value_t value);
 void print_value_array(FILE *stream, cargs_valtype_t type, cargs_value_t *values, size_t count);
 
@@ -85,7 +121,12 @@ cargs_option_t       *find_option_by_name(cargs_option_t *options, const char *n
 cargs_option_t       *find_option_by_sname(cargs_option_t *options, char sname);
 cargs_option_t       *find_positional(cargs_option_t *options, int position);
 cargs_option_t       *find_subcommand(cargs_option_t *options, const char *name);
-cargs_option_t       *find_option_by_active_path(cargs_t cargs, const char *option_path);
-const cargs_option_t *get_active_options(cargs_t *cargs);
+cargs_option_t       *find_option_by_active_path(const cargs_t *cargs, const char *option_path);
+const cargs_option_t *get_active_options(const cargs_t *cargs);
+
+/**
+ * Options copies, see cargs_options_clone
+ */
+bool clone_sub_options(cargs_option_t *subcommand);
 
 #endif /* CARGS_INTERNAL_UTILS_H */
@@ -10,6 +10,8 @@
 #ifndef CARGS_OPTIONS_H
 #define CARGS_OPTIONS_H
 
+#include <stddef.h>
+
 #include "cargs/internal/compiler.h"
 #include "cargs/types.h"
 
@@ -40,6 +42,7 @@ int free_map_bool_handler(cargs_option_t *option);
 int range_validator(cargs_t *cargs, cargs_option_t *option, validator_data_t data);
 int length_validator(cargs_t *cargs, cargs_option_t *option, validator_data_t data);
 int count_validator(cargs_t *cargs, cargs_option_t *option, validator_data_t data);
+int path_validator(cargs_t *cargs, cargs_option_t *option, validator_data_t data);
 int regex_validator(cargs_t *cargs, const char *value, validator_data_t data);
 
 /*
@@ -67,6 +70,8 @@ int regex_validator(cargs_t *cargs, const char *value, validator_data_t data);
 #define HELP(desc)              .help = desc
 #define FLAGS(_flags)           .flags = _flags
 #define ENV_VAR(name)           .env_name = name
+#define BIND(type, field)       .bind_offset = offsetof(type, field), \
+                                .bind_size = sizeof(((type *)0)->field)
 
 /*
  * Validator macros
@@ -94,6 +99,11 @@ int regex_validator(cargs_t *cargs, const char *value, validator_data_t data);
     .validators[0].data = (validator_data_t){ .range = (range_t){ min, max } }, \
     .validator_count = 1
 
+#define PATH_CHECK(checks) \
+    .validators[0].func = (cargs_validator_t)path_validator, \
+    .validators[0].data.path = (checks), \
+    .validator_count = 1
+
 #define PRE_VALIDATOR(fn, data) \
     .pre_validator = (cargs_pre_validator_t)(fn), \
     .pre_validator_data = (validator_data_t){ .custom = (data) }
@@ -106,15 +116,15 @@ int regex_validator(cargs_t *cargs, const char *value, validator_data_t data);
  * Choice macros for different types
  */
 #define CHOICES_INT(...) \
-    .choices = (cargs_value_t){ .as_array_int = (long long[]){ __VA_ARGS__ } }, \
+    .choices.as_array_int = (long long[]){ __VA_ARGS__ }, \
     .choices_count = sizeof((long long[]){ __VA_ARGS__ }) / sizeof(long long)
 
 #define CHOICES_STRING(...) \
-    .choices = (cargs_value_t){ .as_array_string = (char*[]){ __VA_ARGS__ } }, \
+    .choices.as_array_string = (char*[]){ __VA_ARGS__ }, \
     .choices_count = sizeof((char*[]){ __VA_ARGS__ }) / sizeof(char*)
 
 #define CHOICES_FLOAT(...) \
-    .choices = (cargs_value_t){ .as_float_array = (double[]){ __VA_ARGS__ } }, \
+    .choices.as_array_float = (double[]){ __VA_ARGS__ }, \
     .choices_count = sizeof((double[]){ __VA_ARGS__ }) / sizeof(double)
 
 /*
@@ -234,4 +244,34 @@ int regex_validator(cargs_t *cargs, const char *value, validator_data_t data);
     PRAGMA_RESTORE()                                                                               \
     PRAGMA_RESTORE()
 
+/*
+ * X-macro form of the options array definition
+ * @param name: Name of the options array, also names the `enum name##_id`
+ * @param list: Macro taking a macro X, that calls X(ID, definition) for
+ *              every entry of the array, groups and subcommands included
+ *
+ * Defines the array and an enum of the position of each entry, to be used
+ * with the _id accessors instead of option names. The enum ends with
+ * name##_COUNT, the number of entries, see CARGS_CHECK_ID.
+ */
+#define CARGS_X_ID(id, ...)     id,
+#define CARGS_X_OPTION(id, ...) __VA_ARGS__,
+
+#define CARGS_OPTIONS_X(name, list)                                                                \
+    enum name##_id { list(CARGS_X_ID) name##_COUNT };                                              \
+    PRAGMA_DISABLE_VARIADIC_MACROS()                                                               \
+    PRAGMA_DISABLE_OVERRIDE()                                                                      \
+    PRAGMA_DISABLE_PEDANTIC()                                                                      \
+    cargs_option_t name[] = {list(CARGS_X_OPTION) OPTION_END()};                                   \
+    PRAGMA_RESTORE()                                                                               \
+    PRAGMA_RESTORE()                                                                               \
+    PRAGMA_RESTORE()
+
+/*
+ * Compile-time check that id is a position of the array defined by
+ * CARGS_OPTIONS_X(name, ...), e.g. CARGS_CHECK_ID(options, OPT_VERBOSE);
+ * An ID taken from the enum of another array fails when it is out of range.
+ */
+#define CARGS_CHECK_ID(name, id) _Static_assert((id) < name##_COUNT, #id " is not an ID of " #name)
+
 #endif /* CARGS_OPTIONS_H */
@@ -95,6 +95,10 @@ typedef enum cargs_optflags_e
 
     /* Group flags */
     FLAG_EXCLUSIVE = 1 << 14, /* Only one option in group can be set */
+
+    /* Storage flags */
+    FLAG_PACKED      = 1 << 15, /* Sorted integer array stored delta-packed after parsing */
+    FLAG_VALUES_FILE = 1 << 16, /* "@path" and "@bin:path" values read elements from a file */
 } cargs_optflags_t;
 
 #define FLAG_OPTIONAL (FLAG_REQUIRED ^ FLAG_REQUIRED)
@@ -103,9 +107,11 @@ typedef enum cargs_optflags_e
 #define VERSIONING_FLAG_MASK (FLAG_DEPRECATED | FLAG_EXPERIMENTAL)
 #define OPTION_FLAG_MASK                                                                           \
     (FLAG_REQUIRED | FLAG_HIDDEN | FLAG_ADVANCED | FLAG_EXIT | VERSIONING_FLAG_MASK)
-#define OPTION_ARRAY_FLAG_MASK (FLAG_SORTED | FLAG_UNIQUE | VERSIONING_FLAG_MASK)
+#define OPTION_ARRAY_FLAG_MASK                                                                     \
+    (FLAG_SORTED | FLAG_UNIQUE | FLAG_PACKED | FLAG_VALUES_FILE | VERSIONING_FLAG_MASK)
 #define OPTION_MAP_FLAG_MASK                                                                       \
-    (FLAG_SORTED_VALUE | FLAG_SORTED_KEY | FLAG_UNIQUE_VALUE | VERSIONING_FLAG_MASK)
+    (FLAG_SORTED_VALUE | FLAG_SORTED_KEY | FLAG_UNIQUE_VALUE | FLAG_VALUES_FILE |                  \
+     VERSIONING_FLAG_MASK)
 #define GROUP_FLAG_MASK      (FLAG_EXCLUSIVE)
 #define POSITIONAL_FLAG_MASK (FLAG_REQUIRED)
 #define SUBCOMMAND_FLAG_MASK (FLAG_HIDDEN | FLAG_ADVANCED | VERSIONING_FLAG_MASK)
@@ -136,6 +142,9 @@ union cargs_value_u {
     cargs_pair_t  *as_map;
 };
 
+_Static_assert(sizeof(cargs_value_t) == sizeof(long long) && sizeof(long long) == sizeof(double),
+               "Array spans need array values stored as plain long long and double arrays");
+
 typedef struct cargs_pair_s
 {
     const char   *key;
@@ -147,22 +156,49 @@ typedef struct cargs_pair_s
  */
 typedef struct cargs_array_iterator_s
 {
-    cargs_value_t *_array;    /* Pointer to the array */
-    size_t         _count;    /* Number of elements */
-    size_t         _position; /* Current position */
-    cargs_value_t  value;     /* Current value */
+    cargs_value_t               *_array;    /* Pointer to the array */
+    const struct cargs_packed_s *_packed;   /* Packed storage instead, see FLAG_PACKED */
+    size_t                       _count;    /* Number of elements */
+    size_t                       _position; /* Current position */
+    cargs_value_t                value;     /* Current value */
 } cargs_array_it_t;
 
+/**
+ * Array spans, views over the storage of an array option
+ *
+ * Array elements are cargs_value_t of the size of a long long, so the values
+ * of an array option are laid out as a plain C array of its element type.
+ */
+typedef struct cargs_span_i64_s
+{
+    const long long *data;
+    size_t           len;
+} cargs_span_i64_t;
+
+typedef struct cargs_span_f64_s
+{
+    const double *data;
+    size_t        len;
+} cargs_span_f64_t;
+
+typedef struct cargs_span_str_s
+{
+    const char *const *data;
+    size_t             len;
+} cargs_span_str_t;
+
 /**
  * Map iterator structure to efficiently iterate over key-value pairs
  */
 typedef struct cargs_map_iterator_s
 {
-    cargs_pair_t *_map;      /* Pointer to the map */
-    size_t        _count;    /* Number of elements */
-    size_t        _position; /* Current position */
-    const char   *key;       /* Current key */
-    cargs_value_t value;     /* Current value */
+    cargs_pair_t *_map;           /* Pointer to the map */
+    size_t        _count;         /* Number of elements */
+    size_t        _position;      /* Current position */
+    const char   *_prefix;        /* Keys skipped unless they start with it, NULL for all */
+    size_t        _prefix_length; /* Length of _prefix */
+    const char   *key;            /* Current key */
+    cargs_value_t value;          /* Current value */
 } cargs_map_it_t;
 
 /**
@@ -174,6 +210,18 @@ typedef struct range_s
     long long max;
 } range_t;
 
+/**
+ * cargs_pathcheck_t - Filesystem properties checked by the path validator
+ */
+typedef enum cargs_pathcheck_e
+{
+    PATH_EXISTS   = 1 << 0, /* Path must exist */
+    PATH_IS_FILE  = 1 << 1, /* Path must be a regular file */
+    PATH_IS_DIR   = 1 << 2, /* Path must be a directory */
+    PATH_READABLE = 1 << 3, /* Path must be readable */
+    PATH_WRITABLE = 1 << 4, /* Path must be writable */
+} cargs_pathcheck_t;
+
 /**
  * regex_data_t - Data structure for regex validation
  */
@@ -187,9 +235,10 @@ typedef struct regex_data_s
  * validator_data_u - Data used by validator functions
  */
 union validator_data_u {
-    void        *custom; /* Custom validator data */
-    range_t      range;  /* Range limits */
-    regex_data_t regex;  /* Regex pattern and info */
+    void             *custom; /* Custom validator data */
+    range_t           range;  /* Range limits */
+    regex_data_t      regex;  /* Regex pattern and info */
+    cargs_pathcheck_t path;   /* Filesystem checks */
 };
 
 /* Callback function types */
@@ -234,6 +283,8 @@ struct cargs_option_s
     cargs_valtype_t value_type;
     cargs_value_t   value;
     bool            is_allocated;
+    bool            is_packed; /* value.as_ptr holds a packed array, see FLAG_PACKED */
+    bool            is_mapped; /* value.as_array maps a values file, see "@bin:" */
     cargs_value_t   default_value;
     bool            have_default;
     cargs_value_t   choices;
@@ -242,6 +293,9 @@ struct cargs_option_s
     size_t          value_capacity;
     char           *env_name;
 
+    /* String elements of array and map options, see cargs/internal/intern.h */
+    struct cargs_intern_chunk_s *strings;
+
     /* Callbacks metadata */
     cargs_handler_t       handler;
     cargs_free_handler_t  free_handler;
@@ -262,6 +316,11 @@ struct cargs_option_s
     /* Subcommand metadata */
     cargs_action_t         action;
     struct cargs_option_s *sub_options;
+    bool                   is_cloned; /* Entry of an array copied by cargs_options_clone */
+
+    /* Binding metadata, see BIND */
+    size_t bind_offset; /* Offset of the destination field in the bound struct */
+    size_t bind_size;   /* Size of the destination field, 0 when not bound */
 };
 
 #define MULTI_VALUE_INITIAL_CAPACITY 8
@@ -271,6 +330,70 @@ struct cargs_option_s
     #define MAX_SUBCOMMAND_DEPTH 8
 #endif
 
+/**
+ * Option handle, resolved once by cargs_resolve to skip the path lookup
+ */
+typedef struct cargs_handle_s
+{
+    cargs_option_t *_option; /* Resolved option, NULL if the path matched nothing */
+} cargs_handle_t;
+
+/**
+ * Typed handles, resolved by cargs_resolve_i64 and siblings
+ *
+ * They point straight at the value of an option whose type was checked when
+ * resolving, or at cargs_nil_value when the path or the type did not match.
+ */
+typedef struct cargs_i64_s
+{
+    const long long *_value;
+} cargs_i64_t;
+
+typedef struct cargs_f64_s
+{
+    const double *_value;
+} cargs_f64_t;
+
+typedef struct cargs_str_s
+{
+    char *const *_value;
+} cargs_str_t;
+
+typedef struct cargs_bool_s
+{
+    const bool *_value;
+} cargs_bool_t;
+
+/**
+ * Set options iterator structure to visit only the options set by a parse
+ */
+typedef struct cargs_set_iterator_s
+{
+    struct cargs_level_s *_levels[MAX_SUBCOMMAND_DEPTH + 1]; /* Levels to visit, root first */
+    size_t                _level_count;                      /* Number of levels */
+    size_t                _level;                            /* Current level */
+    size_t                _position;                         /* Position in the current level */
+    const char           *name;                              /* Name of the current option */
+    cargs_value_t         value;                             /* Value of the current option */
+    const cargs_option_t *option;                            /* Current option */
+} cargs_set_it_t;
+
+/**
+ * Parser state, kept between tokens by the push API (cargs_parser_feed) and
+ * used for a whole argv by cargs_parse. The subcommand depth is part of the
+ * context.
+ */
+typedef struct cargs_parser_s
+{
+    cargs_t        *_cargs;            /* Context being filled */
+    cargs_option_t *_options;          /* Options of the current command level */
+    int             _positional_index; /* Position of the next positional argument */
+    bool            _only_positional;  /* "--" was seen */
+    cargs_option_t *_pending;          /* Option waiting for the next token as its value */
+    bool            _pending_short;    /* _pending was given by its short name */
+    int             _status;           /* First failure, later tokens are ignored */
+} cargs_parser_t;
+
 /**
  * Error context - tracks where errors occurred
  */
@@ -318,10 +441,21 @@ struct cargs_s
     const char *version;
     const char *description;
     const char *env_prefix;
+    bool        response_files; /* Expand "@file" arguments, off by default */
 
     /* Internal fields - do not access directly */
-    cargs_option_t     *options;
-    cargs_error_stack_t error_stack;
+    cargs_option_t          *options;
+    size_t                   option_count; /* Entries of options, checked by the _id accessors */
+    cargs_error_stack_t      error_stack;
+    struct cargs_level_s    *levels;       /* Lookup indexes, one per options array */
+    struct cargs_intern_s   *keys;         /* Interned map keys */
+    const void              *schema;       /* Precompiled indexes, see cargs_init_schema */
+    size_t                   schema_size;  /* Size of the schema blob */
+    bool                     release_mode; /* Structure validation disabled */
+    void                    *bind_target;  /* Struct receiving bound values, see cargs_bind */
+    struct cargs_response_s *responses;    /* Response files mapped by the parse */
+    char                    *line;         /* Copy of the command, see cargs_parse_string */
+    size_t                   line_size;    /* Size of the copy */
     struct
     {
         const char           *option;
@@ -77,5 +77,6 @@ class LibcargsConan(ConanFile):
             self.cpp_info.defines.append("CARGS_NO_REGEX")
         if self.settings.os == "Linux":
             self.cpp_info.system_libs.append("m")
+            self.cpp_info.system_libs.append("pthread")
         self.cpp_info.set_property("cmake_find_mode", "both")
         self.cpp_info.set_property("pkg_config_name", "cargs")
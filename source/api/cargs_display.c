@@ -11,31 +11,46 @@
 #include <stdio.h>
 
 /**
- * cargs_print_help - Print help message for command-line options
+ * cargs_print_help_ref, cargs_print_help - Print help message for command-line options
  *
  * param cargs  Cargs context
  */
+void cargs_print_help_ref(const cargs_t *cargs)
+{
+    display_help(cargs, NULL);
+}
+
 void cargs_print_help(cargs_t cargs)
 {
-    display_help(&cargs, NULL);
+    cargs_print_help_ref(&cargs);
 }
 
 /**
- * cargs_print_usage - Print short usage information
+ * cargs_print_usage_ref, cargs_print_usage - Print short usage information
  *
  * param cargs  Cargs context
  */
+void cargs_print_usage_ref(const cargs_t *cargs)
+{
+    display_usage(cargs, NULL);
+}
+
 void cargs_print_usage(cargs_t cargs)
 {
-    display_usage(&cargs, NULL);
+    cargs_print_usage_ref(&cargs);
 }
 
 /**
- * cargs_print_version - Print version information
+ * cargs_print_version_ref, cargs_print_version - Print version information
  *
  * param cargs  Cargs context
  */
+void cargs_print_version_ref(const cargs_t *cargs)
+{
+    display_version(cargs);
+}
+
 void cargs_print_version(cargs_t cargs)
 {
-    display_version(&cargs);
+    cargs_print_version_ref(&cargs);
 }
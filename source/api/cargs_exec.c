@@ -3,9 +3,14 @@
 #include "cargs/types.h"
 #include <stddef.h>
 
+bool cargs_has_command_ref(const cargs_t *cargs)
+{
+    return (cargs->context.subcommand_depth > 0);
+}
+
 bool cargs_has_command(cargs_t cargs)
 {
-    return (cargs.context.subcommand_depth > 0);
+    return (cargs_has_command_ref(&cargs));
 }
 
 int cargs_exec(cargs_t *cargs, void *data)
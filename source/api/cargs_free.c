@@ -1,20 +1,55 @@
 #include <stdlib.h>
 
+#include "cargs/internal/intern.h"
+#include "cargs/internal/levels.h"
+#include "cargs/internal/tokens.h"
 #include "cargs/internal/utils.h"
 #include "cargs/types.h"
 
-static void free_options(cargs_option_t *options)
+/*
+ * Options are left as defined so that the array can be given to cargs_init
+ * again.
+ */
+static void free_option(cargs_option_t *option)
+{
+    free_option_value(option);
+    reset_option_value(option);
+}
+
+static void free_all(cargs_option_t *options)
 {
     for (cargs_option_t *option = options; option->type != TYPE_NONE; ++option)
-        free_option_value(option);
+        free_option(option);
+}
+
+static void free_level(const cargs_level_t *level)
+{
+    // Only options that have been set can hold allocated values
+    if (level_tracks_set(level) && !level->recycled) {
+        for (size_t i = 0; i < level->touched_count; ++i)
+            free_option(&level->options[level->touched[i]]);
+        return;
+    }
+    free_all(level->options);
 }
 
 void cargs_free(cargs_t *cargs)
 {
-    free_options(cargs->options);
+    // Levels entered by a parse before cargs_reset can still hold values
+    for (const cargs_level_t *level = cargs->levels; level != NULL; level = level->next)
+        free_level(level);
+
+    if (level_find(cargs, cargs->options) == NULL)
+        free_all(cargs->options);
     for (size_t i = 0; i < cargs->context.subcommand_depth; ++i) {
-        const cargs_option_t *subcommand = cargs->context.subcommand_stack[i];
-        cargs_option_t       *options    = subcommand->sub_options;
-        free_options(options);
+        cargs_option_t *options = cargs->context.subcommand_stack[i]->sub_options;
+        if (level_find(cargs, options) == NULL)
+            free_all(options);
     }
+    levels_free(cargs);
+    intern_free(cargs);
+    responses_free(cargs);
+    free(cargs->line);
+    cargs->line      = NULL;
+    cargs->line_size = 0;
 }
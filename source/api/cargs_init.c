@@ -4,31 +4,48 @@
 
 #include "cargs/errors.h"
 #include "cargs/internal/context.h"
+#include "cargs/internal/levels.h"
+#include "cargs/internal/parsing.h"
+#include "cargs/internal/schema.h"
 #include "cargs/types.h"
 
-int validate_structure(cargs_t *cargs, cargs_option_t *options);
-
-cargs_t cargs_init_mode(cargs_option_t *options, const char *program_name, const char *version,
-                        bool release_mode)
+cargs_t cargs_init_schema_mode(cargs_option_t *options, const char *program_name,
+                               const char *version, const void *schema, size_t schema_size,
+                               bool release_mode)
 {
     cargs_t cargs = {
         .program_name      = program_name,
         .version           = version,
         .description       = NULL,
         .env_prefix        = NULL,
+        .response_files    = false,
         .options           = options,
         .error_stack.count = 0,
+        .levels            = NULL,
+        .schema            = schema,
+        .schema_size       = schema_size,
+        .release_mode      = release_mode,
     };
     context_init(&cargs);
+    while (options[cargs.option_count].type != TYPE_NONE)
+        cargs.option_count++;
 
-    if (release_mode == false) {
-        if (validate_structure(&cargs, options) != CARGS_SUCCESS) {
-            fprintf(stderr, "Error while initializing cargs:\n\n");
-            cargs_print_error_stack(&cargs);
-            exit(EXIT_FAILURE);
-        }
-        context_init(&cargs);
+    // Tables read from the schema blob when it matches, built otherwise
+    if (schema_load_level(&cargs, options, 0) == NULL)
+        level_get(&cargs, options);
+
+    // Subcommand levels are validated when parsing first enters them
+    if (validate_level(&cargs, options) != CARGS_SUCCESS) {
+        fprintf(stderr, "Error while initializing cargs:\n\n");
+        cargs_print_error_stack(&cargs);
+        exit(EXIT_FAILURE);
     }
 
     return (cargs);
 }
+
+cargs_t cargs_init_mode(cargs_option_t *options, const char *program_name, const char *version,
+                        bool release_mode)
+{
+    return cargs_init_schema_mode(options, program_name, version, NULL, 0, release_mode);
+}
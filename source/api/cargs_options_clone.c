@@ -0,0 +1,80 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "cargs/api.h"
+#include "cargs/internal/utils.h"
+#include "cargs/types.h"
+
+/* Sub-options still shared with the array the subcommand was cloned from */
+static bool borrows_sub_options(const cargs_option_t *option)
+{
+    return (option->type == TYPE_SUBCOMMAND && option->sub_options != NULL &&
+            !option->sub_options->is_cloned);
+}
+
+/*
+ * Copy one level. Subcommands keep the sub-options of the original until
+ * they are entered, see clone_sub_options. Sub-options that are already a
+ * copy cannot be shared: the copy they belong to may be destroyed first.
+ */
+static cargs_option_t *clone_level(const cargs_option_t *options)
+{
+    size_t count = 0;
+    while (options[count].type != TYPE_NONE)
+        ++count;
+
+    // The OPTION_END entry is copied too, and marks an empty copy as cloned
+    cargs_option_t *copy = malloc((count + 1) * sizeof(*copy));
+    if (copy == NULL)
+        return (NULL);
+    memcpy(copy, options, (count + 1) * sizeof(*copy));
+
+    for (size_t i = 0; i <= count; ++i) {
+        reset_option_value(&copy[i]);
+        copy[i].is_cloned = true;
+        if (copy[i].type == TYPE_SUBCOMMAND && !borrows_sub_options(&options[i]))
+            copy[i].sub_options = NULL;
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        if (options[i].type != TYPE_SUBCOMMAND || options[i].sub_options == NULL ||
+            copy[i].sub_options != NULL)
+            continue;
+
+        copy[i].sub_options = clone_level(options[i].sub_options);
+        if (copy[i].sub_options == NULL) {
+            cargs_options_destroy(copy);
+            return (NULL);
+        }
+    }
+    return (copy);
+}
+
+bool clone_sub_options(cargs_option_t *subcommand)
+{
+    if (!subcommand->is_cloned || !borrows_sub_options(subcommand))
+        return (true);
+
+    cargs_option_t *copy = clone_level(subcommand->sub_options);
+    if (copy == NULL)
+        return (false);
+    subcommand->sub_options = copy;
+    return (true);
+}
+
+cargs_option_t *cargs_options_clone(const cargs_option_t *options)
+{
+    return (clone_level(options));
+}
+
+void cargs_options_destroy(cargs_option_t *options)
+{
+    if (options == NULL)
+        return;
+
+    for (cargs_option_t *option = options; option->type != TYPE_NONE; ++option) {
+        if (option->type == TYPE_SUBCOMMAND && !borrows_sub_options(option))
+            cargs_options_destroy(option->sub_options);
+    }
+    free(options);
+}
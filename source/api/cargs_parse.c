@@ -5,13 +5,22 @@
 #include "cargs/errors.h"
 #include "cargs/internal/display.h"
 #include "cargs/internal/parsing.h"
+#include "cargs/internal/tokens.h"
 #include "cargs/types.h"
 
+/* Smallest copy of a command, most commands fit without growing it */
+#define CARGS_LINE_MIN_SIZE 256
+
 void cargs_free(cargs_t *cargs);
 
-int cargs_parse(cargs_t *cargs, int argc, char **argv)
+void cargs_bind(cargs_t *cargs, void *target)
+{
+    cargs->bind_target = target;
+}
+
+/* Everything that follows the arguments, whatever their source */
+static int finish_parse(cargs_t *cargs, int status)
 {
-    int status = parse_args(cargs, cargs->options, argc - 1, &argv[1]);
     if (status == CARGS_SOULD_EXIT) {
         cargs_free(cargs);
         exit(CARGS_SUCCESS);
@@ -25,11 +34,33 @@ int cargs_parse(cargs_t *cargs, int argc, char **argv)
         printf(" --help' for more information.\n");
         return (status);
     }
+    return (parse_complete(cargs));
+}
 
-    status = load_env_vars(cargs);
-    if (status != CARGS_SUCCESS)
-        return (status);
+int cargs_parse(cargs_t *cargs, int argc, char **argv)
+{
+    return (finish_parse(cargs, parse_args(cargs, cargs->options, argc - 1, &argv[1])));
+}
+
+int cargs_parse_buffer(cargs_t *cargs, char *buffer, size_t length)
+{
+    cargs_tokens_t tokens;
 
-    status = post_parse_validation(cargs);
-    return (status);
+    tokens_init_text(&tokens, buffer, length);
+    return (finish_parse(cargs, parse_tokens(cargs, cargs->options, &tokens)));
+}
+
+int cargs_parse_string(cargs_t *cargs, const char *line, size_t length)
+{
+    // The copy is kept by the context, commands that fit in it allocate nothing
+    if (length + 1 > cargs->line_size) {
+        size_t size  = length + 1 > CARGS_LINE_MIN_SIZE ? length + 1 : CARGS_LINE_MIN_SIZE;
+        char  *grown = realloc(cargs->line, size);
+        if (grown == NULL)
+            CARGS_REPORT_ERROR(cargs, CARGS_ERROR_MEMORY, "Failed to copy the command");
+        cargs->line      = grown;
+        cargs->line_size = size;
+    }
+    memcpy(cargs->line, line, length);
+    return (cargs_parse_buffer(cargs, cargs->line, length));
 }
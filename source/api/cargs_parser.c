@@ -0,0 +1,61 @@
+#include "cargs/errors.h"
+#include "cargs/internal/context.h"
+#include "cargs/internal/parsing.h"
+#include "cargs/internal/tokens.h"
+#include "cargs/types.h"
+
+void cargs_parser_begin(cargs_t *cargs, cargs_parser_t *parser)
+{
+    *parser = (cargs_parser_t){
+        ._cargs   = cargs,
+        ._options = cargs->options,
+        ._status  = CARGS_SUCCESS,
+    };
+}
+
+int cargs_parser_feed(cargs_parser_t *parser, char *token)
+{
+    cargs_t *cargs = parser->_cargs;
+
+    if (parser->_status != CARGS_SUCCESS)
+        return (parser->_status);
+
+    if (parser->_pending != NULL) {
+        cargs_option_t *option = parser->_pending;
+
+        parser->_pending = NULL;
+        context_set_option(cargs, option);
+        parser->_status = execute_callbacks(cargs, option, token);
+        return (parser->_status);
+    }
+
+    // No token follows yet: an option that needs a value is left pending
+    cargs_tokens_t tokens;
+    tokens_init(&tokens, 0, NULL);
+    tokens.more = true;
+
+    parser->_status        = parse_token(parser, token, &tokens);
+    parser->_pending       = tokens.pending;
+    parser->_pending_short = tokens.pending_short;
+    return (parser->_status);
+}
+
+int cargs_parser_end(cargs_parser_t *parser)
+{
+    cargs_t        *cargs  = parser->_cargs;
+    cargs_option_t *option = parser->_pending;
+
+    if (parser->_status != CARGS_SUCCESS)
+        return (parser->_status);
+
+    parser->_pending = NULL;
+    if (option != NULL && parser->_pending_short) {
+        parser->_status = cargs_report_error(cargs, CARGS_ERROR_MISSING_VALUE,
+                                             "Missing value for option: '-%c'", option->sname);
+    } else if (option != NULL) {
+        parser->_status = cargs_report_error(cargs, CARGS_ERROR_MISSING_VALUE,
+                                             "Missing value for option: '--%s'", option->lname);
+    } else
+        parser->_status = parse_complete(cargs);
+    return (parser->_status);
+}
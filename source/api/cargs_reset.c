@@ -0,0 +1,76 @@
+#include <string.h>
+
+#include "cargs/internal/context.h"
+#include "cargs/internal/intern.h"
+#include "cargs/internal/levels.h"
+#include "cargs/internal/tokens.h"
+#include "cargs/internal/utils.h"
+#include "cargs/types.h"
+
+/*
+ * Multi-value options keep their buffer for the next parse, every other
+ * value is released. Options go back to their default value.
+ */
+static bool reset_option(cargs_option_t *option)
+{
+    if (recycle_option_values(option))
+        return (true);
+
+    free_option_value(option);
+    reset_option_value(option);
+    return (false);
+}
+
+static void reset_all(cargs_level_t *level, cargs_option_t *options)
+{
+    for (cargs_option_t *option = options; option->type != TYPE_NONE; ++option) {
+        if (reset_option(option) && level != NULL)
+            level->recycled = true;
+    }
+}
+
+static void reset_level(cargs_level_t *level)
+{
+    if (!level_tracks_set(level)) {
+        reset_all(level, level->options);
+        return;
+    }
+
+    // Only touched options can differ from their definition
+    size_t kept = 0;
+    for (size_t i = 0; i < level->touched_count; ++i) {
+        uint32_t        index  = level->touched[i];
+        cargs_option_t *option = &level->options[index];
+
+        if (reset_option(option))
+            level->recycled = true;
+        if (option->is_set)
+            level->touched[kept++] = index;
+    }
+    level->touched_count = kept;
+
+    memset(level->set_bits, 0, level->words * sizeof(*level->set_bits));
+    for (size_t i = 0; i < kept; ++i)
+        level->set_bits[LEVEL_BIT_WORD(level->touched[i])] |= LEVEL_BIT_MASK(level->touched[i]);
+}
+
+void cargs_reset(cargs_t *cargs)
+{
+    for (cargs_level_t *level = cargs->levels; level != NULL; level = level->next)
+        reset_level(level);
+
+    // Options arrays without a level, in contexts that could not build one
+    if (level_find(cargs, cargs->options) == NULL)
+        reset_all(NULL, cargs->options);
+    for (size_t i = 0; i < cargs->context.subcommand_depth; ++i) {
+        cargs_option_t *options = cargs->context.subcommand_stack[i]->sub_options;
+        if (level_find(cargs, options) == NULL)
+            reset_all(NULL, options);
+    }
+
+    // Values pointing into response files are gone, maps no longer hold interned keys
+    responses_free(cargs);
+    intern_clear(cargs);
+    cargs->error_stack.count = 0;
+    context_init(cargs);
+}
@@ -0,0 +1,59 @@
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "cargs/errors.h"
+#include "cargs/internal/schema.h"
+#include "cargs/types.h"
+
+int cargs_schema_save(cargs_option_t *options, const char *path)
+{
+    void  *blob = NULL;
+    size_t size = 0;
+    int    status;
+
+    status = schema_serialize(options, &blob, &size);
+    if (status != CARGS_SUCCESS)
+        return (status);
+
+    FILE *file = fopen(path, "wb");
+    if (file == NULL) {
+        free(blob);
+        return (CARGS_ERROR_INVALID_ARGUMENT);
+    }
+    if (fwrite(blob, 1, size, file) != size)
+        status = CARGS_ERROR_INVALID_ARGUMENT;
+    if (fclose(file) != 0)
+        status = CARGS_ERROR_INVALID_ARGUMENT;
+    free(blob);
+    return (status);
+}
+
+const void *cargs_schema_map(const char *path, size_t *size)
+{
+    struct stat st;
+    int         fd = open(path, O_RDONLY);
+
+    if (fd < 0)
+        return (NULL);
+    if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+        close(fd);
+        return (NULL);
+    }
+
+    void *blob = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (blob == MAP_FAILED)
+        return (NULL);
+    *size = st.st_size;
+    return (blob);
+}
+
+void cargs_schema_unmap(const void *schema, size_t size)
+{
+    if (schema != NULL)
+        munmap((void *)schema, size);
+}
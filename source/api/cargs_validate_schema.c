@@ -0,0 +1,47 @@
+#include <stdio.h>
+
+#include "cargs/errors.h"
+#include "cargs/internal/context.h"
+#include "cargs/internal/levels.h"
+#include "cargs/types.h"
+
+int validate_structure(cargs_t *cargs, cargs_option_t *options);
+
+/**
+ * validate_tree - Validate an options array and, recursively, its subcommands
+ */
+static int validate_tree(cargs_t *cargs, cargs_option_t *options)
+{
+    int status = validate_structure(cargs, options);
+
+    for (cargs_option_t *option = options; option->type != TYPE_NONE; ++option) {
+        if (option->type != TYPE_SUBCOMMAND || option->sub_options == NULL)
+            continue;
+
+        context_push_subcommand(cargs, option);
+        int result = validate_tree(cargs, option->sub_options);
+        if (result != CARGS_SUCCESS)
+            status = result;
+        context_pop_subcommand(cargs);
+    }
+    return (status);
+}
+
+int cargs_validate_schema(cargs_option_t *options, const char *program_name)
+{
+    cargs_t cargs = {
+        .program_name      = program_name,
+        .options           = options,
+        .error_stack.count = 0,
+        .levels            = NULL,
+    };
+    context_init(&cargs);
+
+    int status = validate_tree(&cargs, options);
+    if (status != CARGS_SUCCESS) {
+        fprintf(stderr, "Error while validating cargs schema:\n\n");
+        cargs_print_error_stack(&cargs);
+    }
+    levels_free(&cargs);
+    return (status);
+}
@@ -1,9 +1,13 @@
+#include "cargs/api.h"
+#include "cargs/internal/intern.h"
+#include "cargs/internal/levels.h"
+#include "cargs/internal/packed.h"
 #include "cargs/internal/utils.h"
 #include "cargs/types.h"
 #include <stddef.h>
 #include <string.h>
 
-cargs_value_t cargs_get(cargs_t cargs, const char *option_path)
+cargs_value_t cargs_get_ref(const cargs_t *cargs, const char *option_path)
 {
     cargs_option_t *option = find_option_by_active_path(cargs, option_path);
     if (option == NULL)
@@ -11,7 +15,7 @@ cargs_value_t cargs_get(cargs_t cargs, const char *option_path)
     return (option->value);
 }
 
-bool cargs_is_set(cargs_t cargs, const char *option_path)
+bool cargs_is_set_ref(const cargs_t *cargs, const char *option_path)
 {
     cargs_option_t *option = find_option_by_active_path(cargs, option_path);
     if (option == NULL)
@@ -19,7 +23,7 @@ bool cargs_is_set(cargs_t cargs, const char *option_path)
     return (option->is_set);
 }
 
-size_t cargs_count(cargs_t cargs, const char *option_path)
+size_t cargs_count_ref(const cargs_t *cargs, const char *option_path)
 {
     cargs_option_t *option = find_option_by_active_path(cargs, option_path);
     if (option == NULL)
@@ -27,7 +31,7 @@ size_t cargs_count(cargs_t cargs, const char *option_path)
     return (option->value_count);
 }
 
-cargs_value_t cargs_array_get(cargs_t cargs, const char *option_path, size_t index)
+cargs_value_t cargs_array_get_ref(const cargs_t *cargs, const char *option_path, size_t index)
 {
     cargs_option_t *option = find_option_by_active_path(cargs, option_path);
 
@@ -43,10 +47,12 @@ cargs_value_t cargs_array_get(cargs_t cargs, const char *option_path, size_t ind
         return ((cargs_value_t){.raw = 0});
 
     // Return the element at the specified index
+    if (option->is_packed)
+        return (cargs_packed_get(option, index));
     return option->value.as_array[index];
 }
 
-cargs_value_t cargs_map_get(cargs_t cargs, const char *option_path, const char *key)
+cargs_value_t cargs_map_get_ref(const cargs_t *cargs, const char *option_path, const char *key)
 {
     cargs_option_t *option = find_option_by_active_path(cargs, option_path);
 
@@ -54,32 +60,26 @@ cargs_value_t cargs_map_get(cargs_t cargs, const char *option_path, const char *
         return ((cargs_value_t){.raw = 0});
 
     // Check if the option is a map type
-    if (!(option->value_type & VALUE_TYPE_MAP))
+    if (!(option->value_type & VALUE_TYPE_MAP) || key == NULL)
         return ((cargs_value_t){.raw = 0});
 
-    // Look for the key in the map
-    for (size_t i = 0; i < option->value_count; ++i) {
-        if (option->value.as_map[i].key && strcmp(option->value.as_map[i].key, key) == 0) {
-            return option->value.as_map[i].value;
-        }
-    }
-
-    // Key not found
-    return ((cargs_value_t){.raw = 0});
+    // Keys never interned are in no map, the others are compared by pointer
+    int index;
+    if (map_keys_interned(option)) {
+        const char *interned = intern_find(cargs, key);
+        index                = interned ? map_find_interned(option, interned) : -1;
+    } else
+        index = map_find_key(option, key);
+    if (index < 0)
+        return ((cargs_value_t){.raw = 0});
+    return (option->value.as_map[index].value);
 }
 
-cargs_array_it_t cargs_array_it(cargs_t cargs, const char *option_path)
+cargs_array_it_t cargs_array_it_ref(const cargs_t *cargs, const char *option_path)
 {
-    cargs_array_it_t it     = {0};
-    cargs_option_t  *option = find_option_by_active_path(cargs, option_path);
-
-    if (option == NULL || !(option->value_type & VALUE_TYPE_ARRAY))
-        return it;  // Return empty iterator
-
-    it._array    = option->value.as_array;
-    it._count    = option->value_count;
-    it._position = 0;
-    return it;
+    // Empty iterator if the option is not an array
+    return (cargs_array_it_h(
+        (cargs_handle_t){._option = find_option_by_active_path(cargs, option_path)}));
 }
 
 bool cargs_array_next(cargs_array_it_t *it)
@@ -87,6 +87,11 @@ bool cargs_array_next(cargs_array_it_t *it)
     if (it == NULL || it->_position >= it->_count)
         return false;
 
+    // Packed arrays add one gap to the previous value
+    if (it->_packed != NULL) {
+        it->value.as_int64 = packed_next(it->_packed, it->_position++, it->value.as_int64);
+        return true;
+    }
     it->value = it->_array[it->_position++];
     return true;
 }
@@ -97,7 +102,7 @@ void cargs_array_reset(cargs_array_it_t *it)
         it->_position = 0;
 }
 
-cargs_map_it_t cargs_map_it(cargs_t cargs, const char *option_path)
+cargs_map_it_t cargs_map_it_ref(const cargs_t *cargs, const char *option_path)
 {
     cargs_map_it_t  it     = {0};
     cargs_option_t *option = find_option_by_active_path(cargs, option_path);
@@ -113,7 +118,15 @@ cargs_map_it_t cargs_map_it(cargs_t cargs, const char *option_path)
 
 bool cargs_map_next(cargs_map_it_t *it)
 {
-    if (it == NULL || it->_position >= it->_count)
+    if (it == NULL)
+        return false;
+
+    // Maps not sorted by key are filtered here, sorted ones are narrowed upfront
+    while (it->_prefix != NULL && it->_position < it->_count &&
+           strncmp(it->_map[it->_position].key, it->_prefix, it->_prefix_length) != 0)
+        it->_position++;
+
+    if (it->_position >= it->_count)
         return false;
 
     cargs_pair_t pair = it->_map[it->_position++];
@@ -129,3 +142,283 @@ void cargs_map_reset(cargs_map_it_t *it)
     if (it != NULL)
         it->_position = 0;
 }
+
+cargs_set_it_t cargs_set_it_ref(const cargs_t *cargs)
+{
+    cargs_set_it_t it    = {0};
+    cargs_level_t *level = level_find(cargs, cargs->options);
+
+    if (level_tracks_set(level))
+        it._levels[it._level_count++] = level;
+
+    for (size_t i = 0; i < cargs->context.subcommand_depth; ++i) {
+        level = level_find(cargs, cargs->context.subcommand_stack[i]->sub_options);
+        if (level_tracks_set(level))
+            it._levels[it._level_count++] = level;
+    }
+    return it;
+}
+
+bool cargs_set_next(cargs_set_it_t *it)
+{
+    if (it == NULL)
+        return false;
+
+    while (it->_level < it->_level_count) {
+        const cargs_level_t *level = it->_levels[it->_level];
+
+        if (it->_position >= level->touched_count) {
+            it->_level++;
+            it->_position = 0;
+            continue;
+        }
+
+        const cargs_option_t *option = &level->options[level->touched[it->_position++]];
+        if (!option->is_set)
+            continue;
+
+        it->option = option;
+        it->name   = option->name;
+        it->value  = option->value;
+        return true;
+    }
+    return false;
+}
+
+void cargs_set_reset(cargs_set_it_t *it)
+{
+    if (it != NULL) {
+        it->_level    = 0;
+        it->_position = 0;
+    }
+}
+
+/*
+ * Follow a "subcommand.option" path through the options tree, whether or
+ * not the subcommands are active.
+ */
+static cargs_option_t *resolve_in_tree(const cargs_t *cargs, const char *option_path)
+{
+    cargs_option_t *options   = cargs->options;
+    const char     *component = option_path;
+    const char     *next_dot;
+
+    while ((next_dot = strchr(component, '.')) != NULL) {
+        size_t          length     = next_dot - component;
+        cargs_option_t *subcommand = NULL;
+
+        for (cargs_option_t *option = options; option->type != TYPE_NONE; ++option) {
+            if (option->type == TYPE_SUBCOMMAND && option->sub_options != NULL &&
+                strncmp(option->name, component, length) == 0 && option->name[length] == '\0') {
+                subcommand = option;
+                break;
+            }
+        }
+        if (subcommand == NULL || !clone_sub_options(subcommand))
+            return (NULL);
+        options   = subcommand->sub_options;
+        component = next_dot + 1;
+    }
+    return (level_find_option(cargs, options, component));
+}
+
+cargs_handle_t cargs_resolve(const cargs_t *cargs, const char *option_path)
+{
+    cargs_handle_t handle = {._option = find_option_by_active_path(cargs, option_path)};
+
+    // Paths into a subcommand that was not parsed (yet) go through the tree
+    if (handle._option == NULL && option_path != NULL && option_path[0] != '.' &&
+        strchr(option_path, '.') != NULL)
+        handle._option = resolve_in_tree(cargs, option_path);
+    return (handle);
+}
+
+cargs_handle_t cargs_sub_handle_id(cargs_handle_t subcommand, size_t id)
+{
+    cargs_option_t *option = subcommand._option;
+
+    if (option == NULL || option->type != TYPE_SUBCOMMAND || option->sub_options == NULL ||
+        !clone_sub_options(option))
+        return ((cargs_handle_t){._option = NULL});
+
+    // Sub-options have no stored count, entries up to id must not be the end
+    for (size_t i = 0; i <= id; ++i) {
+        if (option->sub_options[i].type == TYPE_NONE)
+            return ((cargs_handle_t){._option = NULL});
+    }
+    return ((cargs_handle_t){._option = &option->sub_options[id]});
+}
+
+cargs_span_i64_t cargs_array_span_i64(const cargs_t *cargs, const char *option_path)
+{
+    return (cargs_array_span_i64_h(
+        (cargs_handle_t){._option = find_option_by_active_path(cargs, option_path)}));
+}
+
+cargs_span_f64_t cargs_array_span_f64(const cargs_t *cargs, const char *option_path)
+{
+    return (cargs_array_span_f64_h(
+        (cargs_handle_t){._option = find_option_by_active_path(cargs, option_path)}));
+}
+
+cargs_span_str_t cargs_array_span_str(const cargs_t *cargs, const char *option_path)
+{
+    return (cargs_array_span_str_h(
+        (cargs_handle_t){._option = find_option_by_active_path(cargs, option_path)}));
+}
+
+cargs_value_t cargs_packed_get(const cargs_option_t *option, size_t index)
+{
+    return ((cargs_value_t){.as_int64 = packed_at(option->value.as_ptr, index)});
+}
+
+size_t cargs_array_copy_i64_h(cargs_handle_t handle, size_t start, long long *out, size_t length)
+{
+    const cargs_option_t *option = handle._option;
+
+    if (option == NULL || option->value_type != VALUE_TYPE_ARRAY_INT || out == NULL)
+        return (0);
+    if (option->is_packed)
+        return (packed_copy(option->value.as_ptr, start, out, length));
+
+    if (start >= option->value_count)
+        return (0);
+    if (length > option->value_count - start)
+        length = option->value_count - start;
+    for (size_t i = 0; i < length; ++i)
+        out[i] = option->value.as_array[start + i].as_int64;
+    return (length);
+}
+
+size_t cargs_array_copy_i64(const cargs_t *cargs, const char *option_path, size_t start,
+                            long long *out, size_t length)
+{
+    return (cargs_array_copy_i64_h(
+        (cargs_handle_t){._option = find_option_by_active_path(cargs, option_path)}, start, out,
+        length));
+}
+
+const cargs_value_t cargs_nil_value = {.raw = 0};
+
+/*
+ * Resolve a path to an option whose value type is one of `types`, for the
+ * typed handles. The value of a matching option is then read without checks.
+ */
+static const cargs_option_t *resolve_typed(const cargs_t *cargs, const char *option_path,
+                                           cargs_valtype_t types)
+{
+    const cargs_option_t *option = cargs_resolve(cargs, option_path)._option;
+
+    if (option == NULL || !(option->value_type & types))
+        return (NULL);
+    return (option);
+}
+
+cargs_i64_t cargs_resolve_i64(const cargs_t *cargs, const char *option_path)
+{
+    const cargs_option_t *option = resolve_typed(cargs, option_path, VALUE_TYPE_INT);
+    return ((cargs_i64_t){option ? &option->value.as_int64 : &cargs_nil_value.as_int64});
+}
+
+cargs_f64_t cargs_resolve_f64(const cargs_t *cargs, const char *option_path)
+{
+    const cargs_option_t *option = resolve_typed(cargs, option_path, VALUE_TYPE_FLOAT);
+    return ((cargs_f64_t){option ? &option->value.as_float : &cargs_nil_value.as_float});
+}
+
+cargs_str_t cargs_resolve_str(const cargs_t *cargs, const char *option_path)
+{
+    const cargs_option_t *option = resolve_typed(cargs, option_path, VALUE_TYPE_STRING);
+    return ((cargs_str_t){option ? &option->value.as_string : &cargs_nil_value.as_string});
+}
+
+cargs_bool_t cargs_resolve_bool(const cargs_t *cargs, const char *option_path)
+{
+    const cargs_option_t *option = resolve_typed(cargs, option_path, VALUE_TYPE_ANY_BOOL);
+    return ((cargs_bool_t){option ? &option->value.as_bool : &cargs_nil_value.as_bool});
+}
+
+cargs_value_t cargs_map_get_h(cargs_handle_t handle, const char *key)
+{
+    const cargs_option_t *option = handle._option;
+
+    if (option == NULL || !(option->value_type & VALUE_TYPE_MAP) || key == NULL)
+        return ((cargs_value_t){.raw = 0});
+
+    int index = map_find_key(option, key);
+    if (index < 0)
+        return ((cargs_value_t){.raw = 0});
+    return (option->value.as_map[index].value);
+}
+
+cargs_map_it_t cargs_map_prefix_it_h(cargs_handle_t handle, const char *prefix)
+{
+    cargs_map_it_t        it     = cargs_map_it_h(handle);
+    const cargs_option_t *option = handle._option;
+
+    if (it._map == NULL || prefix == NULL)
+        return (it);
+
+    if (option->flags & FLAG_SORTED_KEY) {
+        size_t start, end;
+        map_prefix_range(option, prefix, &start, &end);
+        it._map += start;
+        it._count = end - start;
+    } else {
+        it._prefix        = prefix;
+        it._prefix_length = strlen(prefix);
+    }
+    return (it);
+}
+
+cargs_map_it_t cargs_map_prefix_it(const cargs_t *cargs, const char *option_path,
+                                   const char *prefix)
+{
+    cargs_handle_t handle = {._option = find_option_by_active_path(cargs, option_path)};
+    return (cargs_map_prefix_it_h(handle, prefix));
+}
+
+/*
+ * By-value accessors, kept for compatibility. Each call copies the whole
+ * context, error stack included: prefer the _ref variants in loops.
+ */
+
+cargs_value_t cargs_get(cargs_t cargs, const char *option_path)
+{
+    return (cargs_get_ref(&cargs, option_path));
+}
+
+bool cargs_is_set(cargs_t cargs, const char *option_path)
+{
+    return (cargs_is_set_ref(&cargs, option_path));
+}
+
+size_t cargs_count(cargs_t cargs, const char *option_path)
+{
+    return (cargs_count_ref(&cargs, option_path));
+}
+
+cargs_value_t cargs_array_get(cargs_t cargs, const char *option_path, size_t index)
+{
+    return (cargs_array_get_ref(&cargs, option_path, index));
+}
+
+cargs_value_t cargs_map_get(cargs_t cargs, const char *option_path, const char *key)
+{
+    return (cargs_map_get_ref(&cargs, option_path, key));
+}
+
+cargs_array_it_t cargs_array_it(cargs_t cargs, const char *option_path)
+{
+    return (cargs_array_it_ref(&cargs, option_path));
+}
+
+cargs_map_it_t cargs_map_it(cargs_t cargs, const char *option_path)
+{
+    return (cargs_map_it_ref(&cargs, option_path));
+}
+
+cargs_set_it_t cargs_set_it(cargs_t cargs)
+{
+    return (cargs_set_it_ref(&cargs));
+}
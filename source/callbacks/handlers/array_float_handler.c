@@ -6,26 +6,37 @@
 #include "cargs/options.h"
 #include "cargs/types.h"
 
-static void set_value(cargs_option_t *option, char *value)
+static int set_value(cargs_t *cargs, cargs_option_t *option, char *value)
 {
+    UNUSED(cargs);
     adjust_array_size(option);
-    option->value.as_array[option->value_count].as_float = strtof(value, NULL);
+    option->value.as_array[option->value_count].as_float = strtod(value, NULL);
     option->value_count++;
+    return (CARGS_SUCCESS);
 }
 
 int array_float_handler(cargs_t *cargs, cargs_option_t *option, char *value)
 {
-    UNUSED(cargs);
+    // Raw little-endian 64-bit values of a file, see bin_values.c
+    const char *path = values_bin_path(option, value);
+    if (path != NULL)
+        return (array_load_bin(cargs, option, path));
+
+    // One element per line of a file, see file_values.c
+    const char *file = values_file_path(option, value);
+    if (file != NULL)
+        return (stream_values(cargs, option, file, set_value));
+    value = values_unescape(option, value);  // "@@" escapes a leading '@'
 
     if (strchr(value, ',') != NULL) {
         char **splited_values = split(value, ",");
         if (splited_values == NULL)
             CARGS_REPORT_ERROR(cargs, CARGS_ERROR_MEMORY, "Failed to split string '%s'", value);
         for (size_t i = 0; splited_values[i] != NULL; ++i)
-            set_value(option, splited_values[i]);
+            set_value(cargs, option, splited_values[i]);
         free_split(splited_values);
     } else
-        set_value(option, value);
+        set_value(cargs, option, value);
 
     apply_array_flags(option);
     option->is_allocated = true;
@@ -21,8 +21,8 @@
  */
 typedef struct
 {
-    int start;
-    int end;
+    long long start;
+    long long end;
 } int_range_t;
 
 const char *search_range_separator(const char *value, const char *separators)
@@ -53,8 +53,8 @@ static int parse_int_range(int_range_t *range, const char *value)
     if (range_separator != NULL) {
         // Successfully parsed as a range
         // Normalize range using MIN/MAX
-        int start    = strtol(value, NULL, 10);
-        int end      = strtol(range_separator + 1, NULL, 10);
+        long long start = strtoll(value, NULL, 10);
+        long long end   = strtoll(range_separator + 1, NULL, 10);
         range->start = MIN(start, end);
         range->end   = MAX(start, end);
         return 0;
@@ -62,7 +62,7 @@ static int parse_int_range(int_range_t *range, const char *value)
 
     // Not a range, try as a single value
     char *endptr = NULL;
-    range->start = strtol(value, &endptr, 10);
+    range->start = strtoll(value, &endptr, 10);
 
     // Check if the entire string was a valid integer
     if (*endptr != '\0')
@@ -78,9 +78,9 @@ static int parse_int_range(int_range_t *range, const char *value)
  */
 static void add_range_values(cargs_option_t *option, const int_range_t *range)
 {
-    for (int i = range->start; i <= range->end; i++) {
+    for (long long i = range->start; i <= range->end; i++) {
         adjust_array_size(option);
-        option->value.as_array[option->value_count].as_int = i;
+        option->value.as_array[option->value_count].as_int64 = i;
         option->value_count++;
     }
 }
@@ -109,6 +109,17 @@ static int set_value(cargs_t *cargs, cargs_option_t *option, char *value)
  */
 int array_int_handler(cargs_t *cargs, cargs_option_t *option, char *value)
 {
+    // Raw little-endian 64-bit values of a file, see bin_values.c
+    const char *path = values_bin_path(option, value);
+    if (path != NULL)
+        return (array_load_bin(cargs, option, path));
+
+    // One element per line of a file, see file_values.c
+    const char *file = values_file_path(option, value);
+    if (file != NULL)
+        return (stream_values(cargs, option, file, set_value));
+    value = values_unescape(option, value);  // "@@" escapes a leading '@'
+
     if (strchr(value, ',') != NULL) {
         char **splited_values = split(value, ",");
         if (splited_values == NULL) {
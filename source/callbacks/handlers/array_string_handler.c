@@ -4,40 +4,64 @@
 #include <string.h>
 
 #include "cargs/errors.h"
+#include "cargs/internal/intern.h"
 #include "cargs/internal/utils.h"
 #include "cargs/options.h"
 #include "cargs/types.h"
 
-static void set_value(cargs_option_t *option, char *value)
+// Elements are packed into the chunks of the option rather than allocated one by one
+static int set_value(cargs_t *cargs, cargs_option_t *option, const char *value, size_t length)
 {
+    char *copy = chunks_store(&option->strings, value, length);
+    if (copy == NULL)
+        CARGS_REPORT_ERROR(cargs, CARGS_ERROR_MEMORY, "Failed to allocate memory for '%s'", value);
+
     adjust_array_size(option);
-    option->value.as_array[option->value_count].as_string = strdup(value);
+    option->value.as_array[option->value_count].as_string = copy;
     option->value_count++;
+    return (CARGS_SUCCESS);
+}
+
+// Elements of a values file are taken whole, commas included
+static int set_element(cargs_t *cargs, cargs_option_t *option, char *element)
+{
+    return (set_value(cargs, option, element, strlen(element)));
 }
 
 int array_string_handler(cargs_t *cargs, cargs_option_t *option, char *value)
 {
-    UNUSED(cargs);
+    // One element per line of a file, see file_values.c
+    const char *file = values_file_path(option, value);
+    if (file != NULL)
+        return (stream_values(cargs, option, file, set_element));
+    value = values_unescape(option, value);  // "@@" escapes a leading '@'
+
+    option->is_allocated = true;
 
     if (strchr(value, ',') != NULL) {
-        char **splited_values = split(value, ",");
-        if (splited_values == NULL)
-            CARGS_REPORT_ERROR(cargs, CARGS_ERROR_MEMORY, "Failed to split string '%s'", value);
-        for (size_t i = 0; splited_values[i] != NULL; ++i)
-            set_value(option, splited_values[i]);
-        free(splited_values);
-    } else
-        set_value(option, value);
+        // Same words as split(): empty ones between commas are skipped
+        for (const char *word = value; *word != '\0';) {
+            size_t length = strcspn(word, ",");
+            if (length > 0) {
+                int status = set_value(cargs, option, word, length);
+                if (status != CARGS_SUCCESS)
+                    return (status);
+            }
+            word += length + (word[length] == ',');
+        }
+    } else {
+        int status = set_value(cargs, option, value, strlen(value));
+        if (status != CARGS_SUCCESS)
+            return (status);
+    }
 
     apply_array_flags(option);
-    option->is_allocated = true;
     return (CARGS_SUCCESS);
 }
 
 int free_array_string_handler(cargs_option_t *option)
 {
-    for (size_t i = 0; i < option->value_count; ++i)
-        free(option->value.as_array[i].as_string);
+    chunks_free(&option->strings);
     free(option->value.as_array);
     return (CARGS_SUCCESS);
 }
@@ -8,6 +8,6 @@
 int float_handler(cargs_t *cargs, cargs_option_t *option, char *value)
 {
     UNUSED(cargs);
-    option->value.as_float = strtof(value, NULL);
+    option->value.as_float = strtod(value, NULL);
     return (CARGS_SUCCESS);
 }
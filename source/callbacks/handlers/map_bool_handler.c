@@ -5,6 +5,7 @@
 #include <string.h>
 
 #include "cargs/errors.h"
+#include "cargs/internal/intern.h"
 #include "cargs/internal/utils.h"
 #include "cargs/options.h"
 #include "cargs/types.h"
@@ -59,10 +60,11 @@ static int set_kv_pair(cargs_t *cargs, cargs_option_t *option, char *pair)
     }
 
     // Split the string at the separator
-    char *key = strndup(pair, separator - pair);
+    // Keys are interned: repeated keys share one copy owned by the context
+    const char *key = intern_string(cargs, pair, separator - pair);
     if (key == NULL) {
         CARGS_REPORT_ERROR(cargs, CARGS_ERROR_MEMORY, "Failed to allocate memory for key '%s'",
-                           key);
+                           pair);
     }
     char *value = separator + 1;
 
@@ -76,18 +78,15 @@ static int set_kv_pair(cargs_t *cargs, cargs_option_t *option, char *pair)
     }
 
     // Check if the key already exists
-    int key_index = map_find_key(option, key);
+    int key_index = map_find_interned(option, key);
 
     // Key exists, update value
     if (key_index >= 0) {
         option->value.as_map[key_index].value.as_bool = (bool)bool_value;
     } else {
         // Key doesn't exist, add new entry
-        adjust_map_size(option);
-
-        option->value.as_map[option->value_count].key           = key;
-        option->value.as_map[option->value_count].value.as_bool = (bool)bool_value;
-        option->value_count++;
+        size_t position = map_insert_key(option, key);
+        option->value.as_map[position].value.as_bool = (bool)bool_value;
     }
 
     return CARGS_SUCCESS;
@@ -101,6 +100,12 @@ static int set_kv_pair(cargs_t *cargs, cargs_option_t *option, char *pair)
  */
 int map_bool_handler(cargs_t *cargs, cargs_option_t *option, char *value)
 {
+    // One element per line of a file, see file_values.c
+    const char *file = values_file_path(option, value);
+    if (file != NULL)
+        return (stream_values(cargs, option, file, set_kv_pair));
+    value = values_unescape(option, value);  // "@@" escapes a leading '@'
+
     // Process comma-separated pairs
     if (strchr(value, ',') != NULL) {
         char **pairs = split(value, ",");
@@ -135,9 +140,7 @@ int map_bool_handler(cargs_t *cargs, cargs_option_t *option, char *value)
 int free_map_bool_handler(cargs_option_t *option)
 {
     if (option->value.as_map != NULL) {
-        // No need to free boolean values
-        for (size_t i = 0; i < option->value_count; ++i)
-            free((void *)option->value.as_map[i].key);
+        // Keys are interned and there is no need to free boolean values
         free(option->value.as_map);
     }
     return CARGS_SUCCESS;
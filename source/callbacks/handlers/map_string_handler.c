@@ -4,6 +4,7 @@
 #include <string.h>
 
 #include "cargs/errors.h"
+#include "cargs/internal/intern.h"
 #include "cargs/internal/utils.h"
 #include "cargs/options.h"
 #include "cargs/types.h"
@@ -21,33 +22,30 @@ static int set_kv_pair(cargs_t *cargs, cargs_option_t *option, char *pair)
     }
 
     // Split the string at the separator
-    char *key = strndup(pair, separator - pair);
+    // Keys are interned: repeated keys share one copy owned by the context
+    const char *key = intern_string(cargs, pair, separator - pair);
     if (key == NULL) {
         CARGS_REPORT_ERROR(cargs, CARGS_ERROR_MEMORY, "Failed to allocate memory for key '%s'",
-                           key);
+                           pair);
     }
-    char *value = strdup(separator + 1);
+    // Values are packed into the chunks of the option
+    char *value = chunks_store(&option->strings, separator + 1, strlen(separator + 1));
     if (value == NULL) {
-        free(key);
         CARGS_REPORT_ERROR(cargs, CARGS_ERROR_MEMORY, "Failed to allocate memory for value '%s'",
-                           value);
+                           separator + 1);
     }
 
     // Check if the key already exists
-    int key_index = map_find_key(option, key);
+    int key_index = map_find_interned(option, key);
 
     if (key_index >= 0) {
-        // Key exists, update value
-        free(option->value.as_map[key_index].value.as_string);
+        // Key exists, update value, the old one stays in the chunks until reset
         option->value.as_map[key_index].value.as_string = value;
     } else {
         // Key doesn't exist, add new entry
 
-        adjust_map_size(option);
-
-        option->value.as_map[option->value_count].key             = key;
-        option->value.as_map[option->value_count].value.as_string = value;
-        option->value_count++;
+        size_t position = map_insert_key(option, key);
+        option->value.as_map[position].value.as_string = value;
     }
 
     return CARGS_SUCCESS;
@@ -61,6 +59,14 @@ static int set_kv_pair(cargs_t *cargs, cargs_option_t *option, char *pair)
  */
 int map_string_handler(cargs_t *cargs, cargs_option_t *option, char *value)
 {
+    // One element per line of a file, see file_values.c
+    const char *file = values_file_path(option, value);
+    if (file != NULL)
+        return (stream_values(cargs, option, file, set_kv_pair));
+    value = values_unescape(option, value);  // "@@" escapes a leading '@'
+
+    option->is_allocated = true;
+
     // Process comma-separated pairs
     if (strchr(value, ',') != NULL) {
         char **pairs = split(value, ",");
@@ -85,7 +91,6 @@ int map_string_handler(cargs_t *cargs, cargs_option_t *option, char *value)
     }
 
     apply_map_flags(option);
-    option->is_allocated = true;
     return CARGS_SUCCESS;
 }
 
@@ -94,12 +99,8 @@ int map_string_handler(cargs_t *cargs, cargs_option_t *option, char *value)
  */
 int free_map_string_handler(cargs_option_t *option)
 {
-    if (option->value.as_map != NULL) {
-        for (size_t i = 0; i < option->value_count; ++i) {
-            free((void *)option->value.as_map[i].key);
-            free((void *)option->value.as_map[i].value.as_string);
-        }
-        free(option->value.as_map);
-    }
+    // Keys are interned, values live in the chunks of the option
+    chunks_free(&option->strings);
+    free(option->value.as_map);
     return CARGS_SUCCESS;
 }
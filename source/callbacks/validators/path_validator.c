@@ -0,0 +1,189 @@
+/**
+ * path_validator.c - Filesystem checks for path arguments
+ *
+ * Checks every value of a string or string array option against the
+ * filesystem. Large batches are spread over a small pool of worker threads
+ * so that the stat/access calls run in parallel instead of one at a time.
+ *
+ * MIT License - Copyright (c) 2024 lucocozz
+ */
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "cargs/errors.h"
+#include "cargs/types.h"
+
+/* Maximum number of worker threads used for one batch */
+#ifndef CARGS_PATH_WORKERS
+    #define CARGS_PATH_WORKERS 8
+#endif
+
+/* Minimum number of paths handled by each worker */
+#ifndef CARGS_PATH_BATCH_THRESHOLD
+    #define CARGS_PATH_BATCH_THRESHOLD 64
+#endif
+
+typedef struct path_batch_s
+{
+    cargs_value_t    *paths;   /* Values holding the paths */
+    cargs_pathcheck_t checks;  /* Checks to run on each path */
+    int              *results; /* Failed check for each path, 0 if valid */
+    size_t            start;   /* First path handled by this slice */
+    size_t            end;     /* One past the last path of this slice */
+} path_batch_t;
+
+/**
+ * check_path - Run the requested checks on a single path
+ *
+ * @return The first failing check, or 0 if the path is valid
+ */
+static int check_path(const char *path, cargs_pathcheck_t checks)
+{
+    struct stat st;
+
+    if (path == NULL)
+        return (PATH_EXISTS);
+
+    if (checks & (PATH_EXISTS | PATH_IS_FILE | PATH_IS_DIR)) {
+        if (stat(path, &st) != 0)
+            return (PATH_EXISTS);
+        if ((checks & PATH_IS_FILE) && !S_ISREG(st.st_mode))
+            return (PATH_IS_FILE);
+        if ((checks & PATH_IS_DIR) && !S_ISDIR(st.st_mode))
+            return (PATH_IS_DIR);
+    }
+    if ((checks & PATH_READABLE) && access(path, R_OK) != 0)
+        return (PATH_READABLE);
+    if ((checks & PATH_WRITABLE) && access(path, W_OK) != 0)
+        return (PATH_WRITABLE);
+    return (0);
+}
+
+static void *check_slice(void *arg)
+{
+    path_batch_t *batch = arg;
+
+    for (size_t i = batch->start; i < batch->end; ++i)
+        batch->results[i] = check_path(batch->paths[i].as_string, batch->checks);
+    return (NULL);
+}
+
+static size_t worker_count(size_t count)
+{
+    long   online  = sysconf(_SC_NPROCESSORS_ONLN);
+    size_t workers = count / CARGS_PATH_BATCH_THRESHOLD;
+
+    if (online > 0 && workers > (size_t)online)
+        workers = online;
+    if (workers > CARGS_PATH_WORKERS)
+        workers = CARGS_PATH_WORKERS;
+    return (workers > 0 ? workers : 1);
+}
+
+/**
+ * check_batch - Check all paths, in parallel when the batch is large enough
+ *
+ * Each worker handles a contiguous slice and writes its own range of
+ * results, so no synchronization is needed beyond the final join. A worker
+ * that cannot be started has its slice checked by the calling thread.
+ */
+static void check_batch(cargs_value_t *paths, size_t count, cargs_pathcheck_t checks, int *results)
+{
+    size_t       workers = worker_count(count);
+    pthread_t    threads[CARGS_PATH_WORKERS];
+    bool         started[CARGS_PATH_WORKERS] = {0};
+    path_batch_t slices[CARGS_PATH_WORKERS];
+    size_t       slice_size = (count + workers - 1) / workers;
+
+    for (size_t w = 0; w < workers; ++w) {
+        size_t start = w * slice_size;
+        size_t end   = start + slice_size < count ? start + slice_size : count;
+
+        slices[w] = (path_batch_t){paths, checks, results, start, end};
+        if (w > 0)
+            started[w] = pthread_create(&threads[w], NULL, check_slice, &slices[w]) == 0;
+    }
+
+    check_slice(&slices[0]);
+    for (size_t w = 1; w < workers; ++w) {
+        if (started[w])
+            pthread_join(threads[w], NULL);
+        else
+            check_slice(&slices[w]);
+    }
+}
+
+static void format_failure(char *buffer, size_t size, const char *path, int failure)
+{
+    switch (failure) {
+        case PATH_EXISTS:
+            snprintf(buffer, size, "Path '%s' does not exist", path ? path : "(null)");
+            break;
+        case PATH_IS_FILE:
+            snprintf(buffer, size, "Path '%s' is not a regular file", path);
+            break;
+        case PATH_IS_DIR:
+            snprintf(buffer, size, "Path '%s' is not a directory", path);
+            break;
+        case PATH_READABLE:
+            snprintf(buffer, size, "Path '%s' is not readable", path);
+            break;
+        default:
+            snprintf(buffer, size, "Path '%s' is not writable", path);
+            break;
+    }
+}
+
+/**
+ * path_validator - Validate that every path value satisfies filesystem checks
+ *
+ * @param cargs   Cargs context
+ * @param option  String or string array option holding the paths
+ * @param data    Validator data containing the checks to run
+ *
+ * @return Status code (0 for success, non-zero for error)
+ *
+ * Every failing path is reported, not only the first one.
+ */
+int path_validator(cargs_t *cargs, cargs_option_t *option, validator_data_t data)
+{
+    cargs_value_t *paths;
+    size_t         count;
+
+    if (option->value_type == VALUE_TYPE_STRING) {
+        paths = &option->value;
+        count = 1;
+    } else if (option->value_type == VALUE_TYPE_ARRAY_STRING) {
+        paths = option->value.as_array;
+        count = option->value_count;
+    } else {
+        CARGS_REPORT_ERROR(cargs, CARGS_ERROR_INVALID_VALUE,
+                           "Path validator requires a string or string array option");
+    }
+    if (count == 0 || paths == NULL)
+        return (CARGS_SUCCESS);
+
+    int *results = calloc(count, sizeof(int));
+    if (results == NULL) {
+        CARGS_REPORT_ERROR(cargs, CARGS_ERROR_MEMORY, "Failed to allocate path check results");
+    }
+    check_batch(paths, count, data.path, results);
+
+    int status = CARGS_SUCCESS;
+    for (size_t i = 0; i < count; ++i) {
+        if (results[i] == 0)
+            continue;
+
+        // Reported like CARGS_REPORT_ERROR, without returning on the first failure
+        char message[CARGS_MAX_ERROR_MESSAGE_SIZE];
+        format_failure(message, sizeof(message), paths[i].as_string, results[i]);
+        status = cargs_report_error(cargs, CARGS_ERROR_INVALID_VALUE, "%s", message);
+    }
+
+    free(results);
+    return (status);
+}
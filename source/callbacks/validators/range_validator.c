@@ -4,14 +4,15 @@
 int range_validator(cargs_t *cargs, cargs_option_t *option, validator_data_t data)
 {
     if (data.range.min > data.range.max) {
-        CARGS_REPORT_ERROR(cargs, CARGS_ERROR_INVALID_RANGE, "Range is invalid [%ld, %ld]",
+        CARGS_REPORT_ERROR(cargs, CARGS_ERROR_INVALID_RANGE, "Range is invalid [%lld, %lld]",
                            data.range.min, data.range.max);
         return (CARGS_ERROR_INVALID_RANGE);
     }
 
-    if (option->value.as_int < data.range.min || option->value.as_int > data.range.max) {
-        CARGS_REPORT_ERROR(cargs, CARGS_ERROR_INVALID_RANGE, "Value %d is out of range [%ld, %ld]",
-                           option->value.as_int, data.range.min, data.range.max);
+    if (option->value.as_int64 < data.range.min || option->value.as_int64 > data.range.max) {
+        CARGS_REPORT_ERROR(cargs, CARGS_ERROR_INVALID_RANGE,
+                           "Value %lld is out of range [%lld, %lld]", option->value.as_int64,
+                           data.range.min, data.range.max);
     }
     return (CARGS_SUCCESS);
 }
@@ -9,7 +9,7 @@ void context_init_subcommands(cargs_t *cargs)
     cargs->context.subcommand_depth = 0;
 }
 
-const cargs_option_t *context_get_subcommand(cargs_t *cargs)
+const cargs_option_t *context_get_subcommand(const cargs_t *cargs)
 {
     if (cargs->context.subcommand_depth == 0)
         return (NULL);
@@ -0,0 +1,176 @@
+/**
+ * intern.c - Per-context string interning and chunked string storage
+ *
+ * MIT License - Copyright (c) 2024 lucocozz
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "cargs/internal/intern.h"
+#include "cargs/types.h"
+
+#define INTERN_INITIAL_CAPACITY 32
+
+/* FNV-1a, keys are short */
+static uint64_t hash_key(const char *str, size_t length)
+{
+    uint64_t hash = 0xcbf29ce484222325ull;
+
+    for (size_t i = 0; i < length; ++i) {
+        hash ^= (unsigned char)str[i];
+        hash *= 0x100000001b3ull;
+    }
+    return (hash);
+}
+
+/*
+ * Slot holding the string, or the empty slot where it would go. The table
+ * is never full: it grows at 3/4 of its capacity.
+ */
+static size_t find_slot(const cargs_intern_t *pool, const char *str, size_t length, uint64_t hash)
+{
+    size_t mask = pool->capacity - 1;
+    size_t slot = (size_t)hash & mask;
+
+    while (pool->slots[slot] != NULL) {
+        if (pool->hashes[slot] == hash && strncmp(pool->slots[slot], str, length) == 0 &&
+            pool->slots[slot][length] == '\0')
+            return (slot);
+        slot = (slot + 1) & mask;
+    }
+    return (slot);
+}
+
+static bool grow_table(cargs_intern_t *pool)
+{
+    size_t       capacity = pool->capacity ? pool->capacity * 2 : INTERN_INITIAL_CAPACITY;
+    const char **slots    = calloc(capacity, sizeof(*slots));
+    uint64_t    *hashes   = malloc(capacity * sizeof(*hashes));
+
+    if (slots == NULL || hashes == NULL) {
+        free(slots);
+        free(hashes);
+        return (false);
+    }
+
+    for (size_t i = 0; i < pool->capacity; ++i) {
+        if (pool->slots[i] == NULL)
+            continue;
+        size_t slot = (size_t)pool->hashes[i] & (capacity - 1);
+        while (slots[slot] != NULL)
+            slot = (slot + 1) & (capacity - 1);
+        slots[slot]  = pool->slots[i];
+        hashes[slot] = pool->hashes[i];
+    }
+    free(pool->slots);
+    free(pool->hashes);
+    pool->slots    = slots;
+    pool->hashes   = hashes;
+    pool->capacity = capacity;
+    return (true);
+}
+
+char *chunks_store(cargs_intern_chunk_t **chunks, const char *str, size_t length)
+{
+    cargs_intern_chunk_t *chunk = *chunks;
+
+    if (chunk == NULL || chunk->size - chunk->used < length + 1) {
+        size_t size = length + 1 > CARGS_INTERN_CHUNK_SIZE ? length + 1 : CARGS_INTERN_CHUNK_SIZE;
+        chunk       = malloc(sizeof(*chunk) + size);
+        if (chunk == NULL)
+            return (NULL);
+        chunk->used = 0;
+        chunk->size = size;
+        chunk->next = *chunks;
+        *chunks     = chunk;
+    }
+
+    char *copy = chunk->data + chunk->used;
+    memcpy(copy, str, length);
+    copy[length] = '\0';
+    chunk->used += length + 1;
+    return (copy);
+}
+
+void chunks_clear(cargs_intern_chunk_t **chunks)
+{
+    if (*chunks == NULL)
+        return;
+    chunks_free(&(*chunks)->next);
+    (*chunks)->used = 0;
+}
+
+void chunks_free(cargs_intern_chunk_t **chunks)
+{
+    while (*chunks != NULL) {
+        cargs_intern_chunk_t *next = (*chunks)->next;
+        free(*chunks);
+        *chunks = next;
+    }
+}
+
+const char *intern_string(cargs_t *cargs, const char *str, size_t length)
+{
+    cargs_intern_t *pool = cargs->keys;
+
+    if (pool == NULL) {
+        pool = calloc(1, sizeof(*pool));
+        if (pool == NULL)
+            return (NULL);
+        cargs->keys = pool;
+    }
+    if ((pool->count + 1) * 4 > pool->capacity * 3 && !grow_table(pool))
+        return (NULL);
+
+    uint64_t hash = hash_key(str, length);
+    size_t   slot = find_slot(pool, str, length, hash);
+    if (pool->slots[slot] != NULL)
+        return (pool->slots[slot]);
+
+    char *copy = chunks_store(&pool->chunks, str, length);
+    if (copy == NULL)
+        return (NULL);
+    pool->slots[slot]  = copy;
+    pool->hashes[slot] = hash;
+    pool->count++;
+    return (copy);
+}
+
+const char *intern_find(const cargs_t *cargs, const char *str)
+{
+    const cargs_intern_t *pool = cargs->keys;
+
+    if (pool == NULL || pool->capacity == 0 || str == NULL)
+        return (NULL);
+
+    size_t length = strlen(str);
+    return (pool->slots[find_slot(pool, str, length, hash_key(str, length))]);
+}
+
+void intern_clear(cargs_t *cargs)
+{
+    cargs_intern_t *pool = cargs->keys;
+
+    if (pool == NULL)
+        return;
+
+    chunks_clear(&pool->chunks);
+    if (pool->count > 0)
+        memset(pool->slots, 0, pool->capacity * sizeof(*pool->slots));
+    pool->count = 0;
+}
+
+void intern_free(cargs_t *cargs)
+{
+    cargs_intern_t *pool = cargs->keys;
+
+    if (pool == NULL)
+        return;
+
+    chunks_free(&pool->chunks);
+    free(pool->slots);
+    free(pool->hashes);
+    free(pool);
+    cargs->keys = NULL;
+}
@@ -0,0 +1,550 @@
+/**
+ * levels.c - Lookup indexes built once per options array
+ *
+ * MIT License - Copyright (c) 2024 lucocozz
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "cargs/internal/levels.h"
+#include "cargs/internal/schema.h"
+#include "cargs/internal/utils.h"
+#include "cargs/types.h"
+
+typedef struct choice_entry_s
+{
+    cargs_value_t value;
+    uint32_t      index;
+} choice_entry_t;
+
+typedef struct name_entry_s
+{
+    const char *name;
+    uint32_t    index;
+} name_entry_t;
+
+cargs_valtype_t choice_type(cargs_valtype_t type)
+{
+    switch (type) {
+        case VALUE_TYPE_ARRAY_INT:
+            return (VALUE_TYPE_INT);
+        case VALUE_TYPE_ARRAY_STRING:
+            return (VALUE_TYPE_STRING);
+        case VALUE_TYPE_ARRAY_FLOAT:
+            return (VALUE_TYPE_FLOAT);
+        default:
+            return (type);
+    }
+}
+
+/*
+ * Total order matching cmp_value() equality, without the overflow of
+ * subtracting integers.
+ */
+static int compare_choice(cargs_valtype_t type, cargs_value_t a, cargs_value_t b)
+{
+    switch (type) {
+        case VALUE_TYPE_INT:
+            return ((a.as_int64 > b.as_int64) - (a.as_int64 < b.as_int64));
+        case VALUE_TYPE_FLOAT:
+            return ((a.as_float > b.as_float) - (a.as_float < b.as_float));
+        default:
+            return (strcmp(a.as_string, b.as_string));
+    }
+}
+
+static int compare_int_entries(const void *a, const void *b)
+{
+    return compare_choice(VALUE_TYPE_INT, ((const choice_entry_t *)a)->value,
+                          ((const choice_entry_t *)b)->value);
+}
+
+static int compare_float_entries(const void *a, const void *b)
+{
+    return compare_choice(VALUE_TYPE_FLOAT, ((const choice_entry_t *)a)->value,
+                          ((const choice_entry_t *)b)->value);
+}
+
+static int compare_string_entries(const void *a, const void *b)
+{
+    return compare_choice(VALUE_TYPE_STRING, ((const choice_entry_t *)a)->value,
+                          ((const choice_entry_t *)b)->value);
+}
+
+static bool is_indexable(const cargs_option_t *option)
+{
+    cargs_valtype_t type = choice_type(option->value_type);
+
+    if (option->choices_count < CARGS_CHOICES_INDEX_MIN || option->choices.as_ptr == NULL)
+        return (false);
+    if (type == VALUE_TYPE_STRING) {
+        for (size_t i = 0; i < option->choices_count; ++i) {
+            if (option->choices.as_array_string[i] == NULL)
+                return (false);
+        }
+        return (true);
+    }
+    return (type == VALUE_TYPE_INT || type == VALUE_TYPE_FLOAT);
+}
+
+static void sort_choices(const cargs_option_t *option, choice_entry_t *entries, uint32_t *order)
+{
+    cargs_valtype_t type = choice_type(option->value_type);
+    int (*compare)(const void *, const void *);
+
+    for (size_t i = 0; i < option->choices_count; ++i) {
+        entries[i].value = choices_to_value(type, option->choices, option->choices_count, i);
+        entries[i].index = i;
+    }
+
+    if (type == VALUE_TYPE_INT)
+        compare = compare_int_entries;
+    else if (type == VALUE_TYPE_FLOAT)
+        compare = compare_float_entries;
+    else
+        compare = compare_string_entries;
+    qsort(entries, option->choices_count, sizeof(*entries), compare);
+
+    for (size_t i = 0; i < option->choices_count; ++i)
+        order[i] = entries[i].index;
+}
+
+/*
+ * Sort the choices of every option having enough of them. When memory runs
+ * out the level simply has no choice index and lookups fall back to a scan.
+ */
+static void build_choice_index(cargs_level_t *level)
+{
+    size_t total   = 0;
+    size_t largest = 0;
+
+    for (size_t i = 0; i < level->count; ++i) {
+        const cargs_option_t *option = &level->options[i];
+        if (!is_indexable(option))
+            continue;
+        total += option->choices_count;
+        if (option->choices_count > largest)
+            largest = option->choices_count;
+    }
+    if (total == 0 || total >= CARGS_NO_INDEX)
+        return;
+
+    uint32_t       *offsets = malloc(level->count * sizeof(*offsets));
+    uint32_t       *order   = malloc(total * sizeof(*order));
+    choice_entry_t *entries = malloc(largest * sizeof(*entries));
+    if (offsets == NULL || order == NULL || entries == NULL) {
+        free(offsets);
+        free(order);
+        free(entries);
+        return;
+    }
+
+    uint32_t next = 0;
+    for (size_t i = 0; i < level->count; ++i) {
+        const cargs_option_t *option = &level->options[i];
+        if (!is_indexable(option)) {
+            offsets[i] = CARGS_NO_INDEX;
+            continue;
+        }
+        offsets[i] = next;
+        sort_choices(option, entries, order + next);
+        next += option->choices_count;
+    }
+    free(entries);
+
+    level->choice_offset = offsets;
+    level->choice_order  = order;
+}
+
+static int compare_name_entries(const void *a, const void *b)
+{
+    const name_entry_t *left  = a;
+    const name_entry_t *right = b;
+    int                 cmp   = strcmp(left->name, right->name);
+
+    if (cmp != 0)
+        return (cmp);
+    return ((left->index > right->index) - (left->index < right->index));
+}
+
+/*
+ * Sort the named options so that names are found by binary search. Equal
+ * names keep their array order, the first one being the one returned, like
+ * find_option_by_name does.
+ */
+static void build_name_index(cargs_level_t *level)
+{
+    name_entry_t *entries = malloc(level->count * sizeof(*entries));
+    if (entries == NULL)
+        return;
+
+    size_t named = 0;
+    for (size_t i = 0; i < level->count; ++i) {
+        if (level->options[i].name != NULL)
+            entries[named++] = (name_entry_t){level->options[i].name, i};
+    }
+    qsort(entries, named, sizeof(*entries), compare_name_entries);
+
+    level->by_name = malloc((named > 0 ? named : 1) * sizeof(*level->by_name));
+    if (level->by_name != NULL) {
+        for (size_t i = 0; i < named; ++i)
+            level->by_name[i] = entries[i].index;
+        level->named = named;
+    }
+    free(entries);
+}
+
+static uint32_t find_name(const cargs_level_t *level, const char *name)
+{
+    size_t low  = 0;
+    size_t high = level->named;
+
+    while (low < high) {
+        size_t middle = low + (high - low) / 2;
+        if (strcmp(level->options[level->by_name[middle]].name, name) < 0)
+            low = middle + 1;
+        else
+            high = middle;
+    }
+    if (low < level->named && strcmp(level->options[level->by_name[low]].name, name) == 0)
+        return (level->by_name[low]);
+    return (CARGS_NO_INDEX);
+}
+
+static void resolve_names(const cargs_level_t *level, const char **names, uint64_t *bits)
+{
+    for (size_t i = 0; names[i] != NULL; ++i) {
+        uint32_t index = find_name(level, names[i]);
+        if (index != CARGS_NO_INDEX)
+            bits[LEVEL_BIT_WORD(index)] |= LEVEL_BIT_MASK(index);
+    }
+}
+
+/*
+ * Resolve REQUIRES and CONFLICTS once into bitsets over the level. Only
+ * options having dependencies get a slot. Names that match no option are
+ * left out; validate_dependencies reports them.
+ */
+static void build_dependency_index(cargs_level_t *level)
+{
+    size_t slots = 0;
+
+    if (level->by_name == NULL)
+        return;
+    for (size_t i = 0; i < level->count; ++i) {
+        if (level->options[i].requires != NULL || level->options[i].conflicts != NULL)
+            slots++;
+    }
+
+    if (slots == 0)
+        return;
+
+    uint32_t *dep_slot  = malloc(level->count * sizeof(*dep_slot));
+    uint64_t *requires  = calloc(slots * level->words, sizeof(*requires));
+    uint64_t *conflicts = calloc(slots * level->words, sizeof(*conflicts));
+    if (dep_slot == NULL || requires == NULL || conflicts == NULL) {
+        free(dep_slot);
+        free(requires);
+        free(conflicts);
+        return;
+    }
+
+    uint32_t slot = 0;
+    for (size_t i = 0; i < level->count; ++i) {
+        const cargs_option_t *option = &level->options[i];
+
+        if (option->requires == NULL && option->conflicts == NULL) {
+            dep_slot[i] = CARGS_NO_INDEX;
+            continue;
+        }
+        dep_slot[i] = slot;
+        if (option->requires != NULL)
+            resolve_names(level, option->requires, requires + slot * level->words);
+        if (option->conflicts != NULL)
+            resolve_names(level, option->conflicts, conflicts + slot * level->words);
+        slot++;
+    }
+
+    level->dep_slot  = dep_slot;
+    level->requires  = requires;
+    level->conflicts = conflicts;
+}
+
+static bool is_env_capable(const cargs_option_t *option)
+{
+    if (option->type == TYPE_GROUP || option->type == TYPE_SUBCOMMAND)
+        return (false);
+    return (option->env_name != NULL || (option->flags & FLAG_AUTO_ENV));
+}
+
+static void free_post_parse_tables(cargs_level_t *level)
+{
+    free(level->required_bits);
+    free(level->group_of);
+    free(level->env_options);
+    level->required_bits = NULL;
+    level->group_of      = NULL;
+    level->env_options   = NULL;
+    level->env_count     = 0;
+}
+
+/*
+ * Prepare the tables that let post-parse steps visit only the options that
+ * matter: set options, required positionals and environment-capable ones.
+ */
+static void build_post_parse_tables(cargs_level_t *level)
+{
+    size_t words = level->words > 0 ? level->words : 1;
+    size_t count = level->count > 0 ? level->count : 1;
+
+    level->required_bits = calloc(words, sizeof(*level->required_bits));
+    level->group_of      = malloc(count * sizeof(*level->group_of));
+    level->env_options   = malloc(count * sizeof(*level->env_options));
+    if (level->required_bits == NULL || level->group_of == NULL || level->env_options == NULL) {
+        free_post_parse_tables(level);
+        return;
+    }
+
+    uint32_t group = CARGS_NO_INDEX;
+    for (size_t i = 0; i < level->count; ++i) {
+        const cargs_option_t *option = &level->options[i];
+
+        if (option->type == TYPE_GROUP)
+            group = i;
+        level->group_of[i] = group;
+
+        if (option->type == TYPE_POSITIONAL && (option->flags & FLAG_REQUIRED))
+            level->required_bits[LEVEL_BIT_WORD(i)] |= LEVEL_BIT_MASK(i);
+        if (is_env_capable(option))
+            level->env_options[level->env_count++] = i;
+    }
+}
+
+static void free_set_tracking(cargs_level_t *level)
+{
+    free(level->set_bits);
+    free(level->touched);
+    level->set_bits      = NULL;
+    level->touched       = NULL;
+    level->touched_count = 0;
+}
+
+/*
+ * Per-parse tracking of the touched options. Options already set (those
+ * with a default value) start in the touched list.
+ */
+static void init_set_tracking(cargs_level_t *level)
+{
+    if (level->required_bits == NULL || level->group_of == NULL || level->env_options == NULL)
+        return;
+
+    level->set_bits = calloc(level->words > 0 ? level->words : 1, sizeof(*level->set_bits));
+    level->touched  = malloc((level->count > 0 ? level->count : 1) * sizeof(*level->touched));
+    if (level->set_bits == NULL || level->touched == NULL) {
+        free_set_tracking(level);
+        return;
+    }
+
+    for (size_t i = 0; i < level->count; ++i) {
+        if (level->options[i].is_set) {
+            level->set_bits[LEVEL_BIT_WORD(i)] |= LEVEL_BIT_MASK(i);
+            level->touched[level->touched_count++] = i;
+        }
+    }
+}
+
+void level_link(cargs_t *cargs, cargs_level_t *level)
+{
+    init_set_tracking(level);
+    level->next   = cargs->levels;
+    cargs->levels = level;
+}
+
+cargs_level_t *level_find(const cargs_t *cargs, const cargs_option_t *options)
+{
+    for (cargs_level_t *level = cargs->levels; level != NULL; level = level->next) {
+        if (level->options == options)
+            return (level);
+    }
+    return (NULL);
+}
+
+cargs_level_t *level_get(cargs_t *cargs, cargs_option_t *options)
+{
+    if (options == NULL)
+        return (NULL);
+
+    cargs_level_t *level = level_find(cargs, options);
+    if (level != NULL)
+        return (level);
+
+    level = calloc(1, sizeof(*level));
+    if (level == NULL)
+        return (NULL);
+
+    level->options = options;
+    while (options[level->count].type != TYPE_NONE)
+        level->count++;
+    level->words = (level->count + 63) / 64;
+    build_choice_index(level);
+    build_name_index(level);
+    build_dependency_index(level);
+    build_post_parse_tables(level);
+    level_link(cargs, level);
+    return (level);
+}
+
+cargs_level_t *level_enter(cargs_t *cargs, cargs_option_t *subcommand)
+{
+    size_t         index;
+    cargs_level_t *parent = level_of(cargs, subcommand, &index);
+    cargs_level_t *level  = level_find(cargs, subcommand->sub_options);
+
+    if (level == NULL && parent != NULL && parent->sub_levels != NULL &&
+        parent->sub_levels[index] != CARGS_NO_INDEX)
+        level = schema_load_level(cargs, subcommand->sub_options, parent->sub_levels[index]);
+    if (level == NULL)
+        level = level_get(cargs, subcommand->sub_options);
+    return (level);
+}
+
+cargs_level_t *level_of(const cargs_t *cargs, const cargs_option_t *option, size_t *index)
+{
+    uintptr_t address = (uintptr_t)option;
+
+    for (cargs_level_t *level = cargs->levels; level != NULL; level = level->next) {
+        uintptr_t first = (uintptr_t)level->options;
+        uintptr_t last  = (uintptr_t)(level->options + level->count);
+
+        if (address >= first && address < last) {
+            *index = option - level->options;
+            return (level);
+        }
+    }
+    return (NULL);
+}
+
+cargs_option_t *level_find_option(const cargs_t *cargs, cargs_option_t *options,
+                                  const char *name)
+{
+    const cargs_level_t *level = level_find(cargs, options);
+
+    if (name == NULL)
+        return (NULL);
+    if (level == NULL || level->by_name == NULL)
+        return (find_option_by_name(options, name));
+
+    uint32_t index = find_name(level, name);
+    return (index != CARGS_NO_INDEX ? &level->options[index] : NULL);
+}
+
+bool level_tracks_set(const cargs_level_t *level)
+{
+    return (level != NULL && level->touched != NULL);
+}
+
+void level_mark_set(cargs_t *cargs, const cargs_option_t *option)
+{
+    size_t         index;
+    cargs_level_t *level = level_of(cargs, option, &index);
+
+    if (!level_tracks_set(level))
+        return;
+    if (level->set_bits[LEVEL_BIT_WORD(index)] & LEVEL_BIT_MASK(index))
+        return;
+    level->set_bits[LEVEL_BIT_WORD(index)] |= LEVEL_BIT_MASK(index);
+    level->touched[level->touched_count++] = index;
+}
+
+bool level_requires_met(const cargs_level_t *level, size_t index)
+{
+    if (!level_tracks_set(level) || level->dep_slot == NULL ||
+        level->dep_slot[index] == CARGS_NO_INDEX)
+        return (false);
+
+    const uint64_t *requires = level->requires + level->dep_slot[index] * level->words;
+    uint64_t        missing  = 0;
+    for (size_t w = 0; w < level->words; ++w)
+        missing |= requires[w] & ~level->set_bits[w];
+    return (missing == 0);
+}
+
+bool level_conflicts_free(const cargs_level_t *level, size_t index)
+{
+    if (!level_tracks_set(level) || level->dep_slot == NULL ||
+        level->dep_slot[index] == CARGS_NO_INDEX)
+        return (false);
+
+    const uint64_t *conflicts = level->conflicts + level->dep_slot[index] * level->words;
+    uint64_t        found     = 0;
+    for (size_t w = 0; w < level->words; ++w)
+        found |= conflicts[w] & level->set_bits[w];
+    return (found == 0);
+}
+
+void levels_free(cargs_t *cargs)
+{
+    cargs_level_t *level = cargs->levels;
+
+    while (level != NULL) {
+        cargs_level_t *next = level->next;
+        if (!level->from_schema) {
+            free(level->choice_offset);
+            free(level->choice_order);
+            free(level->by_name);
+            free(level->dep_slot);
+            free(level->requires);
+            free(level->conflicts);
+            free_post_parse_tables(level);
+        }
+        free_set_tracking(level);
+        free(level);
+        level = next;
+    }
+    cargs->levels = NULL;
+}
+
+static bool search_choices(const cargs_option_t *option, const uint32_t *order,
+                           cargs_value_t value)
+{
+    cargs_valtype_t type = choice_type(option->value_type);
+    size_t          low  = 0;
+    size_t          high = option->choices_count;
+
+    if (type == VALUE_TYPE_STRING && value.as_string == NULL)
+        return (false);
+
+    while (low < high) {
+        size_t        middle = low + (high - low) / 2;
+        cargs_value_t choice =
+            choices_to_value(type, option->choices, option->choices_count, order[middle]);
+        int cmp = compare_choice(type, value, choice);
+
+        if (cmp == 0)
+            return (true);
+        if (cmp < 0)
+            high = middle;
+        else
+            low = middle + 1;
+    }
+    return (false);
+}
+
+bool choices_contain(const cargs_t *cargs, const cargs_option_t *option, cargs_value_t value)
+{
+    cargs_valtype_t      type = choice_type(option->value_type);
+    size_t               index;
+    const cargs_level_t *level = level_of(cargs, option, &index);
+
+    if (level != NULL && level->choice_offset != NULL &&
+        level->choice_offset[index] != CARGS_NO_INDEX)
+        return search_choices(option, level->choice_order + level->choice_offset[index], value);
+
+    for (size_t i = 0; i < option->choices_count; ++i) {
+        cargs_value_t choice = choices_to_value(type, option->choices, option->choices_count, i);
+        if (cmp_value(type, value, choice) == 0)
+            return (true);
+    }
+    return (false);
+}
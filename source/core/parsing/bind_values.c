@@ -0,0 +1,35 @@
+#include "cargs/internal/levels.h"
+#include "cargs/internal/parsing.h"
+#include "cargs/internal/utils.h"
+#include "cargs/types.h"
+
+static void bind_option(cargs_t *cargs, const cargs_option_t *option)
+{
+    if (option->bind_size != 0 && option->is_set)
+        bind_value(cargs->bind_target, option);
+}
+
+static void bind_options(cargs_t *cargs, cargs_option_t *options)
+{
+    const cargs_level_t *level = level_find(cargs, options);
+
+    // Unset options keep the value the application put in its struct
+    if (level_tracks_set(level)) {
+        for (size_t i = 0; i < level->touched_count; ++i)
+            bind_option(cargs, &options[level->touched[i]]);
+        return;
+    }
+
+    for (cargs_option_t *option = options; option->type != TYPE_NONE; ++option)
+        bind_option(cargs, option);
+}
+
+void bind_values(cargs_t *cargs)
+{
+    if (cargs->bind_target == NULL)
+        return;
+
+    bind_options(cargs, cargs->options);
+    for (size_t i = 0; i < cargs->context.subcommand_depth; ++i)
+        bind_options(cargs, cargs->context.subcommand_stack[i]->sub_options);
+}
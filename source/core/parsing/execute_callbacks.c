@@ -1,4 +1,5 @@
 #include "cargs/errors.h"
+#include "cargs/internal/levels.h"
 #include "cargs/types.h"
 #include <stddef.h>
 #include <stdio.h>
@@ -19,6 +20,8 @@ int execute_callbacks(cargs_t *cargs, cargs_option_t *option, char *value)
     }
 
     status = option->handler(cargs, option, value);
+    // Recorded even on failure, the handler may have allocated part of the value
+    level_mark_set(cargs, option);
     if (status != CARGS_SUCCESS)
         return (status);
 
@@ -4,20 +4,25 @@
 #include <string.h>
 
 #include "cargs/errors.h"
+#include "cargs/internal/levels.h"
 #include "cargs/internal/parsing.h"
 #include "cargs/types.h"
 
+#define CARGS_ENV_NAME_MAX 128
+
 /**
  * get_env_var_name - Get environment variable name for an option
  *
- * @param cargs  Cargs context
- * @param option Option to get env var name for
+ * @param cargs     Cargs context
+ * @param option    Option to get env var name for
+ * @param full_name Buffer receiving composed names, owned by the caller so
+ *                  that concurrent parses do not share it
  *
  * @return Environment variable name or NULL if none
  */
-static const char *get_env_var_name(cargs_t *cargs, cargs_option_t *option)
+static const char *get_env_var_name(cargs_t *cargs, cargs_option_t *option,
+                                    char full_name[CARGS_ENV_NAME_MAX])
 {
-    static char full_name[128];
     const char *prefix           = cargs->env_prefix ? cargs->env_prefix : "";
     size_t      prefix_len       = strlen(prefix);
     bool        needs_underscore = prefix_len > 0 && prefix[prefix_len - 1] != '_';
@@ -30,9 +35,9 @@ static const char *get_env_var_name(cargs_t *cargs, cargs_option_t *option)
             return (option->env_name);
 
         if (needs_underscore) {
-            snprintf(full_name, sizeof(full_name), "%s_%s", prefix, option->env_name);
+            snprintf(full_name, CARGS_ENV_NAME_MAX, "%s_%s", prefix, option->env_name);
         } else {
-            snprintf(full_name, sizeof(full_name), "%s%s", prefix, option->env_name);
+            snprintf(full_name, CARGS_ENV_NAME_MAX, "%s%s", prefix, option->env_name);
         }
         return (full_name);
     }
@@ -41,11 +46,11 @@ static const char *get_env_var_name(cargs_t *cargs, cargs_option_t *option)
         const char *name = option->name ? option->name : (option->lname ? option->lname : "");
 
         if (option->flags & FLAG_NO_ENV_PREFIX) {
-            snprintf(full_name, sizeof(full_name), "%s", name);
+            snprintf(full_name, CARGS_ENV_NAME_MAX, "%s", name);
         } else if (needs_underscore) {
-            snprintf(full_name, sizeof(full_name), "%s_%s", prefix, name);
+            snprintf(full_name, CARGS_ENV_NAME_MAX, "%s_%s", prefix, name);
         } else {
-            snprintf(full_name, sizeof(full_name), "%s%s", prefix, name);
+            snprintf(full_name, CARGS_ENV_NAME_MAX, "%s%s", prefix, name);
         }
 
         for (char *p = full_name; *p; ++p)
@@ -56,37 +61,56 @@ static const char *get_env_var_name(cargs_t *cargs, cargs_option_t *option)
     return (NULL);
 }
 
-static int load_env(cargs_t *cargs, cargs_option_t *options)
+static int load_option_env(cargs_t *cargs, cargs_option_t *option)
 {
-    for (int i = 0; options[i].type != TYPE_NONE; ++i) {
-        cargs_option_t *option = &options[i];
-
-        if (option->type == TYPE_GROUP || option->type == TYPE_SUBCOMMAND)
-            continue;
-
-        if (option->is_set && !(option->flags & FLAG_ENV_OVERRIDE))
-            continue;
-
-        const char *env_name = get_env_var_name(cargs, option);
-        if (!env_name)
-            continue;
+    if (option->type == TYPE_GROUP || option->type == TYPE_SUBCOMMAND)
+        return (CARGS_SUCCESS);
+
+    if (option->is_set && !(option->flags & FLAG_ENV_OVERRIDE))
+        return (CARGS_SUCCESS);
+
+    char        full_name[CARGS_ENV_NAME_MAX];
+    const char *env_name = get_env_var_name(cargs, option, full_name);
+    if (!env_name)
+        return (CARGS_SUCCESS);
+
+    char *env_value = getenv(env_name);
+    if (!env_value)
+        return (CARGS_SUCCESS);
+
+    bool          was_set   = option->is_set;
+    cargs_value_t old_value = option->value;
+
+    //! possible leak here
+    int status = execute_callbacks(cargs, option, env_value);
+    if (status != CARGS_SUCCESS) {
+        if (was_set) {
+            option->is_set = was_set;
+            option->value  = old_value;
+        }
+        return (status);
+    }
+    return (CARGS_SUCCESS);
+}
 
-        char *env_value = getenv(env_name);
-        if (!env_value)
-            continue;
+static int load_env(cargs_t *cargs, cargs_option_t *options)
+{
+    const cargs_level_t *level = level_find(cargs, options);
 
-        bool          was_set   = option->is_set;
-        cargs_value_t old_value = option->value;
+    // Only the options declaring an environment variable can be loaded
+    if (level_tracks_set(level)) {
+        for (size_t i = 0; i < level->env_count; ++i) {
+            int status = load_option_env(cargs, &options[level->env_options[i]]);
+            if (status != CARGS_SUCCESS)
+                return (status);
+        }
+        return (CARGS_SUCCESS);
+    }
 
-        //! possible leak here
-        int status = execute_callbacks(cargs, option, env_value);
-        if (status != CARGS_SUCCESS) {
-            if (was_set) {
-                option->is_set = was_set;
-                option->value  = old_value;
-            }
+    for (int i = 0; options[i].type != TYPE_NONE; ++i) {
+        int status = load_option_env(cargs, &options[i]);
+        if (status != CARGS_SUCCESS)
             return (status);
-        }
     }
     return (CARGS_SUCCESS);
 }
@@ -4,11 +4,11 @@
 #include "cargs/errors.h"
 #include "cargs/internal/context.h"
 #include "cargs/internal/parsing.h"
+#include "cargs/internal/tokens.h"
 #include "cargs/internal/utils.h"
 #include "cargs/types.h"
 
-int handle_long_option(cargs_t *cargs, cargs_option_t *options, char *arg, char **argv, int argc,
-                       int *current_index)
+int handle_long_option(cargs_t *cargs, cargs_option_t *options, char *arg, cargs_tokens_t *tokens)
 {
     char  option_name[64] = {0};
     char *equal_pos       = strchr(arg, '=');
@@ -28,10 +28,18 @@ int handle_long_option(cargs_t *cargs, cargs_option_t *options, char *arg, char
     if (option->value_type != VALUE_TYPE_FLAG) {
         if (equal_pos != NULL) {  // Format "--option=value"
             value = equal_pos + 1;
-        } else if (*current_index + 1 < argc) {  // Format ["--option", "value"]
-            *current_index += 1;
-            value = argv[*current_index];
-        } else {
+        } else {  // Format ["--option", "value"]
+            int status = tokens_next(cargs, tokens, &value);
+            if (status != CARGS_SUCCESS)
+                return (status);
+        }
+        if (value == NULL && tokens->more) {
+            // The value will be the next pushed token
+            tokens->pending       = option;
+            tokens->pending_short = false;
+            return (CARGS_SUCCESS);
+        }
+        if (value == NULL) {
             CARGS_REPORT_ERROR(cargs, CARGS_ERROR_MISSING_VALUE, "Missing value for option: '--%s'",
                                option_name);
         }
@@ -4,11 +4,12 @@
 #include "cargs/errors.h"
 #include "cargs/internal/context.h"
 #include "cargs/internal/parsing.h"
+#include "cargs/internal/tokens.h"
 #include "cargs/internal/utils.h"
 #include "cargs/types.h"
 
-int handle_short_option(cargs_t *cargs, cargs_option_t *options, char *arg, char **argv, int argc,
-                        int *current_index)
+int handle_short_option(cargs_t *cargs, cargs_option_t *options, char *arg,
+                        cargs_tokens_t *tokens)
 {
     size_t len = strlen(arg);
 
@@ -28,11 +29,19 @@ int handle_short_option(cargs_t *cargs, cargs_option_t *options, char *arg, char
             if (i < len - 1) {
                 value = arg + i + 1;
                 i     = len;
-            } else if (*current_index + 1 < argc) {
-                // Format ["-o", "value"]
-                *current_index += 1;
-                value = argv[*current_index];
             } else {
+                // Format ["-o", "value"]
+                int status = tokens_next(cargs, tokens, &value);
+                if (status != CARGS_SUCCESS)
+                    return (status);
+            }
+            if (value == NULL && tokens->more) {
+                // The value will be the next pushed token, this is the last letter
+                tokens->pending       = option;
+                tokens->pending_short = true;
+                return (CARGS_SUCCESS);
+            }
+            if (value == NULL) {
                 CARGS_REPORT_ERROR(cargs, CARGS_ERROR_MISSING_VALUE,
                                    "Missing value for option: '-%c'", option_char);
             }
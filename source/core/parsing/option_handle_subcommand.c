@@ -1,10 +1,29 @@
+#include <stdio.h>
+
+#include "cargs/errors.h"
 #include "cargs/internal/context.h"
+#include "cargs/internal/levels.h"
 #include "cargs/internal/parsing.h"
+#include "cargs/internal/utils.h"
 #include "cargs/types.h"
 
-int handle_subcommand(cargs_t *cargs, cargs_option_t *option, int argc, char **argv)
+int enter_subcommand(cargs_t *cargs, cargs_option_t *option)
 {
+    // A copied tree gets its own sub-options on first entry
+    if (!clone_sub_options(option))
+        CARGS_REPORT_ERROR(cargs, CARGS_ERROR_MEMORY, "Failed to copy subcommand '%s'",
+                           option->name);
+
     context_push_subcommand(cargs, option);
     option->is_set = true;
-    return parse_args(cargs, option->sub_options, argc, argv);
+    level_mark_set(cargs, option);
+    level_enter(cargs, option);
+
+    // Checked on first entry, see validate_level
+    int status = validate_level(cargs, option->sub_options);
+    if (status != CARGS_SUCCESS) {
+        fprintf(stderr, "Invalid subcommand '%s':\n\n", option->name);
+        cargs_print_error_stack(cargs);
+    }
+    return (status);
 }
@@ -0,0 +1,52 @@
+#include <stdlib.h>
+
+#include "cargs/internal/callbacks/handlers.h"
+#include "cargs/internal/levels.h"
+#include "cargs/internal/packed.h"
+#include "cargs/internal/parsing.h"
+#include "cargs/internal/utils.h"
+#include "cargs/types.h"
+
+static void pack_option(cargs_option_t *option)
+{
+    // A custom free handler may expect its own array
+    if (!(option->flags & FLAG_PACKED) || option->is_packed || !option->is_allocated ||
+        option->value_type != VALUE_TYPE_ARRAY_INT || option->value_count == 0 ||
+        option->free_handler != default_free)
+        return;
+
+    cargs_packed_t *packed = packed_encode(option->value.as_array, option->value_count);
+    if (packed == NULL)
+        return;
+
+    // A single allocation, released by default_free like the array it replaces
+    if (option->is_mapped)
+        unmap_values(option);
+    else
+        free(option->value.as_array);
+    option->value.as_ptr   = packed;
+    option->value_capacity = 0;
+    option->is_packed      = true;
+}
+
+static void pack_options(cargs_t *cargs, cargs_option_t *options)
+{
+    cargs_level_t *level = level_find(cargs, options);
+
+    // Only touched options hold values
+    if (level_tracks_set(level)) {
+        for (size_t i = 0; i < level->touched_count; ++i)
+            pack_option(&options[level->touched[i]]);
+        return;
+    }
+
+    for (cargs_option_t *option = options; option->type != TYPE_NONE; ++option)
+        pack_option(option);
+}
+
+void pack_values(cargs_t *cargs)
+{
+    pack_options(cargs, cargs->options);
+    for (size_t i = 0; i < cargs->context.subcommand_depth; ++i)
+        pack_options(cargs, cargs->context.subcommand_stack[i]->sub_options);
+}
@@ -3,68 +3,95 @@
 
 #include "cargs/errors.h"
 #include "cargs/internal/parsing.h"
+#include "cargs/internal/tokens.h"
 #include "cargs/internal/utils.h"
 #include "cargs/types.h"
 
 int parse_args(cargs_t *cargs, cargs_option_t *options, int argc, char **argv)
 {
-    int  positional_index = 0;
-    bool only_positional  = false;
-    int  status           = CARGS_SUCCESS;
+    cargs_tokens_t tokens;
 
-    for (int i = 0; i < argc; ++i) {
-        char *arg = argv[i];
+    tokens_init(&tokens, argc, argv);
+    tokens.responses = cargs->response_files;
+    return (parse_tokens(cargs, options, &tokens));
+}
 
-        if (strcmp(arg, "--") == 0) {
-            only_positional = true;
-            continue;
-        }
+int parse_tokens(cargs_t *cargs, cargs_option_t *options, cargs_tokens_t *tokens)
+{
+    cargs_parser_t state = {._cargs = cargs, ._options = options};
+    int            status;
+    char          *arg;
 
-        if (only_positional) {
-            status = handle_positional(cargs, options, arg, positional_index++);
-            if (status != CARGS_SUCCESS)
-                return (status);
-            continue;
-        }
+    for (;;) {
+        // Response files are not expanded after "--"
+        status = state._only_positional ? tokens_next(cargs, tokens, &arg)
+                                        : tokens_next_arg(cargs, tokens, &arg);
+        if (status != CARGS_SUCCESS || arg == NULL)
+            return (status);
 
-        char *long_arg = starts_with("--", arg);
-        if (long_arg != NULL) {
-            status = handle_long_option(cargs, options, long_arg, argv, argc, &i);
-            if (status != CARGS_SUCCESS)
-                return (status);
-            continue;
-        }
+        status = parse_token(&state, arg, tokens);
+        if (status != CARGS_SUCCESS)
+            return (status);
+    }
+}
 
-        char *short_arg = starts_with("-", arg);
-        if (short_arg != NULL) {
-            // Checking if this is a negative number or an option
-            if (isdigit(short_arg[0]) || (short_arg[0] == '.' && isdigit(short_arg[1]))) {
-                cargs_option_t *pos_opt = find_positional(options, positional_index);
-
-                if (pos_opt && (pos_opt->value_type & VALUE_TYPE_ANY_NUMERIC)) {
-                    status = handle_positional(cargs, options, arg, positional_index++);
-                    if (status != CARGS_SUCCESS)
-                        return (status);
-                    continue;
-                }
-            }
-
-            // Otherwise, handle as a regular short option
-            status = handle_short_option(cargs, options, short_arg, argv, argc, &i);
-            if (status != CARGS_SUCCESS)
-                return (status);
-            continue;
-        }
+int parse_token(cargs_parser_t *state, char *arg, cargs_tokens_t *tokens)
+{
+    cargs_t        *cargs   = state->_cargs;
+    cargs_option_t *options = state->_options;
 
-        cargs_option_t *subcommand = find_subcommand(options, arg);
-        if (subcommand != NULL) {
-            status = handle_subcommand(cargs, subcommand, argc - i - 1, &argv[i + 1]);
-            return (status);
+    if (strcmp(arg, "--") == 0) {
+        state->_only_positional = true;
+        return (CARGS_SUCCESS);
+    }
+
+    if (state->_only_positional)
+        return (handle_positional(cargs, options, arg, state->_positional_index++));
+
+    char *long_arg = starts_with("--", arg);
+    if (long_arg != NULL)
+        return (handle_long_option(cargs, options, long_arg, tokens));
+
+    char *short_arg = starts_with("-", arg);
+    if (short_arg != NULL) {
+        // Checking if this is a negative number or an option
+        if (isdigit(short_arg[0]) || (short_arg[0] == '.' && isdigit(short_arg[1]))) {
+            cargs_option_t *pos_opt = find_positional(options, state->_positional_index);
+
+            if (pos_opt && (pos_opt->value_type & VALUE_TYPE_ANY_NUMERIC))
+                return (handle_positional(cargs, options, arg, state->_positional_index++));
         }
 
-        status = handle_positional(cargs, options, arg, positional_index++);
+        // Otherwise, handle as a regular short option
+        return (handle_short_option(cargs, options, short_arg, tokens));
+    }
+
+    // The following tokens belong to the subcommand
+    cargs_option_t *subcommand = find_subcommand(options, arg);
+    if (subcommand != NULL) {
+        int status = enter_subcommand(cargs, subcommand);
         if (status != CARGS_SUCCESS)
             return (status);
+        state->_options          = subcommand->sub_options;
+        state->_positional_index = 0;
+        state->_only_positional  = false;
+        return (CARGS_SUCCESS);
     }
-    return (status);
+
+    return (handle_positional(cargs, options, arg, state->_positional_index++));
+}
+
+int parse_complete(cargs_t *cargs)
+{
+    int status = load_env_vars(cargs);
+    if (status != CARGS_SUCCESS)
+        return (status);
+
+    status = post_parse_validation(cargs);
+    if (status != CARGS_SUCCESS)
+        return (status);
+
+    pack_values(cargs);
+    bind_values(cargs);
+    return (CARGS_SUCCESS);
 }
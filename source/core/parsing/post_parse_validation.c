@@ -2,38 +2,49 @@
 #include <string.h>
 
 #include "cargs/errors.h"
+#include "cargs/internal/compiler.h"
 #include "cargs/internal/context.h"
+#include "cargs/internal/levels.h"
 #include "cargs/internal/utils.h"
 #include "cargs/types.h"
 
+static int report_invalid_choice(cargs_t *cargs, cargs_option_t *option, cargs_value_t value)
+{
+    cargs_valtype_t type = choice_type(option->value_type);
+
+    fprintf(stderr, "%s: The '%s' option cannot be set to '", cargs->program_name, option->name);
+    print_value(stderr, type, value);
+    fprintf(stderr, "'. Please choose from ");
+    print_value_array(stderr, type, option->choices.as_ptr, option->choices_count);
+    fprintf(stderr, "\n");
+    return (CARGS_ERROR_INVALID_CHOICE);
+}
+
 static int validate_choices(cargs_t *cargs, cargs_option_t *option)
 {
-    if (option->choices_count > 0) {
-        bool valid_choices = false;
-        for (size_t i = 0; i < option->choices_count && !valid_choices; ++i) {
-            cargs_value_t choice =
-                choices_to_value(option->value_type, option->choices, option->choices_count, i);
-            valid_choices = (cmp_value(option->value_type, option->value, choice) == 0);
-        }
-        if (!valid_choices) {
-            fprintf(stderr, "%s: The '%s' option cannot be set to '", cargs->program_name,
-                    option->name);
-            print_value(stderr, option->value_type, option->value);
-            fprintf(stderr, "'. Please choose from ");
-            print_value_array(stderr, option->value_type, option->choices.as_ptr,
-                              option->choices_count);
-            fprintf(stderr, "\n");
-            return (CARGS_ERROR_INVALID_CHOICE);
+    if (option->choices_count == 0)
+        return (CARGS_SUCCESS);
+
+    // Every element of an array option must be one of the choices
+    if (option->value_type & VALUE_TYPE_ARRAY) {
+        for (size_t i = 0; i < option->value_count; ++i) {
+            if (!choices_contain(cargs, option, option->value.as_array[i]))
+                return report_invalid_choice(cargs, option, option->value.as_array[i]);
         }
+        return (CARGS_SUCCESS);
     }
+
+    if (!choices_contain(cargs, option, option->value))
+        return report_invalid_choice(cargs, option, option->value);
     return (CARGS_SUCCESS);
 }
 
-static int validate_required(cargs_t *cargs, cargs_option_t *options, cargs_option_t *option)
+static int validate_required(cargs_t *cargs, const cargs_level_t *level, cargs_option_t *options,
+                             cargs_option_t *option)
 {
-    if (option->requires) {
+    if (option->requires && !level_requires_met(level, option - options)) {
         for (int j = 0; option->requires[j] != NULL; ++j) {
-            cargs_option_t *required = find_option_by_name(options, option->requires[j]);
+            cargs_option_t *required = level_find_option(cargs, options, option->requires[j]);
             if (required && !required->is_set) {
                 CARGS_REPORT_ERROR(cargs, CARGS_ERROR_MISSING_REQUIRED,
                                    "Required option is missing: '%s' with option '%s'",
@@ -44,11 +55,12 @@ static int validate_required(cargs_t *cargs, cargs_option_t *options, cargs_opti
     return (CARGS_SUCCESS);
 }
 
-static int validate_conflicts(cargs_t *cargs, cargs_option_t *options, cargs_option_t *option)
+static int validate_conflicts(cargs_t *cargs, const cargs_level_t *level, cargs_option_t *options,
+                              cargs_option_t *option)
 {
-    if (option->conflicts) {
+    if (option->conflicts && !level_conflicts_free(level, option - options)) {
         for (int j = 0; option->conflicts[j] != NULL; ++j) {
-            cargs_option_t *conflict = find_option_by_name(options, option->conflicts[j]);
+            cargs_option_t *conflict = level_find_option(cargs, options, option->conflicts[j]);
             if (conflict && conflict->is_set) {
                 CARGS_REPORT_ERROR(cargs, CARGS_ERROR_CONFLICTING_OPTIONS,
                                    "Conflict between '%s' and '%s'", option->name, conflict->name);
@@ -71,7 +83,27 @@ static int call_validators(cargs_t *cargs, cargs_option_t *option)
     return (CARGS_SUCCESS);
 }
 
-static int validate_options_set(cargs_t *cargs, cargs_option_t *options)
+static int validate_set_option(cargs_t *cargs, const cargs_level_t *level,
+                               cargs_option_t *options, cargs_option_t *option)
+{
+    int status;
+
+    status = call_validators(cargs, option);
+    if (status != CARGS_SUCCESS)
+        return (status);
+
+    status = validate_choices(cargs, option);
+    if (status != CARGS_SUCCESS)
+        return (status);
+
+    status = validate_required(cargs, level, options, option);
+    if (status != CARGS_SUCCESS)
+        return (status);
+
+    return validate_conflicts(cargs, level, options, option);
+}
+
+static int validate_all_options(cargs_t *cargs, cargs_option_t *options)
 {
     bool        current_group_is_exclusive = false;
     const char *first_set_option_name      = NULL;
@@ -92,8 +124,6 @@ static int validate_options_set(cargs_t *cargs, cargs_option_t *options)
         }
 
         if (option->is_set) {
-            int status;
-
             if (current_group_is_exclusive) {
                 if (first_set_option_name == NULL) {
                     first_set_option_name = option->name;
@@ -104,19 +134,57 @@ static int validate_options_set(cargs_t *cargs, cargs_option_t *options)
                 }
             }
 
-            status = call_validators(cargs, option);
+            int status = validate_set_option(cargs, NULL, options, option);
             if (status != CARGS_SUCCESS)
                 return (status);
+        }
+    }
+    return (CARGS_SUCCESS);
+}
 
-            status = validate_choices(cargs, option);
-            if (status != CARGS_SUCCESS)
-                return (status);
+/*
+ * Same checks as validate_all_options, in the same order, but only visiting
+ * the set options and the required positionals of the level.
+ */
+static int validate_tracked_options(cargs_t *cargs, cargs_level_t *level)
+{
+    uint32_t    group                 = CARGS_NO_INDEX;
+    const char *first_set_option_name = NULL;
+
+    for (size_t w = 0; w < level->words; ++w) {
+        uint64_t bits = level->set_bits[w] | level->required_bits[w];
+
+        while (bits != 0) {
+            size_t          index  = w * 64 + CARGS_CTZ64(bits);
+            cargs_option_t *option = &level->options[index];
+            bits &= bits - 1;
+
+            if (level->group_of[index] != group) {
+                group                 = level->group_of[index];
+                first_set_option_name = NULL;
+                if (group != CARGS_NO_INDEX)
+                    context_set_group(cargs, &level->options[group]);
+            }
 
-            status = validate_required(cargs, options, option);
-            if (status != CARGS_SUCCESS)
-                return (status);
+            if (option->type == TYPE_POSITIONAL && (option->flags & FLAG_REQUIRED) &&
+                !option->is_set) {
+                CARGS_REPORT_ERROR(cargs, CARGS_ERROR_MISSING_REQUIRED,
+                                   "Required positional argument missing: '%s'", option->name);
+            }
+            if (!option->is_set)
+                continue;
+
+            if (group != CARGS_NO_INDEX && (level->options[group].flags & FLAG_EXCLUSIVE)) {
+                if (first_set_option_name == NULL) {
+                    first_set_option_name = option->name;
+                } else {
+                    CARGS_REPORT_ERROR(cargs, CARGS_ERROR_EXCLUSIVE_GROUP,
+                                       "Exclusive options group '%s' conflict: '%s' and '%s'",
+                                       cargs->context.group, first_set_option_name, option->name);
+                }
+            }
 
-            status = validate_conflicts(cargs, options, option);
+            int status = validate_set_option(cargs, level, level->options, option);
             if (status != CARGS_SUCCESS)
                 return (status);
         }
@@ -124,6 +192,15 @@ static int validate_options_set(cargs_t *cargs, cargs_option_t *options)
     return (CARGS_SUCCESS);
 }
 
+static int validate_options_set(cargs_t *cargs, cargs_option_t *options)
+{
+    cargs_level_t *level = level_find(cargs, options);
+
+    if (level_tracks_set(level))
+        return validate_tracked_options(cargs, level);
+    return validate_all_options(cargs, options);
+}
+
 int post_parse_validation(cargs_t *cargs)
 {
     int status;
@@ -0,0 +1,237 @@
+/**
+ * tokens.c - Command-line tokens from argv and response files
+ *
+ * MIT License - Copyright (c) 2024 lucocozz
+ */
+
+#include <fcntl.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "cargs/errors.h"
+#include "cargs/internal/tokens.h"
+#include "cargs/types.h"
+
+static bool is_separator(char c)
+{
+    return (c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\v' || c == '\f' ||
+            c == '\0');
+}
+
+int tokens_split(char **cursor, char *end, char **token, size_t *length)
+{
+    char *read = *cursor;
+
+    while (read < end && is_separator(*read))
+        ++read;
+    *token  = NULL;
+    *length = 0;
+    if (read == end) {
+        *cursor = end;
+        return (CARGS_SUCCESS);
+    }
+
+    char *write = read;
+    char  quote = '\0';
+    *token      = read;
+    while (read < end && (quote != '\0' || !is_separator(*read))) {
+        char c = *read++;
+
+        if (quote == '\'') {
+            if (c != '\'')
+                *write++ = c;
+            else
+                quote = '\0';
+        } else if (c == '\\' && read < end &&
+                   (quote == '\0' || (*read != '\0' && strchr("\"\\$`\n", *read)))) {
+            // An escaped newline joins two lines
+            if (*read != '\n')
+                *write++ = *read;
+            ++read;
+        } else if (c == '"' && quote == '"')
+            quote = '\0';
+        else if ((c == '"' || c == '\'') && quote == '\0')
+            quote = c;
+        else
+            *write++ = c;
+    }
+    if (quote != '\0')
+        return (CARGS_ERROR_INVALID_FORMAT);
+
+    *length = (size_t)(write - *token);
+    if (write < end)
+        *write = '\0';
+    // The separator may have just been replaced by the terminator
+    *cursor = read < end ? read + 1 : end;
+    return (CARGS_SUCCESS);
+}
+
+void tokens_init(cargs_tokens_t *tokens, int argc, char **argv)
+{
+    tokens->argv          = argv;
+    tokens->argc          = argc;
+    tokens->index         = -1;
+    tokens->text          = NULL;
+    tokens->text_end      = NULL;
+    tokens->responses     = false;
+    tokens->depth         = 0;
+    tokens->more          = false;
+    tokens->pending       = NULL;
+    tokens->pending_short = false;
+}
+
+void tokens_init_text(cargs_tokens_t *tokens, char *text, size_t length)
+{
+    tokens_init(tokens, 0, NULL);
+    tokens->text      = text;
+    tokens->text_end  = text + length;
+    tokens->responses = false;
+}
+
+static int text_token(cargs_t *cargs, cargs_tokens_t *tokens, char **token)
+{
+    size_t length;
+
+    if (tokens_split(&tokens->text, tokens->text_end, token, &length) != CARGS_SUCCESS)
+        CARGS_REPORT_ERROR(cargs, CARGS_ERROR_INVALID_FORMAT, "Unterminated quote in command");
+    // The byte after the command is there for the terminator of the last token
+    if (*token != NULL && *token + length == tokens->text_end)
+        *tokens->text_end = '\0';
+    return (CARGS_SUCCESS);
+}
+
+static int response_token(cargs_t *cargs, cargs_tokens_t *tokens, char **token)
+{
+    cargs_response_t *file   = tokens->files[tokens->depth - 1].file;
+    char            **cursor = &tokens->files[tokens->depth - 1].cursor;
+    char             *end    = file->data + file->size;
+    size_t            length;
+
+    if (file->size == 0) {
+        *token = NULL;
+        return (CARGS_SUCCESS);
+    }
+    if (tokens_split(cursor, end, token, &length) != CARGS_SUCCESS) {
+        CARGS_REPORT_ERROR(cargs, CARGS_ERROR_INVALID_FORMAT, "Unterminated quote in '%s'",
+                           tokens->files[tokens->depth - 1].path);
+    }
+
+    // The last token of a file can end on its last byte
+    if (*token != NULL && *token + length == end) {
+        file->last = malloc(length + 1);
+        if (file->last == NULL)
+            CARGS_REPORT_ERROR(cargs, CARGS_ERROR_MEMORY, "Failed to read '%s'",
+                               tokens->files[tokens->depth - 1].path);
+        memcpy(file->last, *token, length);
+        file->last[length] = '\0';
+        *token             = file->last;
+    }
+    return (CARGS_SUCCESS);
+}
+
+int tokens_next(cargs_t *cargs, cargs_tokens_t *tokens, char **token)
+{
+    while (tokens->depth > 0) {
+        int status = response_token(cargs, tokens, token);
+        if (status != CARGS_SUCCESS || *token != NULL)
+            return (status);
+        // The mapping stays until the values pointing into it are released
+        tokens->depth--;
+    }
+
+    if (tokens->text != NULL)
+        return (text_token(cargs, tokens, token));
+    if (tokens->index + 1 >= tokens->argc) {
+        *token = NULL;
+        return (CARGS_SUCCESS);
+    }
+    *token = tokens->argv[++tokens->index];
+    return (CARGS_SUCCESS);
+}
+
+/* Sets opened to false unless path is a regular file, the argument is then kept */
+static int response_open(cargs_t *cargs, cargs_tokens_t *tokens, const char *path, bool *opened)
+{
+    struct stat st;
+    int         fd = open(path, O_RDONLY);
+
+    *opened = false;
+    if (fd < 0)
+        return (CARGS_SUCCESS);
+    if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode)) {
+        close(fd);
+        return (CARGS_SUCCESS);
+    }
+    *opened = true;
+    if (tokens->depth == CARGS_MAX_RESPONSE_DEPTH) {
+        close(fd);
+        CARGS_REPORT_ERROR(cargs, CARGS_ERROR_INVALID_ARGUMENT,
+                           "Response files nested more than %d levels deep: '%s'",
+                           CARGS_MAX_RESPONSE_DEPTH, path);
+    }
+
+    cargs_response_t *file = calloc(1, sizeof(*file));
+    if (file == NULL) {
+        close(fd);
+        CARGS_REPORT_ERROR(cargs, CARGS_ERROR_MEMORY, "Failed to read '%s'", path);
+    }
+    file->size = (size_t)st.st_size;
+    if (file->size > 0) {
+        // Private writable pages: tokens are terminated in place, the file is not modified
+        file->data = mmap(NULL, file->size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+        if (file->data == MAP_FAILED) {
+            close(fd);
+            free(file);
+            CARGS_REPORT_ERROR(cargs, CARGS_ERROR_INVALID_ARGUMENT,
+                               "Cannot map response file '%s'", path);
+        }
+    }
+    close(fd);
+
+    file->next       = cargs->responses;
+    cargs->responses = file;
+    tokens->files[tokens->depth].file   = file;
+    tokens->files[tokens->depth].path   = path;
+    tokens->files[tokens->depth].cursor = file->data;
+    tokens->depth++;
+    return (CARGS_SUCCESS);
+}
+
+int tokens_next_arg(cargs_t *cargs, cargs_tokens_t *tokens, char **token)
+{
+    for (;;) {
+        int status = tokens_next(cargs, tokens, token);
+        if (status != CARGS_SUCCESS || *token == NULL)
+            return (status);
+        if (!tokens->responses || (*token)[0] != '@' || (*token)[1] == '\0')
+            return (CARGS_SUCCESS);
+        if ((*token)[1] == '@') {
+            ++*token;  // "@@" escapes a leading '@', as for values files
+            return (CARGS_SUCCESS);
+        }
+
+        bool opened;
+        status = response_open(cargs, tokens, *token + 1, &opened);
+        if (status != CARGS_SUCCESS || !opened)
+            return (status);
+    }
+}
+
+void responses_free(cargs_t *cargs)
+{
+    cargs_response_t *file = cargs->responses;
+
+    while (file != NULL) {
+        cargs_response_t *next = file->next;
+        if (file->size > 0)
+            munmap(file->data, file->size);
+        free(file->last);
+        free(file);
+        file = next;
+    }
+    cargs->responses = NULL;
+}
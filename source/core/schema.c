@@ -0,0 +1,454 @@
+/**
+ * schema.c - Serialized level indexes
+ *
+ * Writes the read-only tables of every level of an options tree into a
+ * single relocatable blob, and reads them back in place.
+ *
+ * MIT License - Copyright (c) 2024 lucocozz
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "cargs/errors.h"
+#include "cargs/internal/levels.h"
+#include "cargs/internal/schema.h"
+#include "cargs/types.h"
+
+#define HASH_SEED       0x6a09e667f3bcc909ull
+#define HASH_MULTIPLIER 0x9e3779b97f4a7c15ull
+
+/* Tables are aligned so that 64-bit words can be read in place */
+#define SCHEMA_ALIGN(size) (((size) + 7) & ~(size_t)7)
+
+static uint64_t hash_word(uint64_t hash, uint64_t word)
+{
+    hash = (hash ^ word) * HASH_MULTIPLIER;
+    return (hash ^ (hash >> 29));
+}
+
+/* Hash 8 bytes at a time, the fingerprint being computed at every startup */
+static uint64_t hash_bytes(uint64_t hash, const void *data, size_t size)
+{
+    const unsigned char *bytes = data;
+    uint64_t             word;
+
+    for (; size >= sizeof(word); size -= sizeof(word), bytes += sizeof(word)) {
+        memcpy(&word, bytes, sizeof(word));
+        hash = hash_word(hash, word);
+    }
+    word = 0;
+    memcpy(&word, bytes, size);
+    return hash_word(hash, word ^ ((uint64_t)size << 56));
+}
+
+static uint64_t hash_string(uint64_t hash, const char *str)
+{
+    if (str == NULL)
+        return hash_bytes(hash, "\xff", 1);
+    return hash_bytes(hash, str, strlen(str));
+}
+
+static uint64_t hash_names(uint64_t hash, const char **names)
+{
+    for (size_t i = 0; names != NULL && names[i] != NULL; ++i)
+        hash = hash_string(hash, names[i]);
+    return hash_bytes(hash, "\xfe", 1);
+}
+
+static uint64_t hash_choices(uint64_t hash, const cargs_option_t *option)
+{
+    cargs_valtype_t type = choice_type(option->value_type);
+
+    hash = hash_bytes(hash, &option->choices_count, sizeof(option->choices_count));
+    if (option->choices.as_ptr == NULL)
+        return (hash);
+
+    for (size_t i = 0; i < option->choices_count; ++i) {
+        if (type == VALUE_TYPE_INT)
+            hash = hash_bytes(hash, &option->choices.as_array_int[i], sizeof(long long));
+        else if (type == VALUE_TYPE_FLOAT)
+            hash = hash_bytes(hash, &option->choices.as_array_float[i], sizeof(double));
+        else if (type == VALUE_TYPE_STRING)
+            hash = hash_string(hash, option->choices.as_array_string[i]);
+    }
+    return (hash);
+}
+
+uint64_t schema_fingerprint(const cargs_option_t *options, size_t *count)
+{
+    uint64_t hash = HASH_SEED;
+    size_t   i    = 0;
+
+    for (; options[i].type != TYPE_NONE; ++i) {
+        const cargs_option_t *option    = &options[i];
+        int                   fields[4] = {option->type, option->value_type, option->flags,
+                                           option->sname | (option->sub_options != NULL) << 8};
+
+        hash = hash_bytes(hash, fields, sizeof(fields));
+        hash = hash_string(hash, option->name);
+        if (option->lname == option->name)
+            hash = hash_word(hash, 0);  // Usual case, the name is the long name
+        else
+            hash = hash_string(hash, option->lname);
+        hash = hash_string(hash, option->env_name);
+        hash = hash_names(hash, option->requires);
+        hash = hash_names(hash, option->conflicts);
+        hash = hash_choices(hash, option);
+    }
+    *count = i;
+    return hash_bytes(hash, &i, sizeof(i));
+}
+
+/* ---- Serialization ---- */
+
+typedef struct schema_tree_s
+{
+    cargs_t         cargs;    /* Context owning the levels being serialized */
+    cargs_level_t **levels;   /* Levels in blob order, root first */
+    uint32_t      **subs;     /* Blob level of each subcommand option of each level */
+    size_t          count;    /* Number of levels */
+    size_t          capacity; /* Allocated entries in levels and subs */
+} schema_tree_t;
+
+static uint32_t find_tree_level(const schema_tree_t *tree, const cargs_option_t *options)
+{
+    for (size_t i = 0; i < tree->count; ++i) {
+        if (tree->levels[i]->options == options)
+            return (i);
+    }
+    return (CARGS_NO_INDEX);
+}
+
+/*
+ * Number the levels depth-first. An options array shared by several
+ * subcommands is stored once.
+ */
+static int collect_levels(schema_tree_t *tree, cargs_option_t *options)
+{
+    if (tree->count == tree->capacity) {
+        size_t          capacity = tree->capacity ? tree->capacity * 2 : 8;
+        cargs_level_t **levels   = realloc(tree->levels, capacity * sizeof(*levels));
+        if (levels == NULL)
+            return (CARGS_ERROR_MEMORY);
+        tree->levels = levels;
+        uint32_t **subs = realloc(tree->subs, capacity * sizeof(*subs));
+        if (subs == NULL)
+            return (CARGS_ERROR_MEMORY);
+        tree->subs     = subs;
+        tree->capacity = capacity;
+    }
+
+    cargs_level_t *level = level_get(&tree->cargs, options);
+    if (level == NULL || level->required_bits == NULL || level->by_name == NULL)
+        return (CARGS_ERROR_MEMORY);
+
+    size_t number = tree->count++;
+    tree->levels[number] = level;
+    tree->subs[number]   = malloc((level->count > 0 ? level->count : 1) * sizeof(uint32_t));
+    if (tree->subs[number] == NULL)
+        return (CARGS_ERROR_MEMORY);
+
+    for (size_t i = 0; i < level->count; ++i) {
+        cargs_option_t *option = &options[i];
+
+        tree->subs[number][i] = CARGS_NO_INDEX;
+        if (option->type != TYPE_SUBCOMMAND || option->sub_options == NULL)
+            continue;
+
+        uint32_t sub = find_tree_level(tree, option->sub_options);
+        if (sub == CARGS_NO_INDEX) {
+            sub        = tree->count;
+            int status = collect_levels(tree, option->sub_options);
+            if (status != CARGS_SUCCESS)
+                return (status);
+        }
+        tree->subs[number][i] = sub;
+    }
+    return (CARGS_SUCCESS);
+}
+
+static size_t count_choices(const cargs_level_t *level)
+{
+    size_t total = 0;
+
+    for (size_t i = 0; level->choice_offset != NULL && i < level->count; ++i) {
+        if (level->choice_offset[i] != CARGS_NO_INDEX)
+            total += level->options[i].choices_count;
+    }
+    return (total);
+}
+
+static size_t count_slots(const cargs_level_t *level)
+{
+    size_t slots = 0;
+
+    for (size_t i = 0; level->dep_slot != NULL && i < level->count; ++i) {
+        if (level->dep_slot[i] != CARGS_NO_INDEX)
+            slots++;
+    }
+    return (slots);
+}
+
+/*
+ * Reserve room for a table and return its offset. Tables always get at
+ * least one element so that an empty table is not mistaken for a missing one.
+ */
+static uint32_t place_table(size_t *cursor, const void *table, size_t elements, size_t size)
+{
+    if (table == NULL)
+        return (0);
+
+    uint32_t offset = *cursor;
+    *cursor += SCHEMA_ALIGN((elements > 0 ? elements : 1) * size);
+    return (offset);
+}
+
+static void copy_table(unsigned char *blob, uint32_t offset, const void *table, size_t elements,
+                       size_t size)
+{
+    if (offset != 0 && elements > 0)
+        memcpy(blob + offset, table, elements * size);
+}
+
+static void describe_level(const schema_tree_t *tree, size_t number, cargs_schema_level_t *entry,
+                           size_t *cursor)
+{
+    const cargs_level_t *level = tree->levels[number];
+    size_t               count = 0;
+
+    *entry = (cargs_schema_level_t){
+        .fingerprint  = schema_fingerprint(level->options, &count),
+        .count        = level->count,
+        .named        = level->named,
+        .words        = level->words,
+        .env_count    = level->env_count,
+        .choice_total = count_choices(level),
+        .slots        = count_slots(level),
+    };
+
+    entry->choice_offset = place_table(cursor, level->choice_offset, level->count, 4);
+    entry->choice_order  = place_table(cursor, level->choice_order, entry->choice_total, 4);
+    entry->by_name       = place_table(cursor, level->by_name, level->named, 4);
+    entry->dep_slot      = place_table(cursor, level->dep_slot, level->count, 4);
+    entry->requires      = place_table(cursor, level->requires, entry->slots * level->words, 8);
+    entry->conflicts     = place_table(cursor, level->conflicts, entry->slots * level->words, 8);
+    entry->required_bits = place_table(cursor, level->required_bits, level->words, 8);
+    entry->group_of      = place_table(cursor, level->group_of, level->count, 4);
+    entry->env_options   = place_table(cursor, level->env_options, level->env_count, 4);
+    entry->sub_levels    = place_table(cursor, tree->subs[number], level->count, 4);
+}
+
+static void write_level(const schema_tree_t *tree, size_t number,
+                        const cargs_schema_level_t *entry, unsigned char *blob)
+{
+    const cargs_level_t *level = tree->levels[number];
+
+    copy_table(blob, entry->choice_offset, level->choice_offset, level->count, 4);
+    copy_table(blob, entry->choice_order, level->choice_order, entry->choice_total, 4);
+    copy_table(blob, entry->by_name, level->by_name, level->named, 4);
+    copy_table(blob, entry->dep_slot, level->dep_slot, level->count, 4);
+    copy_table(blob, entry->requires, level->requires, entry->slots * level->words, 8);
+    copy_table(blob, entry->conflicts, level->conflicts, entry->slots * level->words, 8);
+    copy_table(blob, entry->required_bits, level->required_bits, level->words, 8);
+    copy_table(blob, entry->group_of, level->group_of, level->count, 4);
+    copy_table(blob, entry->env_options, level->env_options, level->env_count, 4);
+    copy_table(blob, entry->sub_levels, tree->subs[number], level->count, 4);
+}
+
+static void free_tree(schema_tree_t *tree)
+{
+    for (size_t i = 0; i < tree->count; ++i)
+        free(tree->subs[i]);
+    free(tree->subs);
+    free(tree->levels);
+    levels_free(&tree->cargs);
+}
+
+int schema_serialize(cargs_option_t *options, void **blob, size_t *size)
+{
+    schema_tree_t tree   = {0};
+    int           status = collect_levels(&tree, options);
+
+    if (status != CARGS_SUCCESS) {
+        free_tree(&tree);
+        return (status);
+    }
+
+    cargs_schema_level_t *entries = calloc(tree.count, sizeof(*entries));
+    if (entries == NULL) {
+        free_tree(&tree);
+        return (CARGS_ERROR_MEMORY);
+    }
+
+    size_t cursor =
+        SCHEMA_ALIGN(sizeof(cargs_schema_header_t) + tree.count * sizeof(cargs_schema_level_t));
+    uint64_t fingerprint = HASH_SEED;
+    for (size_t i = 0; i < tree.count; ++i) {
+        describe_level(&tree, i, &entries[i], &cursor);
+        fingerprint = hash_bytes(fingerprint, &entries[i].fingerprint, sizeof(uint64_t));
+    }
+
+    unsigned char *data = cursor <= UINT32_MAX ? calloc(1, cursor) : NULL;
+    if (data == NULL) {
+        free(entries);
+        free_tree(&tree);
+        return (CARGS_ERROR_MEMORY);
+    }
+
+    cargs_schema_header_t header = {
+        .magic       = CARGS_SCHEMA_MAGIC,
+        .version     = CARGS_SCHEMA_VERSION,
+        .byte_order  = CARGS_SCHEMA_ORDER,
+        .level_count = tree.count,
+        .fingerprint = fingerprint,
+        .size        = cursor,
+    };
+    memcpy(data, &header, sizeof(header));
+    memcpy(data + sizeof(header), entries, tree.count * sizeof(*entries));
+    for (size_t i = 0; i < tree.count; ++i)
+        write_level(&tree, i, &entries[i], data);
+
+    free(entries);
+    free_tree(&tree);
+    *blob = data;
+    *size = cursor;
+    return (CARGS_SUCCESS);
+}
+
+/* ---- Loading ---- */
+
+static const cargs_schema_header_t *schema_header(const cargs_t *cargs)
+{
+    const cargs_schema_header_t *header = cargs->schema;
+
+    if (header == NULL || ((uintptr_t)header & 7) != 0 || cargs->schema_size < sizeof(*header))
+        return (NULL);
+    if (header->magic != CARGS_SCHEMA_MAGIC || header->version != CARGS_SCHEMA_VERSION ||
+        header->byte_order != CARGS_SCHEMA_ORDER || header->size > cargs->schema_size)
+        return (NULL);
+    if (header->level_count > (header->size - sizeof(*header)) / sizeof(cargs_schema_level_t))
+        return (NULL);
+    return (header);
+}
+
+/* Resolve a table of the blob, NULL if it is missing or out of bounds */
+static const void *schema_table(const cargs_schema_header_t *header, uint32_t offset,
+                                size_t elements, size_t size)
+{
+    size_t bytes = (elements > 0 ? elements : 1) * size;
+
+    if (offset == 0 || (offset & 7) != 0 || offset > header->size ||
+        bytes > header->size - offset)
+        return (NULL);
+    return ((const unsigned char *)header + offset);
+}
+
+/* Check that every index of a table is below a bound, or CARGS_NO_INDEX if allowed */
+static bool indexes_below(const uint32_t *table, size_t elements, size_t bound, bool optional)
+{
+    for (size_t i = 0; i < elements; ++i) {
+        if (table[i] >= bound && !(optional && table[i] == CARGS_NO_INDEX))
+            return (false);
+    }
+    return (true);
+}
+
+static bool choices_valid(const cargs_level_t *level, size_t total)
+{
+    for (size_t i = 0; i < level->count; ++i) {
+        uint32_t offset  = level->choice_offset[i];
+        size_t   choices = level->options[i].choices_count;
+
+        if (offset == CARGS_NO_INDEX)
+            continue;
+        if (offset > total || choices > total - offset ||
+            !indexes_below(level->choice_order + offset, choices, choices, false))
+            return (false);
+    }
+    return (true);
+}
+
+/*
+ * The fingerprint only covers the options, so the index values read from the
+ * blob are checked before the tables are trusted as array subscripts.
+ */
+static bool level_tables_valid(const cargs_level_t *level, const cargs_schema_level_t *entry,
+                               uint32_t level_count)
+{
+    size_t count = level->count;
+
+    if (level->named > count || level->env_count > count || entry->slots > count)
+        return (false);
+    if (count % 64 != 0 && level->words > 0 &&
+        (level->required_bits[level->words - 1] >> (count % 64)) != 0)
+        return (false);
+    if (!indexes_below(level->by_name, level->named, count, false) ||
+        !indexes_below(level->env_options, level->env_count, count, false) ||
+        !indexes_below(level->group_of, count, count, true) ||
+        !indexes_below(level->sub_levels, count, level_count, true))
+        return (false);
+    if (level->dep_slot != NULL && !indexes_below(level->dep_slot, count, entry->slots, true))
+        return (false);
+    return (level->choice_offset == NULL || choices_valid(level, entry->choice_total));
+}
+
+cargs_level_t *schema_load_level(cargs_t *cargs, cargs_option_t *options, uint32_t number)
+{
+    const cargs_schema_header_t *header = schema_header(cargs);
+    size_t                       count  = 0;
+
+    if (header == NULL || options == NULL || number >= header->level_count)
+        return (NULL);
+
+    const cargs_schema_level_t *entry = (const cargs_schema_level_t *)(header + 1) + number;
+    if (schema_fingerprint(options, &count) != entry->fingerprint || count != entry->count ||
+        entry->words != (count + 63) / 64)
+        return (NULL);
+
+    cargs_level_t *level = calloc(1, sizeof(*level));
+    if (level == NULL)
+        return (NULL);
+
+    // The tables are only read, the casts drop the const of the mapping
+    *level = (cargs_level_t){
+        .options     = options,
+        .count       = count,
+        .from_schema = true,
+        .named       = entry->named,
+        .words       = entry->words,
+        .env_count   = entry->env_count,
+        .by_name     = (uint32_t *)schema_table(header, entry->by_name, entry->named, 4),
+        .required_bits =
+            (uint64_t *)schema_table(header, entry->required_bits, entry->words, 8),
+        .group_of    = (uint32_t *)schema_table(header, entry->group_of, count, 4),
+        .env_options = (uint32_t *)schema_table(header, entry->env_options, entry->env_count, 4),
+        .sub_levels  = schema_table(header, entry->sub_levels, count, 4),
+    };
+    if (entry->choice_offset != 0) {
+        level->choice_offset = (uint32_t *)schema_table(header, entry->choice_offset, count, 4);
+        level->choice_order =
+            (uint32_t *)schema_table(header, entry->choice_order, entry->choice_total, 4);
+    }
+    if (entry->dep_slot != 0) {
+        size_t bits      = (size_t)entry->slots * entry->words;
+        level->dep_slot  = (uint32_t *)schema_table(header, entry->dep_slot, count, 4);
+        level->requires  = (uint64_t *)schema_table(header, entry->requires, bits, 8);
+        level->conflicts = (uint64_t *)schema_table(header, entry->conflicts, bits, 8);
+    }
+
+    bool broken = level->by_name == NULL || level->required_bits == NULL ||
+                  level->group_of == NULL || level->env_options == NULL ||
+                  level->sub_levels == NULL ||
+                  (entry->choice_offset != 0 &&
+                   (level->choice_offset == NULL || level->choice_order == NULL)) ||
+                  (entry->dep_slot != 0 && (level->dep_slot == NULL || level->requires == NULL ||
+                                            level->conflicts == NULL));
+    if (broken || !level_tables_valid(level, entry, header->level_count)) {
+        free(level);
+        return (NULL);
+    }
+
+    level_link(cargs, level);
+    return (level);
+}
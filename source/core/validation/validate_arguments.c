@@ -1,4 +1,5 @@
 #include "cargs/errors.h"
+#include "cargs/internal/levels.h"
 #include "cargs/internal/utils.h"
 #include "cargs/types.h"
 #include <stddef.h>
@@ -41,13 +42,7 @@ static int validate_default_value(cargs_t *cargs, cargs_option_t *option)
     int status = CARGS_SUCCESS;
 
     if (option->choices_count > 0 && option->have_default) {
-        bool valid_default = false;
-        for (size_t i = 0; i < option->choices_count && !valid_default; ++i) {
-            cargs_value_t choice =
-                choices_to_value(option->value_type, option->choices, option->choices_count, i);
-            valid_default = (cmp_value(option->value_type, option->value, choice) == 0);
-        }
-        if (!valid_default) {
+        if (!choices_contain(cargs, option, option->value)) {
             CARGS_COLLECT_ERROR(cargs, CARGS_ERROR_INVALID_DEFAULT,
                                 "Default value of option '%s' must be one of the available choices",
                                 option->name);
@@ -58,6 +53,27 @@ static int validate_default_value(cargs_t *cargs, cargs_option_t *option)
     return (status);
 }
 
+static int validate_binding(cargs_t *cargs, cargs_option_t *option)
+{
+    if (option->bind_size == 0 || bind_supported(option->value_type, option->bind_size))
+        return (CARGS_SUCCESS);
+
+    CARGS_COLLECT_ERROR(cargs, CARGS_ERROR_MALFORMED_OPTION,
+                        "Option '%s' cannot be bound to a field of %zu bytes", option->name,
+                        option->bind_size);
+    return (CARGS_ERROR_MALFORMED_OPTION);
+}
+
+static int validate_packing(cargs_t *cargs, cargs_option_t *option)
+{
+    if (!(option->flags & FLAG_PACKED) || option->value_type == VALUE_TYPE_ARRAY_INT)
+        return (CARGS_SUCCESS);
+
+    CARGS_COLLECT_ERROR(cargs, CARGS_ERROR_INVALID_FLAG,
+                        "Option '%s' must be an integer array to be packed", option->name);
+    return (CARGS_ERROR_INVALID_FLAG);
+}
+
 static int validate_dependencies(cargs_t *cargs, cargs_option_t *options, cargs_option_t *option)
 {
     int status = CARGS_SUCCESS;
@@ -78,7 +94,7 @@ static int validate_dependencies(cargs_t *cargs, cargs_option_t *options, cargs_
 
     if (option->requires != NULL) {
         for (int i = 0; option->requires[i] != NULL; ++i) {
-            cargs_option_t *required = find_option_by_name(options, option->requires[i]);
+            cargs_option_t *required = level_find_option(cargs, options, option->requires[i]);
             if (required == NULL) {
                 CARGS_COLLECT_ERROR(cargs, CARGS_ERROR_INVALID_DEPENDENCY,
                                     "Required option not found '%s' in option '%s'",
@@ -90,7 +106,7 @@ static int validate_dependencies(cargs_t *cargs, cargs_option_t *options, cargs_
 
     if (option->conflicts != NULL) {
         for (int i = 0; option->conflicts[i] != NULL; ++i) {
-            cargs_option_t *conflict = find_option_by_name(options, option->conflicts[i]);
+            cargs_option_t *conflict = level_find_option(cargs, options, option->conflicts[i]);
             if (conflict == NULL) {
                 CARGS_COLLECT_ERROR(cargs, CARGS_ERROR_INVALID_DEPENDENCY,
                                     "Conflicting option not found '%s' in option '%s'",
@@ -115,6 +131,14 @@ int validate_option(cargs_t *cargs, cargs_option_t *options, cargs_option_t *opt
     if (status != CARGS_SUCCESS)
         return (status);
 
+    status = validate_binding(cargs, option);
+    if (status != CARGS_SUCCESS)
+        return (status);
+
+    status = validate_packing(cargs, option);
+    if (status != CARGS_SUCCESS)
+        return (status);
+
     status = validate_dependencies(cargs, options, option);
     return (status);
 }
@@ -155,13 +179,7 @@ int validate_positional(cargs_t *cargs, cargs_option_t *option)
     }
 
     if (option->choices_count > 0 && option->have_default) {
-        bool valid_default = false;
-        for (size_t i = 0; i < option->choices_count && !valid_default; ++i) {
-            cargs_value_t choice =
-                choices_to_value(option->value_type, option->choices, option->choices_count, i);
-            valid_default = (cmp_value(option->value_type, option->value, choice) == 0);
-        }
-        if (!valid_default) {
+        if (!choices_contain(cargs, option, option->value)) {
             CARGS_COLLECT_ERROR(
                 cargs, CARGS_ERROR_INVALID_DEFAULT,
                 "Default value of positional option '%s' must be one of the available choices",
@@ -170,5 +188,8 @@ int validate_positional(cargs_t *cargs, cargs_option_t *option)
         }
     }
 
+    if (validate_binding(cargs, option) != CARGS_SUCCESS)
+        status = CARGS_ERROR_MALFORMED_OPTION;
+
     return (status);
 }
@@ -1,7 +1,12 @@
 #include "cargs/errors.h"
 #include "cargs/internal/context.h"
+#include "cargs/internal/levels.h"
+#include "cargs/internal/parsing.h"
 #include "cargs/types.h"
 #include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 
 int validate_subcommand(cargs_t *cargs, cargs_option_t *option);
@@ -51,11 +56,167 @@ static int is_unique(cargs_t *cargs, cargs_option_t *option, cargs_option_t *oth
     return (status);
 }
 
+/* Fields linking an option to the next one of the same type sharing it */
+#define LINK_NAME  0
+#define LINK_SNAME 1
+#define LINK_LNAME 2
+#define LINK_COUNT 3
+
+static size_t hash_name(cargs_optype_t type, const char *str)
+{
+    size_t hash = 2166136261u ^ (size_t)type;
+
+    for (; *str; ++str)
+        hash = (hash ^ (unsigned char)*str) * 16777619u;
+    return (hash);
+}
+
+/**
+ * link_duplicate_strings - Chain options sharing a string field within a type
+ *
+ * Open-addressing hash table holding the last option seen for each value.
+ * When a value is found again, the previous option is linked to the new one
+ * and replaces it in the table, so each group of duplicates becomes a chain
+ * in declaration order.
+ *
+ * @return false if the hash table could not be allocated
+ */
+static bool link_duplicate_strings(cargs_option_t *options, size_t count, size_t *next,
+                                   size_t field)
+{
+    size_t size = 16;
+
+    while (size < count * 2)
+        size *= 2;
+
+    cargs_option_t **table = calloc(size, sizeof(*table));
+    if (table == NULL)
+        return (false);
+
+    for (size_t i = 0; i < count; ++i) {
+        const char *value = *(const char **)((char *)&options[i] + field);
+        if (value == NULL)
+            continue;
+
+        size_t slot = hash_name(options[i].type, value) & (size - 1);
+        for (; table[slot] != NULL; slot = (slot + 1) & (size - 1)) {
+            const char *other = *(const char **)((char *)table[slot] + field);
+            if (table[slot]->type == options[i].type && strcmp(other, value) == 0) {
+                next[table[slot] - options] = i;
+                break;
+            }
+        }
+        table[slot] = &options[i];
+    }
+    free(table);
+    return (true);
+}
+
+static void link_duplicate_snames(cargs_option_t *options, size_t count, size_t *next)
+{
+    uint64_t        seen[TYPE_SUBCOMMAND + 1][4] = {0};
+    cargs_option_t *last[TYPE_SUBCOMMAND + 1][256];
+
+    for (size_t i = 0; i < count; ++i) {
+        unsigned char sname = (unsigned char)options[i].sname;
+        size_t        type  = options[i].type;
+
+        if (sname == 0 || type > TYPE_SUBCOMMAND)
+            continue;
+        if (seen[type][sname / 64] & ((uint64_t)1 << (sname % 64)))
+            next[last[type][sname] - options] = i;
+        else
+            seen[type][sname / 64] |= (uint64_t)1 << (sname % 64);
+        last[type][sname] = &options[i];
+    }
+}
+
+/**
+ * find_duplicates - Group options whose names appear more than once
+ *
+ * @return LINK_COUNT arrays of count indexes, the one of field f holding at
+ *         [f * count + i] the next option sharing that field with option i,
+ *         or count if there is none. NULL if they could not be computed, in
+ *         which case every pair of options has to be checked
+ */
+static size_t *find_duplicates(cargs_option_t *options, size_t count)
+{
+    size_t *next = malloc((LINK_COUNT * count + 1) * sizeof(*next));
+    if (next == NULL)
+        return (NULL);
+    for (size_t i = 0; i < LINK_COUNT * count; ++i)
+        next[i] = count;
+
+    if (!link_duplicate_strings(options, count, next + LINK_NAME * count,
+                                offsetof(cargs_option_t, name)) ||
+        !link_duplicate_strings(options, count, next + LINK_LNAME * count,
+                                offsetof(cargs_option_t, lname))) {
+        free(next);
+        return (NULL);
+    }
+    link_duplicate_snames(options, count, next + LINK_SNAME * count);
+    return (next);
+}
+
+/**
+ * check_group - Check an option against the later options sharing a name
+ *
+ * Walks the chains of the three name fields together, in increasing index
+ * order, so each duplicate pair is reported once and in declaration order.
+ */
+static int check_group(cargs_t *cargs, cargs_option_t *options, size_t count, size_t *next,
+                       size_t index)
+{
+    int    status = CARGS_SUCCESS;
+    size_t cursor[LINK_COUNT];
+
+    for (size_t f = 0; f < LINK_COUNT; ++f)
+        cursor[f] = next[f * count + index];
+
+    while (true) {
+        size_t j = count;
+        for (size_t f = 0; f < LINK_COUNT; ++f)
+            if (cursor[f] < j)
+                j = cursor[f];
+        if (j == count)
+            break;
+
+        int result = is_unique(cargs, &options[index], &options[j]);
+        if (result != CARGS_SUCCESS)
+            status = result;
+        for (size_t f = 0; f < LINK_COUNT; ++f)
+            if (cursor[f] == j)
+                cursor[f] = next[f * count + j];
+    }
+    return (status);
+}
+
+/* Fallback of check_group when the groups could not be computed */
+static int check_pairs(cargs_t *cargs, cargs_option_t *options, size_t index)
+{
+    int status = CARGS_SUCCESS;
+
+    for (size_t j = index + 1; options[j].type != TYPE_NONE; ++j) {
+        if (options[index].type != options[j].type)
+            continue;
+
+        int result = is_unique(cargs, &options[index], &options[j]);
+        if (result != CARGS_SUCCESS)
+            status = result;
+    }
+    return (status);
+}
+
 int validate_structure(cargs_t *cargs, cargs_option_t *options)
 {
-    bool have_helper         = false;
-    bool optional_positional = false;
-    int  status              = CARGS_SUCCESS;
+    bool   have_helper         = false;
+    bool   optional_positional = false;
+    int    status              = CARGS_SUCCESS;
+    size_t count               = 0;
+
+    while (options[count].type != TYPE_NONE)
+        ++count;
+    size_t *duplicates = find_duplicates(options, count);
 
     for (int i = 0; options[i].type != TYPE_NONE; ++i) {
         cargs_option_t *option = &options[i];
@@ -65,16 +226,13 @@ int validate_structure(cargs_t *cargs, cargs_option_t *options)
         if (result != CARGS_SUCCESS)
             status = result;
 
-        for (int j = i + 1; options[j].type != TYPE_NONE; ++j) {
-            cargs_option_t *other_option = &options[j];
-
-            if (option->type != other_option->type)
-                continue;
-
-            int result = is_unique(cargs, option, other_option);
-            if (result != CARGS_SUCCESS)
-                status = result;
-        }
+        // Only options of the same duplicate group can fail the uniqueness check
+        if (duplicates != NULL)
+            result = check_group(cargs, options, count, duplicates, (size_t)i);
+        else
+            result = check_pairs(cargs, options, (size_t)i);
+        if (result != CARGS_SUCCESS)
+            status = result;
 
         if (option->type == TYPE_OPTION && strcmp(option->name, "help") == 0)
             have_helper = true;
@@ -90,17 +248,33 @@ int validate_structure(cargs_t *cargs, cargs_option_t *options)
         }
         if (option->type == TYPE_POSITIONAL && (option->flags & FLAG_REQUIRED) == 0)
             optional_positional = true;
-
-        // Validate sub_options recursively
-        if (option->type == TYPE_SUBCOMMAND && option->sub_options != NULL) {
-            context_push_subcommand(cargs, option);
-            validate_structure(cargs, option->sub_options);
-            context_pop_subcommand(cargs);
-        }
     }
+    free(duplicates);
     if (!have_helper) {
         CARGS_COLLECT_ERROR(cargs, CARGS_ERROR_MISSING_HELP, "Missing 'help' option");
         status = CARGS_ERROR_MISSING_HELP;
     }
     return (status);
 }
+
+/**
+ * validate_level - Check the structure of an options array on first use
+ *
+ * The root level is checked by cargs_init and each subcommand level when
+ * parsing first enters it, so only the paths actually used pay for it. The
+ * result is kept in the level, which is built here in every mode.
+ */
+int validate_level(cargs_t *cargs, cargs_option_t *options)
+{
+    // Release mode skips the checks, not the lookup indexes
+    cargs_level_t *level = level_get(cargs, options);
+    if (cargs->release_mode || (level != NULL && level->validated))
+        return (CARGS_SUCCESS);
+
+    int status = validate_structure(cargs, options);
+    if (status == CARGS_SUCCESS && level != NULL)
+        level->validated = true;
+    context_unset_option(cargs);
+    context_unset_group(cargs);
+    return (status);
+}
@@ -14,6 +14,7 @@
 #include <string.h>
 
 #include "cargs/internal/display.h"
+#include "cargs/internal/levels.h"
 #include "cargs/internal/utils.h"
 #include "cargs/types.h"
 
@@ -231,12 +232,13 @@ static const char *get_collection_format(cargs_valtype_t type)
     return NULL;
 }
 
-// Helper function to format a collection hint
-static char *format_collection_hint(const char *format, const char *type_name)
-{
-    static char buffer[64];  // Buffer for the formatted string
+#define COLLECTION_HINT_MAX 64
 
-    snprintf(buffer, sizeof(buffer), format, type_name);
+// Helper function to format a collection hint into a caller buffer
+static char *format_collection_hint(char buffer[COLLECTION_HINT_MAX], const char *format,
+                                    const char *type_name)
+{
+    snprintf(buffer, COLLECTION_HINT_MAX, format, type_name);
     return buffer;
 }
 
@@ -257,8 +259,10 @@ static void print_value_hint(const cargs_option_t *option)
     const char *collection_format = get_collection_format(option->value_type);
 
     // Print the formatted hint
-    printf(" <%s>",
-           collection_format ? format_collection_hint(collection_format, type_name) : type_name);
+    char buffer[COLLECTION_HINT_MAX];
+    printf(" <%s>", collection_format
+                        ? format_collection_hint(buffer, collection_format, type_name)
+                        : type_name);
 }
 
 static void print_wrapped_text(const char *text, size_t indent, size_t line_width)
@@ -380,7 +384,7 @@ static void print_option_description(const cargs_option_t *option, size_t paddin
             if (i > 0)
                 strncat(choices_buf, ", ", sizeof(choices_buf) - strlen(choices_buf) - 1);
 
-            switch (option->value_type) {
+            switch (choice_type(option->value_type)) {
                 case VALUE_TYPE_INT:
                     snprintf(item, sizeof(item), "%lld", option->choices.as_array_int[i]);
                     break;
@@ -417,8 +421,8 @@ static void print_option_description(const cargs_option_t *option, size_t paddin
 
         switch (option->value_type) {
             case VALUE_TYPE_INT:
-                snprintf(default_buf + default_len, sizeof(default_buf) - default_len, "%d)",
-                         option->default_value.as_int);
+                snprintf(default_buf + default_len, sizeof(default_buf) - default_len, "%lld)",
+                         option->default_value.as_int64);
                 break;
             case VALUE_TYPE_STRING:
                 if (option->default_value.as_string) {
@@ -529,7 +533,8 @@ static size_t print_option_name(const cargs_option_t *option, size_t indent)
         if (collection_format) {
             // Approximate the length for collection format
             // Format is "KEY=%s,..." or "%s,..."
-            const char *format_str = format_collection_hint(collection_format, type_name);
+            char        buffer[COLLECTION_HINT_MAX];
+            const char *format_str = format_collection_hint(buffer, collection_format, type_name);
             name_len += 3 + strlen(format_str);  // " <hint_format>"
         } else {
             name_len += 3 + strlen(type_name);  // " <hint>"
@@ -574,7 +579,7 @@ static void print_positional(const cargs_option_t *option, size_t indent)
     print_option_description(option, padding);
 }
 
-static void print_subcommand(cargs_t *cargs, const cargs_option_t *option, size_t indent)
+static void print_subcommand(const cargs_t *cargs, const cargs_option_t *option, size_t indent)
 {
     UNUSED(cargs);
     size_t name_len = 0;
@@ -618,7 +623,7 @@ static void print_positional_list(option_entry_t *list, size_t indent)
     }
 }
 
-static void print_subcommand_list(cargs_t *cargs, option_entry_t *list, size_t indent)
+static void print_subcommand_list(const cargs_t *cargs, option_entry_t *list, size_t indent)
 {
     option_entry_t *current = list;
     while (current != NULL) {
@@ -637,7 +642,7 @@ static bool has_groups(group_info_t *groups)
     return groups != NULL;
 }
 
-static void print_help_sections(cargs_t *cargs, help_data_t *data)
+static void print_help_sections(const cargs_t *cargs, help_data_t *data)
 {
     // Print positional arguments
     if (has_entries(data->positionals)) {
@@ -680,7 +685,7 @@ static void print_help_sections(cargs_t *cargs, help_data_t *data)
  * Main help display function
  */
 
-void display_help(cargs_t *cargs, const cargs_option_t *command)
+void display_help(const cargs_t *cargs, const cargs_option_t *command)
 {
     if (command == NULL)
         command = get_active_options(cargs);
@@ -20,7 +20,7 @@ static bool have_subcommand(const cargs_option_t *options)
     return (false);
 }
 
-void display_usage(cargs_t *cargs, const cargs_option_t *command)
+void display_usage(const cargs_t *cargs, const cargs_option_t *command)
 {
     UNUSED(command);
     const cargs_option_t *options = get_active_options(cargs);
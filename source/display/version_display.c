@@ -10,7 +10,7 @@
 #include "cargs/types.h"
 #include <stdio.h>
 
-void display_version(cargs_t *cargs)
+void display_version(const cargs_t *cargs)
 {
     printf("%s", cargs->program_name);
 
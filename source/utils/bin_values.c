@@ -0,0 +1,198 @@
+/**
+ * bin_values.c - Numeric arrays read from raw values files
+ *
+ * MIT License - Copyright (c) 2024 lucocozz
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "cargs/errors.h"
+#include "cargs/internal/utils.h"
+#include "cargs/types.h"
+
+static bool host_little_endian(void)
+{
+    const uint16_t probe = 1;
+
+    return (*(const uint8_t *)&probe == 1);
+}
+
+/* Files hold little-endian values, big-endian hosts reverse each one */
+static void swap_values(cargs_value_t *values, size_t count)
+{
+    for (size_t i = 0; i < count; ++i) {
+        uint8_t *bytes = (uint8_t *)&values[i];
+        for (size_t j = 0; j < sizeof(*values) / 2; ++j) {
+            uint8_t byte                     = bytes[j];
+            bytes[j]                         = bytes[sizeof(*values) - 1 - j];
+            bytes[sizeof(*values) - 1 - j] = byte;
+        }
+    }
+}
+
+void unmap_values(cargs_option_t *option)
+{
+    if (option->is_mapped && option->value_capacity > 0)
+        munmap(option->value.as_array, option->value_capacity * sizeof(cargs_value_t));
+    option->value.as_array = NULL;
+    option->value_capacity = 0;
+    option->is_mapped      = false;
+}
+
+bool copy_mapped_values(cargs_option_t *option)
+{
+    size_t         capacity = option->value_count > 0 ? option->value_count : 1;
+    cargs_value_t *values   = malloc(capacity * sizeof(*values));
+
+    if (values == NULL)
+        return (false);
+    memcpy(values, option->value.as_array, option->value_count * sizeof(*values));
+    unmap_values(option);
+    option->value.as_array = values;
+    option->value_capacity = capacity;
+    return (true);
+}
+
+/* Append count values read from fd, the option is not mapped */
+static bool read_values(cargs_option_t *option, int fd, size_t count)
+{
+    size_t needed = option->value_count + count;
+
+    if (needed > option->value_capacity) {
+        void *values = realloc(option->value.as_array, needed * sizeof(cargs_value_t));
+        if (values == NULL)
+            return (false);
+        option->value.as_array = values;
+        option->value_capacity = needed;
+    }
+
+    char  *dest = (char *)&option->value.as_array[option->value_count];
+    size_t size = count * sizeof(cargs_value_t);
+    for (size_t done = 0; done < size;) {
+        ssize_t got = read(fd, dest + done, size - done);
+        if (got < 0 && errno == EINTR)
+            continue;
+        if (got <= 0)
+            return (false);
+        done += (size_t)got;
+    }
+
+    if (!host_little_endian())
+        swap_values(&option->value.as_array[option->value_count], count);
+    option->value_count = needed;
+    return (true);
+}
+
+/*
+ * Private writable mapping: pages are shared with the page cache until the
+ * application writes to them, the file itself is never modified.
+ */
+static bool map_values(cargs_option_t *option, int fd, size_t count)
+{
+    void *values = mmap(NULL, count * sizeof(cargs_value_t), PROT_READ | PROT_WRITE, MAP_PRIVATE,
+                        fd, 0);
+    if (values == MAP_FAILED)
+        return (false);
+
+    free(option->value.as_array);
+    option->value.as_array = values;
+    option->value_count    = count;
+    option->value_capacity = count;
+    option->is_mapped      = true;
+    return (true);
+}
+
+static bool in_order(cargs_valtype_t type, cargs_value_t a, cargs_value_t b, bool strict)
+{
+    if (type == VALUE_TYPE_ARRAY_FLOAT)
+        return (strict ? a.as_float < b.as_float : a.as_float <= b.as_float);
+    return (strict ? a.as_int64 < b.as_int64 : a.as_int64 <= b.as_int64);
+}
+
+/* Whether the flags would leave the values as they are */
+static bool already_ordered(const cargs_option_t *option)
+{
+    bool strict = option->flags & FLAG_UNIQUE;
+
+    if (!(option->flags & FLAG_SORTED))
+        return (!strict);
+    for (size_t i = 1; i < option->value_count; ++i) {
+        if (!in_order(option->value_type, option->value.as_array[i - 1],
+                      option->value.as_array[i], strict))
+            return (false);
+    }
+    return (true);
+}
+
+/*
+ * A mapping the flags would not change is kept: the scan reads the pages,
+ * sorting in place would copy them all. Otherwise the values are copied to
+ * the heap and the flags applied as for any other array, so FLAG_SORTED and
+ * FLAG_UNIQUE give the same result whether the values came from a file or
+ * not.
+ */
+static int finish_values(cargs_t *cargs, cargs_option_t *option, const char *path)
+{
+    if (option->is_mapped) {
+        if (already_ordered(option))
+            return (CARGS_SUCCESS);
+        if (!copy_mapped_values(option))
+            CARGS_REPORT_ERROR(cargs, CARGS_ERROR_MEMORY, "Failed to copy the values of '%s'",
+                               path);
+    }
+    apply_array_flags(option);
+    return (CARGS_SUCCESS);
+}
+
+const char *values_bin_path(const cargs_option_t *option, const char *value)
+{
+    if (!(option->flags & FLAG_VALUES_FILE))
+        return (NULL);
+    return (starts_with(CARGS_BIN_PREFIX, value));
+}
+
+int array_load_bin(cargs_t *cargs, cargs_option_t *option, const char *path)
+{
+    struct stat st;
+    int         fd = open(path, O_RDONLY);
+
+    if (fd < 0)
+        CARGS_REPORT_ERROR(cargs, CARGS_ERROR_INVALID_ARGUMENT, "Cannot open values file '%s'",
+                           path);
+    if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode)) {
+        close(fd);
+        CARGS_REPORT_ERROR(cargs, CARGS_ERROR_INVALID_ARGUMENT, "'%s' is not a regular file",
+                           path);
+    }
+    if (st.st_size % sizeof(cargs_value_t) != 0) {
+        close(fd);
+        CARGS_REPORT_ERROR(cargs, CARGS_ERROR_INVALID_FORMAT,
+                           "Size of '%s' is not a multiple of %zu bytes", path,
+                           sizeof(cargs_value_t));
+    }
+
+    // The first values of an option are mapped, later ones are appended to a copy
+    size_t count = (size_t)st.st_size / sizeof(cargs_value_t);
+    bool   done  = count == 0;
+    option->is_allocated = true;
+    if (!done && option->value_count == 0 && host_little_endian())
+        done = map_values(option, fd, count);
+    if (!done && option->is_mapped && !copy_mapped_values(option)) {
+        close(fd);
+        CARGS_REPORT_ERROR(cargs, CARGS_ERROR_MEMORY, "Failed to copy the values of '%s'", path);
+    }
+    if (!done && !read_values(option, fd, count)) {
+        close(fd);
+        CARGS_REPORT_ERROR(cargs, CARGS_ERROR_INVALID_ARGUMENT, "Cannot read values file '%s'",
+                           path);
+    }
+    close(fd);
+    return (finish_values(cargs, option, path));
+}
@@ -0,0 +1,134 @@
+/**
+ * file_values.c - Array and map elements streamed from a file
+ *
+ * MIT License - Copyright (c) 2024 lucocozz
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "cargs/errors.h"
+#include "cargs/internal/utils.h"
+#include "cargs/types.h"
+
+/* A lone "@" is not a file, like a lone "-" is not an option */
+const char *values_file_path(const cargs_option_t *option, const char *value)
+{
+    if (!(option->flags & FLAG_VALUES_FILE) || value[0] != CARGS_FILE_PREFIX ||
+        value[1] == CARGS_FILE_PREFIX || value[1] == '\0')
+        return (NULL);
+    return (value + 1);
+}
+
+char *values_unescape(const cargs_option_t *option, char *value)
+{
+    if ((option->flags & FLAG_VALUES_FILE) && value[0] == CARGS_FILE_PREFIX &&
+        value[1] == CARGS_FILE_PREFIX)
+        return (value + 1);
+    return (value);
+}
+
+/* Empty elements are skipped, like empty words between commas */
+static int add_element(cargs_t *cargs, cargs_option_t *option, char *element, size_t length,
+                       char delimiter, cargs_handler_t add)
+{
+    if (delimiter == '\n' && length > 0 && element[length - 1] == '\r')
+        element[--length] = '\0';
+    if (length == 0)
+        return (CARGS_SUCCESS);
+    return (add(cargs, option, element));
+}
+
+/*
+ * The file is read in chunks: complete elements are handed over in place,
+ * the incomplete one at the end moves to the front of the buffer. The buffer
+ * only grows for an element longer than a chunk.
+ */
+static int read_elements(cargs_t *cargs, cargs_option_t *option, int fd, const char *name,
+                         char delimiter, cargs_handler_t add)
+{
+    size_t size   = CARGS_FILE_CHUNK_SIZE;
+    size_t used   = 0;
+    char  *buffer = malloc(size + 1);
+    int    status = CARGS_SUCCESS;
+
+    if (buffer == NULL)
+        CARGS_REPORT_ERROR(cargs, CARGS_ERROR_MEMORY, "Failed to read values file '%s'", name);
+
+    while (status == CARGS_SUCCESS) {
+        ssize_t got = read(fd, buffer + used, size - used);
+        if (got < 0 && errno == EINTR)
+            continue;
+        if (got < 0) {
+            free(buffer);
+            CARGS_REPORT_ERROR(cargs, CARGS_ERROR_INVALID_ARGUMENT,
+                               "Cannot read values file '%s'", name);
+        }
+        used += (size_t)got;
+
+        char *start = buffer;
+        char *stop;
+        while (status == CARGS_SUCCESS &&
+               (stop = memchr(start, delimiter, (size_t)(buffer + used - start))) != NULL) {
+            *stop  = '\0';
+            status = add_element(cargs, option, start, (size_t)(stop - start), delimiter, add);
+            start  = stop + 1;
+        }
+
+        size_t pending = (size_t)(buffer + used - start);
+        if (got == 0) {
+            // The last element may have no delimiter
+            start[pending] = '\0';
+            if (status == CARGS_SUCCESS)
+                status = add_element(cargs, option, start, pending, delimiter, add);
+            break;
+        }
+        if (pending == size) {
+            char *grown = realloc(buffer, size * 2 + 1);
+            if (grown == NULL) {
+                free(buffer);
+                CARGS_REPORT_ERROR(cargs, CARGS_ERROR_MEMORY, "Failed to read values file '%s'",
+                                   name);
+            }
+            buffer = grown;
+            size *= 2;
+        } else if (start != buffer)
+            memmove(buffer, start, pending);
+        used = pending;
+    }
+
+    free(buffer);
+    return (status);
+}
+
+int stream_values(cargs_t *cargs, cargs_option_t *option, const char *path, cargs_handler_t add)
+{
+    const char *name      = starts_with(CARGS_NUL_PREFIX, path);
+    char        delimiter = name != NULL ? '\0' : '\n';
+
+    if (name == NULL)
+        name = path;
+
+    bool from_stdin = strcmp(name, "-") == 0;
+    int  fd         = from_stdin ? STDIN_FILENO : open(name, O_RDONLY);
+    if (fd < 0)
+        CARGS_REPORT_ERROR(cargs, CARGS_ERROR_INVALID_ARGUMENT, "Cannot open values file '%s'",
+                           name);
+
+    option->is_allocated = true;
+    int status           = read_elements(cargs, option, fd, name, delimiter, add);
+    if (!from_stdin)
+        close(fd);
+    if (status != CARGS_SUCCESS)
+        return (status);
+
+    // Flags are applied once for the whole file, not after every element
+    if (option->value_type & VALUE_TYPE_MAP)
+        apply_map_flags(option);
+    else
+        apply_array_flags(option);
+    return (CARGS_SUCCESS);
+}
@@ -6,6 +6,8 @@
  * MIT License - Copyright (c) 2024 lucocozz
  */
 
+#include "cargs/internal/callbacks/handlers.h"
+#include "cargs/internal/intern.h"
 #include "cargs/internal/utils.h"
 #include "cargs/types.h"
 #include <math.h>
@@ -21,9 +23,9 @@ static int compare_int_values(const void *a, const void *b)
     const cargs_value_t *va = (const cargs_value_t *)a;
     const cargs_value_t *vb = (const cargs_value_t *)b;
 
-    if (va->as_int < vb->as_int)
+    if (va->as_int64 < vb->as_int64)
         return -1;
-    if (va->as_int > vb->as_int)
+    if (va->as_int64 > vb->as_int64)
         return 1;
     return 0;
 }
@@ -71,9 +73,9 @@ static int compare_map_int_values(const void *a, const void *b)
     const cargs_pair_t *pa = (const cargs_pair_t *)a;
     const cargs_pair_t *pb = (const cargs_pair_t *)b;
 
-    if (pa->value.as_int < pb->value.as_int)
+    if (pa->value.as_int64 < pb->value.as_int64)
         return -1;
-    if (pa->value.as_int > pb->value.as_int)
+    if (pa->value.as_int64 > pb->value.as_int64)
         return 1;
     return 0;
 }
@@ -151,7 +153,7 @@ size_t make_int_array_unique(cargs_value_t *array, size_t count)
         bool is_duplicate = false;
 
         for (size_t j = 0; j < unique_count; j++) {
-            if (array[i].as_int == array[j].as_int) {
+            if (array[i].as_int64 == array[j].as_int64) {
                 is_duplicate = true;
                 break;
             }
@@ -177,9 +179,8 @@ size_t make_string_array_unique(cargs_value_t *array, size_t count)
         for (size_t j = 0; j < unique_count; j++) {
             if (array[i].as_string && array[j].as_string &&
                 strcmp(array[i].as_string, array[j].as_string) == 0) {
+                // The string stays in the chunks of the option
                 is_duplicate = true;
-                // Free duplicate string
-                free(array[i].as_string);
                 break;
             }
         }
@@ -286,7 +287,7 @@ size_t make_map_values_unique(cargs_pair_t *map, size_t count, cargs_valtype_t t
             switch (type) {
                 case VALUE_TYPE_INT:
                 case VALUE_TYPE_MAP_INT:
-                    is_duplicate = (map[i].value.as_int == map[j].value.as_int);
+                    is_duplicate = (map[i].value.as_int64 == map[j].value.as_int64);
                     break;
 
                 case VALUE_TYPE_STRING:
@@ -317,20 +318,13 @@ size_t make_map_values_unique(cargs_pair_t *map, size_t count, cargs_valtype_t t
         }
     }
 
-    // Rebuild the array without duplicates
+    // Rebuild the array without duplicates. Nothing is freed: keys are
+    // interned and string values live in the chunks of the option
     for (size_t i = 0; i < count; i++) {
         if (!duplicates[i]) {
             if (i != unique_count)
                 map[unique_count] = map[i];
             unique_count++;
-        } else {
-            // Free duplicate string keys
-            free((void *)map[i].key);
-
-            // Free string values if applicable
-            if ((type == VALUE_TYPE_STRING || type == VALUE_TYPE_MAP_STRING) &&
-                map[i].value.as_string)
-                free(map[i].value.as_string);
         }
     }
 
@@ -409,11 +403,9 @@ void apply_map_flags(cargs_option_t *option)
             make_map_values_unique(option->value.as_map, option->value_count, option->value_type);
     }
 
-    // Sort by key if needed
-    if (option->flags & FLAG_SORTED_KEY) {
-        sort_map_by_keys(option->value.as_map, option->value_count);
-        // Sort by value if needed (and not already sorted by key)
-    } else if (option->flags & FLAG_SORTED_VALUE) {
+    // Maps sorted by key are kept sorted on insertion, see map_insert_key.
+    // Sort by value if needed (and not already sorted by key)
+    if (!(option->flags & FLAG_SORTED_KEY) && (option->flags & FLAG_SORTED_VALUE)) {
         switch (option->value_type) {
             case VALUE_TYPE_MAP_INT:
                 sort_map_by_int_values(option->value.as_map, option->value_count);
@@ -439,6 +431,10 @@ void apply_map_flags(cargs_option_t *option)
 
 void adjust_array_size(cargs_option_t *option)
 {
+    // A mapped values file cannot grow in place
+    if (option->is_mapped && !copy_mapped_values(option))
+        return;
+
     if (option->value.as_array == NULL) {
         option->value_capacity = MULTI_VALUE_INITIAL_CAPACITY;
         option->value.as_array = malloc(option->value_capacity * sizeof(cargs_value_t));
@@ -469,11 +465,150 @@ void adjust_map_size(cargs_option_t *option)
     }
 }
 
-int map_find_key(cargs_option_t *option, const char *key)
+/*
+ * Only the built-in free handlers are known to release the elements and the
+ * buffer separately, a custom one may own anything.
+ */
+static bool has_builtin_free(const cargs_option_t *option)
+{
+    return (option->free_handler == default_free ||
+            option->free_handler == free_array_string_handler ||
+            option->free_handler == free_map_string_handler ||
+            option->free_handler == free_map_int_handler ||
+            option->free_handler == free_map_float_handler ||
+            option->free_handler == free_map_bool_handler);
+}
+
+/*
+ * Empty a multi-value option but keep its buffer and capacity for the next
+ * parse. Returns false when the value has to be freed instead.
+ */
+bool recycle_option_values(cargs_option_t *option)
+{
+    if (!option->is_allocated || option->have_default || option->is_packed || option->is_mapped ||
+        !has_builtin_free(option))
+        return (false);
+    if (!(option->value_type & (VALUE_TYPE_ARRAY | VALUE_TYPE_MAP)) || option->value.as_ptr == NULL)
+        return (false);
+
+    // String elements go with their chunks, the first one is kept too
+    chunks_clear(&option->strings);
+    option->value_count = 0;
+    option->is_set      = false;
+    return (true);
+}
+
+bool map_keys_interned(const cargs_option_t *option)
+{
+    return (option->free_handler == free_map_string_handler ||
+            option->free_handler == free_map_int_handler ||
+            option->free_handler == free_map_float_handler ||
+            option->free_handler == free_map_bool_handler);
+}
+
+static bool same_key(const char *a, const char *b, bool interned)
+{
+    if (interned)
+        return (a == b);
+    return (a != NULL && strcmp(a, b) == 0);
+}
+
+/*
+ * Maps with FLAG_SORTED_KEY are kept sorted by map_insert_key and searched
+ * by bisection, other maps are scanned. Interned keys are equal only when
+ * they are the same pointer.
+ */
+static bool map_search_key(const cargs_option_t *option, const char *key, bool interned,
+                           size_t *position)
+{
+    const cargs_pair_t *map = option->value.as_map;
+
+    if (!(option->flags & FLAG_SORTED_KEY)) {
+        for (size_t i = 0; i < option->value_count; ++i) {
+            if (same_key(map[i].key, key, interned)) {
+                *position = i;
+                return (true);
+            }
+        }
+        *position = option->value_count;
+        return (false);
+    }
+
+    size_t low  = 0;
+    size_t high = option->value_count;
+    while (low < high) {
+        size_t middle = low + (high - low) / 2;
+        if (interned && map[middle].key == key) {
+            *position = middle;
+            return (true);
+        }
+        if (strcmp(map[middle].key, key) < 0)
+            low = middle + 1;
+        else
+            high = middle;
+    }
+    *position = low;
+    return (low < option->value_count && same_key(map[low].key, key, interned));
+}
+
+int map_find_key(const cargs_option_t *option, const char *key)
+{
+    size_t position;
+
+    if (option->value.as_map == NULL || !map_search_key(option, key, false, &position))
+        return (-1);
+    return ((int)position);
+}
+
+int map_find_interned(const cargs_option_t *option, const char *key)
 {
-    for (size_t i = 0; i < option->value_count; ++i) {
-        if (option->value.as_map[i].key && strcmp(option->value.as_map[i].key, key) == 0)
-            return ((int)i);
+    size_t position;
+
+    if (option->value.as_map == NULL || !map_search_key(option, key, true, &position))
+        return (-1);
+    return ((int)position);
+}
+
+size_t map_insert_key(cargs_option_t *option, const char *key)
+{
+    size_t position = option->value_count;
+
+    adjust_map_size(option);
+    if (option->flags & FLAG_SORTED_KEY) {
+        map_search_key(option, key, true, &position);
+        memmove(&option->value.as_map[position + 1], &option->value.as_map[position],
+                (option->value_count - position) * sizeof(cargs_pair_t));
+    }
+    option->value.as_map[position].key = key;
+    option->value_count++;
+    return (position);
+}
+
+void map_prefix_range(const cargs_option_t *option, const char *prefix, size_t *start,
+                      size_t *end)
+{
+    const cargs_pair_t *map    = option->value.as_map;
+    size_t              length = strlen(prefix);
+    size_t              low    = 0;
+    size_t              high   = option->value_count;
+
+    // Keys starting with the prefix are contiguous in a map sorted by key
+    while (low < high) {
+        size_t middle = low + (high - low) / 2;
+        if (strncmp(map[middle].key, prefix, length) < 0)
+            low = middle + 1;
+        else
+            high = middle;
+    }
+    *start = low;
+
+    high = option->value_count;
+    while (low < high) {
+        size_t middle = low + (high - low) / 2;
+        if (strncmp(map[middle].key, prefix, length) <= 0)
+            low = middle + 1;
+        else
+            high = middle;
     }
-    return (-1);
+    *end = low;
 }
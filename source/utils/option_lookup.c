@@ -2,6 +2,7 @@
 #include <string.h>
 
 #include "cargs/internal/context.h"
+#include "cargs/internal/levels.h"
 #include "cargs/internal/utils.h"
 #include "cargs/types.h"
 
@@ -59,7 +60,7 @@ cargs_option_t *find_option_by_name(cargs_option_t *options, const char *name)
     return (NULL);
 }
 
-const cargs_option_t *get_active_options(cargs_t *cargs)
+const cargs_option_t *get_active_options(const cargs_t *cargs)
 {
     const cargs_option_t *command = context_get_subcommand(cargs);
     if (command != NULL)
@@ -67,18 +68,18 @@ const cargs_option_t *get_active_options(cargs_t *cargs)
     return (cargs->options);
 }
 
-static cargs_option_t *find_from_relative_path(cargs_t cargs, const char *option_name)
+static cargs_option_t *find_from_relative_path(const cargs_t *cargs, const char *option_name)
 {
-    for (int i = cargs.context.subcommand_depth; i >= 0; --i) {
+    for (int i = cargs->context.subcommand_depth; i >= 0; --i) {
         cargs_option_t *options;
 
         if (i == 0) {
-            options = cargs.options;
+            options = cargs->options;
         } else {
-            options = cargs.context.subcommand_stack[i - 1]->sub_options;
+            options = cargs->context.subcommand_stack[i - 1]->sub_options;
         }
 
-        cargs_option_t *option = find_option_by_name(options, option_name);
+        cargs_option_t *option = level_find_option(cargs, options, option_name);
         if (option != NULL)
             return (option);
     }
@@ -96,7 +97,7 @@ static size_t count_components(const char *path)
     return (count);
 }
 
-cargs_option_t *find_option_by_active_path(cargs_t cargs, const char *option_path)
+cargs_option_t *find_option_by_active_path(const cargs_t *cargs, const char *option_path)
 {
     if (option_path == NULL)
         return (NULL);
@@ -107,28 +108,28 @@ cargs_option_t *find_option_by_active_path(cargs_t cargs, const char *option_pat
 
     // Format: ".option_name" (root)
     if (option_path[0] == '.')
-        return (find_option_by_name(cargs.options, option_path + 1));
+        return (level_find_option(cargs, cargs->options, option_path + 1));
 
     size_t component_count = count_components(option_path);
-    if (component_count > cargs.context.subcommand_depth)
+    if (component_count > cargs->context.subcommand_depth)
         return (NULL);
 
     // Format: "subcommand.option_name"
     const char     *component = option_path;
-    cargs_option_t *options   = cargs.options;
+    cargs_option_t *options   = cargs->options;
     for (size_t i = 0; i < component_count; ++i) {
         char *next_dot = strchr(component, '.');
         if (next_dot == NULL)
             break;
 
-        const char *command          = cargs.context.subcommand_stack[i]->name;
+        const char *command          = cargs->context.subcommand_stack[i]->name;
         size_t      component_lenght = next_dot - component;
         if (strncmp(component, command, component_lenght) != 0)
             return (NULL);
 
         component = next_dot + 1;
-        options   = cargs.context.subcommand_stack[i]->sub_options;
+        options   = cargs->context.subcommand_stack[i]->sub_options;
     }
 
-    return (find_option_by_name(options, component));
+    return (level_find_option(cargs, options, component));
 }
@@ -0,0 +1,197 @@
+/**
+ * packed.c - Delta-packed storage of sorted integer arrays
+ *
+ * MIT License - Copyright (c) 2024 lucocozz
+ */
+
+#include <stdlib.h>
+
+#include "cargs/internal/compiler.h"
+#include "cargs/internal/packed.h"
+#include "cargs/types.h"
+
+/* Bytes after the packed gaps so that reads can always load 9 bytes */
+#define PACKED_PADDING 16
+
+static size_t block_length(const cargs_packed_t *packed, size_t block)
+{
+    size_t start = block * CARGS_PACKED_BLOCK;
+
+    return (packed->count - start < CARGS_PACKED_BLOCK ? packed->count - start
+                                                       : CARGS_PACKED_BLOCK);
+}
+
+static const uint8_t *packed_data(const cargs_packed_t *packed)
+{
+    return ((const uint8_t *)&packed->blocks[packed->block_count]);
+}
+
+/* Byte by byte so that it does not depend on alignment nor endianness */
+static inline uint64_t load_le64(const uint8_t *bytes)
+{
+    uint64_t word = 0;
+
+    for (int i = 7; i >= 0; --i)
+        word = (word << 8) | bytes[i];
+    return (word);
+}
+
+static inline uint64_t read_bits(const uint8_t *data, uint64_t offset, unsigned bits)
+{
+    const uint8_t *bytes = data + (offset >> 3);
+    unsigned       shift = offset & 7;
+    uint64_t       word  = load_le64(bytes) >> shift;
+
+    if (shift != 0 && bits > 64 - shift)
+        word |= (uint64_t)bytes[8] << (64 - shift);
+    return (bits == 64 ? word : word & ((UINT64_C(1) << bits) - 1));
+}
+
+static void write_bits(uint8_t *data, uint64_t offset, uint64_t value, unsigned bits)
+{
+    while (bits > 0) {
+        unsigned shift = offset & 7;
+        unsigned take  = 8 - shift < bits ? 8 - shift : bits;
+
+        data[offset >> 3] |= (uint8_t)((value & ((1u << take) - 1)) << shift);
+        value >>= take;
+        offset += take;
+        bits -= take;
+    }
+}
+
+/* Smallest gap and width of the gaps above it, for the block starting at values[0] */
+static void measure_block(const cargs_value_t *values, size_t length, uint64_t *step,
+                          unsigned *bits)
+{
+    uint64_t smallest = UINT64_MAX;
+    uint64_t largest  = 0;
+
+    for (size_t i = 1; i < length; ++i) {
+        uint64_t gap = (uint64_t)values[i].as_int64 - (uint64_t)values[i - 1].as_int64;
+        if (gap < smallest)
+            smallest = gap;
+        if (gap > largest)
+            largest = gap;
+    }
+    *step = length > 1 ? smallest : 0;
+    *bits = (unsigned)CARGS_BIT_WIDTH64(largest - *step);
+}
+
+cargs_packed_t *packed_encode(const cargs_value_t *values, size_t count)
+{
+    size_t   block_count = (count + CARGS_PACKED_BLOCK - 1) / CARGS_PACKED_BLOCK;
+    uint64_t total_bits  = 0;
+
+    for (size_t block = 0; block < block_count; ++block) {
+        size_t   start  = block * CARGS_PACKED_BLOCK;
+        size_t   length = count - start < CARGS_PACKED_BLOCK ? count - start : CARGS_PACKED_BLOCK;
+        uint64_t step;
+        unsigned bits;
+
+        measure_block(&values[start], length, &step, &bits);
+        total_bits += (uint64_t)bits * (length - 1);
+    }
+
+    size_t          size   = sizeof(cargs_packed_t) + block_count * sizeof(cargs_packed_block_t) +
+                  (size_t)((total_bits + 7) / 8) + PACKED_PADDING;
+    cargs_packed_t *packed = calloc(1, size);
+    if (packed == NULL)
+        return (NULL);
+    packed->count       = count;
+    packed->block_count = block_count;
+    packed->size        = size;
+
+    uint8_t *data   = (uint8_t *)&packed->blocks[block_count];
+    uint64_t offset = 0;
+    for (size_t block = 0; block < block_count; ++block) {
+        cargs_packed_block_t *entry  = &packed->blocks[block];
+        size_t                start  = block * CARGS_PACKED_BLOCK;
+        size_t                length = block_length(packed, block);
+        unsigned              bits;
+
+        measure_block(&values[start], length, &entry->step, &bits);
+        entry->first  = values[start].as_int64;
+        entry->bits   = (uint8_t)bits;
+        entry->offset = offset;
+        for (size_t i = 1; bits > 0 && i < length; ++i) {
+            uint64_t gap = (uint64_t)values[start + i].as_int64 -
+                           (uint64_t)values[start + i - 1].as_int64;
+            write_bits(data, offset, gap - entry->step, bits);
+            offset += bits;
+        }
+    }
+    return (packed);
+}
+
+/*
+ * Values position..position+length-1 of a block: the gaps before position
+ * are summed first. Blocks whose gaps are all equal read no bits at all.
+ */
+static void decode_block(const cargs_packed_t *packed, size_t block, size_t position,
+                         long long *out, size_t length)
+{
+    const cargs_packed_block_t *entry = &packed->blocks[block];
+    const uint8_t              *data  = packed_data(packed);
+    uint64_t                    value = (uint64_t)entry->first;
+    uint64_t                    bit   = entry->offset;
+
+    if (entry->bits == 0) {
+        for (size_t i = 0; i < length; ++i)
+            out[i] = (long long)(value + entry->step * (position + i));
+        return;
+    }
+
+    for (size_t i = 0; i < position; ++i, bit += entry->bits)
+        value += entry->step + read_bits(data, bit, entry->bits);
+    out[0] = (long long)value;
+    for (size_t i = 1; i < length; ++i, bit += entry->bits) {
+        value += entry->step + read_bits(data, bit, entry->bits);
+        out[i] = (long long)value;
+    }
+}
+
+long long packed_at(const cargs_packed_t *packed, size_t index)
+{
+    long long value;
+
+    decode_block(packed, index / CARGS_PACKED_BLOCK, index % CARGS_PACKED_BLOCK, &value, 1);
+    return (value);
+}
+
+long long packed_next(const cargs_packed_t *packed, size_t index, long long previous)
+{
+    const cargs_packed_block_t *entry    = &packed->blocks[index / CARGS_PACKED_BLOCK];
+    size_t                      position = index % CARGS_PACKED_BLOCK;
+
+    if (position == 0)
+        return (entry->first);
+
+    uint64_t gap = entry->step;
+    if (entry->bits != 0)
+        gap += read_bits(packed_data(packed), entry->offset + (position - 1) * entry->bits,
+                         entry->bits);
+    return ((long long)((uint64_t)previous + gap));
+}
+
+size_t packed_copy(const cargs_packed_t *packed, size_t start, long long *out, size_t length)
+{
+    if (start >= packed->count)
+        return (0);
+    if (length > packed->count - start)
+        length = packed->count - start;
+
+    size_t done = 0;
+    while (done < length) {
+        size_t index    = start + done;
+        size_t block    = index / CARGS_PACKED_BLOCK;
+        size_t position = index % CARGS_PACKED_BLOCK;
+        size_t chunk    = block_length(packed, block) - position;
+
+        if (chunk > length - done)
+            chunk = length - done;
+        decode_block(packed, block, position, &out[done], chunk);
+        done += chunk;
+    }
+    return (length);
+}
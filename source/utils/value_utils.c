@@ -1,3 +1,4 @@
+#include "cargs/internal/utils.h"
 #include "cargs/types.h"
 
 #include <stdio.h>
@@ -9,6 +10,10 @@ void free_option_value(cargs_option_t *option)
     if (option->is_allocated == false)
         return;
 
+    if (option->is_mapped) {
+        unmap_values(option);
+        return;
+    }
     if (option->free_handler != NULL) {
         option->free_handler(option);
     } else {
@@ -16,17 +21,96 @@ void free_option_value(cargs_option_t *option)
     }
 }
 
-cargs_value_t choices_to_value(cargs_valtype_t type, cargs_value_t choices, int choices_count,
+void reset_option_value(cargs_option_t *option)
+{
+    option->value          = option->have_default ? option->default_value : (cargs_value_t){0};
+    option->is_set         = option->have_default;
+    option->is_allocated   = false;
+    option->is_packed      = false;
+    option->is_mapped      = false;
+    option->value_count    = 0;
+    option->value_capacity = 0;
+    option->strings        = NULL;
+}
+
+bool bind_supported(cargs_valtype_t type, size_t size)
+{
+    switch (type) {
+        case VALUE_TYPE_INT:
+        case VALUE_TYPE_BOOL:
+        case VALUE_TYPE_FLAG:
+            return (size == 1 || size == 2 || size == 4 || size == 8);
+        case VALUE_TYPE_FLOAT:
+            return (size == sizeof(float) || size == sizeof(double));
+        case VALUE_TYPE_STRING:
+            return (size == sizeof(char *));
+        default:
+            return (false);
+    }
+}
+
+/*
+ * Integers and booleans are narrowed to the size of the field, floats are
+ * written as float or double. memcpy keeps unaligned fields safe.
+ */
+void bind_value(void *target, const cargs_option_t *option)
+{
+    unsigned char *field = (unsigned char *)target + option->bind_offset;
+    long long      integer;
+
+    switch (option->value_type) {
+        case VALUE_TYPE_FLOAT:
+            if (option->bind_size == sizeof(float)) {
+                float narrow = (float)option->value.as_float;
+                memcpy(field, &narrow, sizeof(narrow));
+            } else
+                memcpy(field, &option->value.as_float, sizeof(double));
+            return;
+        case VALUE_TYPE_STRING:
+            memcpy(field, &option->value.as_string, sizeof(char *));
+            return;
+        case VALUE_TYPE_BOOL:
+        case VALUE_TYPE_FLAG:
+            integer = option->value.as_bool;
+            break;
+        default:
+            integer = option->value.as_int64;
+            break;
+    }
+
+    switch (option->bind_size) {
+        case 1: {
+            int8_t narrow = (int8_t)integer;
+            memcpy(field, &narrow, sizeof(narrow));
+            break;
+        }
+        case 2: {
+            int16_t narrow = (int16_t)integer;
+            memcpy(field, &narrow, sizeof(narrow));
+            break;
+        }
+        case 4: {
+            int32_t narrow = (int32_t)integer;
+            memcpy(field, &narrow, sizeof(narrow));
+            break;
+        }
+        default:
+            memcpy(field, &integer, sizeof(integer));
+            break;
+    }
+}
+
+cargs_value_t choices_to_value(cargs_valtype_t type, cargs_value_t choices, size_t choices_count,
                                int index)
 {
     cargs_value_t value = {0};
 
-    if (index < 0 || index >= choices_count)
+    if (index < 0 || (size_t)index >= choices_count)
         return value;
 
     switch (type) {
         case VALUE_TYPE_INT:
-            value.as_int = choices.as_array_int[index];
+            value.as_int64 = choices.as_array_int[index];
             break;
         case VALUE_TYPE_STRING:
             value.as_string = choices.as_array_string[index];
@@ -49,7 +133,7 @@ int cmp_value(cargs_valtype_t type, const cargs_value_t a, const cargs_value_t b
         case VALUE_TYPE_FLAG:
             return a.as_bool - b.as_bool;
         case VALUE_TYPE_INT:
-            return a.as_int - b.as_int;
+            return ((a.as_int64 > b.as_int64) - (a.as_int64 < b.as_int64));
         case VALUE_TYPE_STRING:
             if (a.as_string == NULL || b.as_string == NULL)
                 return -1;
@@ -76,7 +160,7 @@ void print_value(FILE *stream, cargs_valtype_t type, cargs_value_t value)
             fprintf(stream, "%s", value.as_bool ? "true" : "false");
             break;
         case VALUE_TYPE_INT:
-            fprintf(stream, "%d", value.as_int);
+            fprintf(stream, "%lld", value.as_int64);
             break;
         case VALUE_TYPE_STRING:
             fprintf(stream, "\"%s\"", value.as_string);
@@ -214,3 +214,171 @@ Test(api, cargs_print_functions, .init = cr_redirect_stdout)
     // Clean up
     cargs_free(&cargs);
 }
+
+// Test the pointer-based accessors against the by-value ones
+Test(api, ref_accessors)
+{
+    char *argv[] = {"test_program", "-n", "7", "--array=1,2,3", "--map=one=1,two=2", "input.txt"};
+    int argc = sizeof(argv) / sizeof(char *);
+
+    cargs_t cargs = cargs_init(api_test_options, "test_program", "1.0.0");
+    cr_assert_eq(cargs_parse(&cargs, argc, argv), CARGS_SUCCESS);
+
+    cr_assert_eq(cargs_get_ref(&cargs, "number").as_int, 7, "Integer value should be correct");
+    cr_assert_eq(cargs_get_ref(&cargs, ".number").raw, cargs_get(cargs, ".number").raw);
+    cr_assert_str_eq(cargs_get_ref(&cargs, "output").as_string, "output.txt");
+    cr_assert(cargs_is_set_ref(&cargs, "input"), "Input option should be set");
+    cr_assert_not(cargs_is_set_ref(&cargs, "verbose"), "Verbose option should not be set");
+    cr_assert_eq(cargs_get_ref(&cargs, "nonexistent").raw, 0);
+    cr_assert_eq(cargs_count_ref(&cargs, "array"), 3, "Array option should have count 3");
+    cr_assert_eq(cargs_array_get_ref(&cargs, "array", 2).as_int, 3);
+    cr_assert_eq(cargs_array_get_ref(&cargs, "array", 3).raw, 0, "Out of bounds should be empty");
+    cr_assert_eq(cargs_map_get_ref(&cargs, "map", "two").as_int, 2);
+    cr_assert_not(cargs_has_command_ref(&cargs), "Should not have a command");
+
+    int sum = 0;
+    cargs_array_it_t array_it = cargs_array_it_ref(&cargs, "array");
+    while (cargs_array_next(&array_it))
+        sum += array_it.value.as_int;
+    cr_assert_eq(sum, 6, "Array iterator should visit every element");
+
+    size_t pairs = 0;
+    cargs_map_it_t map_it = cargs_map_it_ref(&cargs, "map");
+    while (cargs_map_next(&map_it))
+        pairs++;
+    cr_assert_eq(pairs, 2, "Map iterator should visit every pair");
+
+    size_t set = 0;
+    cargs_set_it_t set_it = cargs_set_it_ref(&cargs);
+    while (cargs_set_next(&set_it))
+        set++;
+    cr_assert_eq(set, 5, "Set iterator should visit output, number, array, map and input");
+
+    cargs_free(&cargs);
+}
+
+// Test pointer-based accessors with subcommand paths
+Test(api, ref_accessors_subcommand)
+{
+    char *argv[] = {"test_program", "sub", "-d"};
+    int argc = sizeof(argv) / sizeof(char *);
+
+    cargs_t cargs = cargs_init(api_cmd_options, "test_program", "1.0.0");
+    cr_assert_eq(cargs_parse(&cargs, argc, argv), CARGS_SUCCESS);
+
+    cr_assert(cargs_has_command_ref(&cargs), "Should have a command");
+    cr_assert(cargs_is_set_ref(&cargs, "sub.debug"), "Subcommand option should be set");
+    cr_assert(cargs_is_set_ref(&cargs, "debug"), "Relative path should find the subcommand option");
+    cr_assert_not(cargs_is_set_ref(&cargs, "other.debug"), "Unknown subcommand should not match");
+    cr_assert_not(cargs_is_set_ref(&cargs, ".verbose"));
+
+    cargs_free(&cargs);
+}
+
+// Test pointer-based print functions (minimal test to ensure they don't crash)
+Test(api, ref_print_functions, .init = cr_redirect_stdout)
+{
+    cargs_t cargs = cargs_init(api_test_options, "test_program", "1.0.0");
+
+    cargs_print_help_ref(&cargs);
+    cargs_print_usage_ref(&cargs);
+    cargs_print_version_ref(&cargs);
+    cr_assert(true, "Print functions should not crash");
+
+    cargs_free(&cargs);
+}
+
+// Test option handles resolved once and read directly
+Test(api, handles)
+{
+    char *argv[] = {"test_program", "-v", "--array=4,5", "--map=one=1", "input.txt"};
+    int argc = sizeof(argv) / sizeof(char *);
+
+    cargs_t cargs = cargs_init(api_test_options, "test_program", "1.0.0");
+    cargs_handle_t verbose = cargs_resolve(&cargs, "verbose");
+    cargs_handle_t number  = cargs_resolve(&cargs, ".number");
+    cargs_handle_t array   = cargs_resolve(&cargs, "array");
+    cargs_handle_t map     = cargs_resolve(&cargs, "map");
+    cargs_handle_t missing = cargs_resolve(&cargs, "nonexistent");
+
+    cr_assert(cargs_handle_valid(verbose), "Handles can be resolved before parsing");
+    cr_assert_not(cargs_handle_valid(missing), "Unknown path should give an invalid handle");
+    cr_assert_not(cargs_is_set_h(verbose));
+
+    cr_assert_eq(cargs_parse(&cargs, argc, argv), CARGS_SUCCESS);
+    cr_assert(cargs_is_set_h(verbose), "Handle should see the parsed value");
+    cr_assert_eq(cargs_get_h(number).as_int, 42, "Default value should be read");
+    cr_assert_eq(cargs_count_h(array), 2);
+    cr_assert_eq(cargs_array_get_h(array, 1).as_int, 5);
+    cr_assert_eq(cargs_array_get_h(array, 2).raw, 0, "Out of bounds should be empty");
+    cr_assert_eq(cargs_map_get_h(map, "one").as_int, 1);
+    cr_assert_eq(cargs_map_get_h(map, "two").raw, 0);
+    cr_assert_eq(cargs_get_h(missing).raw, 0);
+    cr_assert_not(cargs_is_set_h(missing));
+    cr_assert_eq(cargs_count_h(missing), 0);
+
+    int sum = 0;
+    cargs_array_it_t it = cargs_array_it_h(array);
+    while (cargs_array_next(&it))
+        sum += it.value.as_int;
+    cr_assert_eq(sum, 9);
+
+    cargs_map_it_t map_it = cargs_map_it_h(map);
+    cr_assert(cargs_map_next(&map_it));
+    cr_assert_str_eq(map_it.key, "one");
+    cr_assert_not(cargs_map_next(&map_it));
+
+    cargs_free(&cargs);
+}
+
+// Test handles to subcommand options, resolved before the subcommand is parsed
+Test(api, handles_subcommand)
+{
+    char *argv[] = {"test_program", "sub", "-d"};
+    int argc = sizeof(argv) / sizeof(char *);
+
+    cargs_t cargs = cargs_init(api_cmd_options, "test_program", "1.0.0");
+    cargs_handle_t debug   = cargs_resolve(&cargs, "sub.debug");
+    cargs_handle_t unknown = cargs_resolve(&cargs, "su.debug");
+
+    cr_assert(cargs_handle_valid(debug), "Inactive subcommand paths resolve through the tree");
+    cr_assert_not(cargs_handle_valid(unknown), "Subcommand names must match exactly");
+    cr_assert_not(cargs_is_set_h(debug));
+
+    cr_assert_eq(cargs_parse(&cargs, argc, argv), CARGS_SUCCESS);
+    cr_assert(cargs_is_set_h(debug));
+    cr_assert_eq(cargs_resolve(&cargs, "debug")._option, debug._option,
+                 "Relative and full paths should resolve to the same option");
+
+    cargs_free(&cargs);
+}
+
+// Test typed handles
+Test(api, typed_handles)
+{
+    char *argv[] = {"test_program", "-v", "-n", "5000000000", "input.txt"};
+    int argc = sizeof(argv) / sizeof(char *);
+
+    cargs_t cargs = cargs_init(api_test_options, "test_program", "1.0.0");
+    cargs_i64_t  number  = cargs_resolve_i64(&cargs, "number");
+    cargs_str_t  output  = cargs_resolve_str(&cargs, "output");
+    cargs_bool_t verbose = cargs_resolve_bool(&cargs, "verbose");
+    cargs_f64_t  wrong   = cargs_resolve_f64(&cargs, "number");
+    cargs_i64_t  missing = cargs_resolve_i64(&cargs, "nonexistent");
+
+    cr_assert(cargs_typed_valid(number));
+    cr_assert_not(cargs_typed_valid(wrong), "Types are checked when resolving");
+    cr_assert_not(cargs_typed_valid(missing));
+    cr_assert_eq(cargs_get_i64(number), 42, "Handles read defaults before parsing");
+
+    cr_assert_eq(cargs_parse(&cargs, argc, argv), CARGS_SUCCESS);
+    cr_assert_eq(cargs_get_i64(number), 5000000000LL, "Values are not truncated to int");
+    cr_assert_eq(cargs_value(number), 5000000000LL);
+    cr_assert_str_eq(cargs_value(output), "output.txt");
+    cr_assert(cargs_value(verbose));
+    cr_assert_float_eq(cargs_value(wrong), 0.0, 1e-9, "Invalid handles read as zero");
+    cr_assert_eq(cargs_value(missing), 0);
+    cr_assert_null(cargs_get_str(cargs_resolve_str(&cargs, "array")));
+
+    cargs_free(&cargs);
+}
@@ -0,0 +1,129 @@
+#include <criterion/criterion.h>
+#include "cargs.h"
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+// Struct filled by the bound options
+typedef struct config_s
+{
+    const char *output;
+    int         count;
+    short       level;
+    int8_t      small;
+    int64_t     big;
+    bool        verbose;
+    double      ratio;
+    float       scale;
+    const char *input;
+    const char *remote;
+    bool        force;
+} config_t;
+
+CARGS_OPTIONS(
+    push_bind_options,
+    HELP_OPTION(FLAGS(FLAG_EXIT)),
+    OPTION_STRING('r', "remote", HELP("Remote"), BIND(config_t, remote)),
+    OPTION_FLAG('f', "force", HELP("Force"), BIND(config_t, force))
+)
+
+CARGS_OPTIONS(
+    bind_options,
+    HELP_OPTION(FLAGS(FLAG_EXIT)),
+    OPTION_STRING('o', "output", HELP("Output"), BIND(config_t, output)),
+    OPTION_INT('n', "count", HELP("Count"), DEFAULT(3), BIND(config_t, count)),
+    OPTION_INT('l', "level", HELP("Level"), BIND(config_t, level)),
+    OPTION_INT('s', "small", HELP("Small"), BIND(config_t, small)),
+    OPTION_INT('b', "big", HELP("Big"), BIND(config_t, big)),
+    OPTION_FLAG('v', "verbose", HELP("Verbose"), BIND(config_t, verbose)),
+    OPTION_FLOAT('r', "ratio", HELP("Ratio"), BIND(config_t, ratio)),
+    OPTION_FLOAT('x', "scale", HELP("Scale"), BIND(config_t, scale)),
+    OPTION_INT('m', "max", HELP("Max"), RANGE(1, 10)),
+    SUBCOMMAND("push", push_bind_options, HELP("Push")),
+    POSITIONAL_STRING("input", HELP("Input"), FLAGS(FLAG_OPTIONAL), BIND(config_t, input))
+)
+
+Test(bind, scalar_fields)
+{
+    char *argv[] = {"test", "-o", "out.txt", "--level=-12", "-s", "100", "--big=9000000000",
+                    "-v", "--ratio=0.25", "--scale=1.5", "file.txt"};
+    int   argc   = sizeof(argv) / sizeof(char *);
+    config_t config = {0};
+
+    cargs_t cargs = cargs_init(bind_options, "test", "1.0.0");
+    cargs_bind(&cargs, &config);
+    cr_assert_eq(cargs_parse(&cargs, argc, argv), CARGS_SUCCESS);
+
+    cr_assert_str_eq(config.output, "out.txt");
+    cr_assert_eq(config.count, 3, "Defaults are bound too");
+    cr_assert_eq(config.level, -12);
+    cr_assert_eq(config.small, 100);
+    cr_assert_eq(config.big, 9000000000LL);
+    cr_assert(config.verbose);
+    cr_assert_float_eq(config.ratio, 0.25, 1e-9);
+    cr_assert_float_eq(config.scale, 1.5f, 1e-6);
+    cr_assert_str_eq(config.input, "file.txt");
+    cr_assert_null(config.remote, "Options of a subcommand not entered are not bound");
+    cargs_free(&cargs);
+}
+
+Test(bind, unset_fields_kept)
+{
+    char *argv[] = {"test", "-n", "7"};
+    config_t config = {.output = "default.txt", .level = 4, .ratio = 2.0};
+
+    cargs_t cargs = cargs_init(bind_options, "test", "1.0.0");
+    cargs_bind(&cargs, &config);
+    cr_assert_eq(cargs_parse(&cargs, 3, argv), CARGS_SUCCESS);
+
+    cr_assert_eq(config.count, 7);
+    cr_assert_str_eq(config.output, "default.txt", "Fields of unset options are left alone");
+    cr_assert_eq(config.level, 4);
+    cr_assert_float_eq(config.ratio, 2.0, 1e-9);
+    cr_assert_null(config.input);
+    cargs_free(&cargs);
+}
+
+Test(bind, subcommand_fields)
+{
+    char *argv[] = {"test", "-v", "push", "-f", "--remote", "origin"};
+    config_t config = {0};
+
+    cargs_t cargs = cargs_init(bind_options, "test", "1.0.0");
+    cargs_bind(&cargs, &config);
+    cr_assert_eq(cargs_parse(&cargs, 6, argv), CARGS_SUCCESS);
+
+    cr_assert(config.verbose);
+    cr_assert(config.force);
+    cr_assert_str_eq(config.remote, "origin");
+    cargs_free(&cargs);
+}
+
+Test(bind, failed_parse_leaves_struct)
+{
+    char *argv[] = {"test", "-o", "out.txt", "--max=50"};
+    config_t config = {.output = "untouched", .count = -1};
+
+    cargs_t cargs = cargs_init(bind_options, "test", "1.0.0");
+    cargs_bind(&cargs, &config);
+    cr_assert_neq(cargs_parse(&cargs, 4, argv), CARGS_SUCCESS);
+
+    cr_assert_str_eq(config.output, "untouched", "Nothing is written when parsing fails");
+    cr_assert_eq(config.count, -1);
+    cargs_free(&cargs);
+}
+
+Test(bind, no_target)
+{
+    char *argv[] = {"test", "-o", "out.txt"};
+    config_t config = {0};
+
+    cargs_t cargs = cargs_init(bind_options, "test", "1.0.0");
+    cargs_bind(&cargs, &config);
+    cargs_bind(&cargs, NULL);
+    cr_assert_eq(cargs_parse(&cargs, 3, argv), CARGS_SUCCESS);
+
+    cr_assert_null(config.output, "Binding is off once the target is cleared");
+    cr_assert_str_eq(cargs_get(cargs, "output").as_string, "out.txt");
+    cargs_free(&cargs);
+}
@@ -1,7 +1,10 @@
 #include <criterion/criterion.h>
 #include "cargs.h"
+#include <fcntl.h>
+#include <limits.h>
 #include <stdlib.h>
 #include <string.h>
+#include <unistd.h>
 
 // Test options with array and map values
 CARGS_OPTIONS(
@@ -182,3 +185,413 @@ Test(multi_value_access, cargs_map_it)
     // Clean up
     cargs_free(&cargs);
 }
+
+// Options for span tests
+CARGS_OPTIONS(
+    span_options,
+    HELP_OPTION(FLAGS(FLAG_EXIT)),
+    OPTION_ARRAY_INT('i', "ints", HELP("Array of integers")),
+    OPTION_ARRAY_FLOAT('f', "floats", HELP("Array of floats")),
+    OPTION_ARRAY_STRING('s', "strings", HELP("Array of strings")),
+    OPTION_ARRAY_INT('e', "empty", HELP("Array never set"))
+)
+
+// Test zero-copy spans over array storage
+Test(multi_value_access, cargs_array_span)
+{
+    char *argv[] = {"test_program", "--ints=1,5000000000,-3", "-i", "7-9",
+                    "--floats=0.5,2.25", "-s", "a,b", "-sc"};
+    int argc = sizeof(argv) / sizeof(char *);
+
+    cargs_t cargs = cargs_init(span_options, "test_program", "1.0.0");
+    cr_assert_eq(cargs_parse(&cargs, argc, argv), CARGS_SUCCESS, "Parsing should succeed");
+
+    cargs_span_i64_t ints = cargs_array_span_i64(&cargs, "ints");
+    long long expected[] = {1, 5000000000LL, -3, 7, 8, 9};
+    cr_assert_eq(ints.len, 6, "Span should cover every element");
+    cr_assert_arr_eq(ints.data, expected, sizeof(expected), "Ints should be contiguous long longs");
+
+    cargs_span_f64_t floats = cargs_array_span_f64(&cargs, "floats");
+    cr_assert_eq(floats.len, 2);
+    cr_assert_float_eq(floats.data[0], 0.5, 1e-9);
+    cr_assert_float_eq(floats.data[1], 2.25, 1e-9);
+
+    cargs_span_str_t strings = cargs_array_span_str_h(cargs_resolve(&cargs, "strings"));
+    if (sizeof(char *) == sizeof(cargs_value_t)) {
+        cr_assert_eq(strings.len, 3);
+        cr_assert_str_eq(strings.data[0], "a");
+        cr_assert_str_eq(strings.data[2], "c");
+    }
+
+    // Spans share the storage of the option
+    cr_assert_eq((const void *)ints.data, (const void *)span_options[1].value.as_array);
+
+    cargs_span_i64_t empty = cargs_array_span_i64(&cargs, "empty");
+    cr_assert_null(empty.data, "Unset arrays give an empty span");
+    cr_assert_eq(empty.len, 0);
+    cr_assert_null(cargs_array_span_f64(&cargs, "ints").data, "Types must match");
+    cr_assert_null(cargs_array_span_i64(&cargs, "nonexistent").data);
+
+    cargs_free(&cargs);
+}
+
+// Options for prefix iteration tests
+CARGS_OPTIONS(
+    prefix_options,
+    HELP_OPTION(FLAGS(FLAG_EXIT)),
+    OPTION_MAP_STRING('D', "define", HELP("Sorted definitions"), FLAGS(FLAG_SORTED_KEY)),
+    OPTION_MAP_INT('U', "unsorted", HELP("Unsorted definitions"))
+)
+
+// Test prefix iteration over sorted and unsorted maps
+Test(multi_value_access, cargs_map_prefix_it)
+{
+    char *argv[] = {"test_program", "-D", "db.pool.timeout=30", "-D", "app.name=demo",
+                    "-D", "db.pool.size=10,db.host=local", "-Ddb.pool.size=12",
+                    "--unsorted=db.pool.b=2,app=0,db.pool.a=1"};
+    int argc = sizeof(argv) / sizeof(char *);
+
+    cargs_t cargs = cargs_init(prefix_options, "test_program", "1.0.0");
+    cr_assert_eq(cargs_parse(&cargs, argc, argv), CARGS_SUCCESS, "Parsing should succeed");
+
+    cr_assert_eq(cargs_count(cargs, "define"), 4, "Updated keys should not be duplicated");
+    cr_assert_str_eq(cargs_map_get_ref(&cargs, "define", "db.pool.size").as_string, "12");
+    cr_assert_str_eq(cargs_map_get_ref(&cargs, "define", "app.name").as_string, "demo");
+    cr_assert_null(cargs_map_get_ref(&cargs, "define", "db.pool").as_string);
+
+    cargs_map_it_t it = cargs_map_prefix_it(&cargs, "define", "db.pool.");
+    cr_assert_eq(it._count, 2, "Sorted maps are narrowed to the matching range");
+    cr_assert(cargs_map_next(&it));
+    cr_assert_str_eq(it.key, "db.pool.size");
+    cr_assert(cargs_map_next(&it));
+    cr_assert_str_eq(it.key, "db.pool.timeout");
+    cr_assert_not(cargs_map_next(&it));
+
+    cargs_map_reset(&it);
+    cr_assert(cargs_map_next(&it), "Reset should restart the range");
+    cr_assert_str_eq(it.key, "db.pool.size");
+
+    it = cargs_map_prefix_it(&cargs, "unsorted", "db.pool.");
+    size_t count = 0;
+    long long sum = 0;
+    while (cargs_map_next(&it)) {
+        cr_assert_eq(strncmp(it.key, "db.pool.", 8), 0, "Unsorted maps skip other keys");
+        sum += it.value.as_int64;
+        count++;
+    }
+    cr_assert_eq(count, 2);
+    cr_assert_eq(sum, 3);
+
+    it = cargs_map_prefix_it(&cargs, "define", "none.");
+    cr_assert_not(cargs_map_next(&it), "No key should match");
+
+    cargs_free(&cargs);
+}
+
+// Options for packed array tests
+CARGS_OPTIONS(
+    packed_options,
+    HELP_OPTION(FLAGS(FLAG_EXIT)),
+    OPTION_ARRAY_INT('i', "ids", HELP("Sorted ids"), FLAGS(FLAG_PACKED | FLAG_SORTED | FLAG_UNIQUE)),
+    OPTION_ARRAY_INT('p', "plain", HELP("Plain ids"))
+)
+
+// Test arrays stored with FLAG_PACKED
+Test(multi_value_access, packed_array)
+{
+    char *argv[] = {"test_program", "--ids=500-1499", "-i", "7,3,3,-2", "--ids=9000000000",
+                    "--plain=4,5"};
+    int argc = sizeof(argv) / sizeof(char *);
+
+    cargs_t cargs = cargs_init(packed_options, "test_program", "1.0.0");
+    cr_assert_eq(cargs_parse(&cargs, argc, argv), CARGS_SUCCESS, "Parsing should succeed");
+    cr_assert(packed_options[1].is_packed, "Packed once the parse succeeded");
+    cr_assert_not(packed_options[2].is_packed);
+
+    cr_assert_eq(cargs_count(cargs, "ids"), 1004);
+    cr_assert_eq(cargs_array_get(cargs, "ids", 0).as_int64, -2);
+    cr_assert_eq(cargs_array_get(cargs, "ids", 2).as_int64, 7);
+    cr_assert_eq(cargs_array_get(cargs, "ids", 3).as_int64, 500);
+    cr_assert_eq(cargs_array_get(cargs, "ids", 1003).as_int64, 9000000000LL);
+    cr_assert_eq(cargs_array_get_h(cargs_resolve(&cargs, "ids"), 700).as_int64, 1197);
+    cr_assert_eq(cargs_array_get(cargs, "ids", 1004).raw, 0, "Out of range reads as {0}");
+
+    // The iterator decodes one gap at a time
+    cargs_array_it_t it = cargs_array_it(cargs, "ids");
+    long long previous = LLONG_MIN;
+    size_t count = 0;
+    while (cargs_array_next(&it)) {
+        cr_assert_gt(it.value.as_int64, previous);
+        cr_assert_eq(it.value.as_int64, cargs_array_get(cargs, "ids", count).as_int64);
+        previous = it.value.as_int64;
+        count++;
+    }
+    cr_assert_eq(count, 1004);
+    cargs_array_reset(&it);
+    cr_assert(cargs_array_next(&it));
+    cr_assert_eq(it.value.as_int64, -2);
+
+    // Copies work on both storages, spans only on plain arrays
+    long long out[8];
+    cr_assert_eq(cargs_array_copy_i64(&cargs, "ids", 126, out, 4), 4, "Copies can span blocks");
+    cr_assert_eq(out[0], 623);
+    cr_assert_eq(out[3], 626);
+    cr_assert_eq(cargs_array_copy_i64(&cargs, "ids", 1002, out, 8), 2);
+    cr_assert_eq(out[1], 9000000000LL);
+    cr_assert_eq(cargs_array_copy_i64(&cargs, "plain", 0, out, 8), 2);
+    cr_assert_eq(out[1], 5);
+    cr_assert_null(cargs_array_span_i64(&cargs, "ids").data, "Packed arrays have no plain storage");
+    cr_assert_eq(cargs_array_span_i64(&cargs, "plain").len, 2);
+
+    // Reset goes back to a plain array for the next parse
+    char *again[] = {"test_program", "-i", "2,1"};
+    cargs_reset(&cargs);
+    cr_assert_not(packed_options[1].is_packed);
+    cr_assert_eq(cargs_parse(&cargs, 3, again), CARGS_SUCCESS);
+    cr_assert_eq(cargs_count(cargs, "ids"), 2);
+    cr_assert_eq(cargs_array_get(cargs, "ids", 1).as_int64, 2);
+    cargs_free(&cargs);
+}
+
+// Options for values file tests
+CARGS_OPTIONS(
+    bin_options,
+    HELP_OPTION(FLAGS(FLAG_EXIT)),
+    OPTION_ARRAY_INT('i', "ids", HELP("Ids"), FLAGS(FLAG_VALUES_FILE)),
+    OPTION_ARRAY_INT('s', "sorted", HELP("Sorted ids"),
+                     FLAGS(FLAG_SORTED | FLAG_UNIQUE | FLAG_VALUES_FILE)),
+    OPTION_ARRAY_FLOAT('w', "weights", HELP("Weights"), FLAGS(FLAG_VALUES_FILE)),
+    OPTION_ARRAY_INT('p', "packed", HELP("Packed ids"),
+                     FLAGS(FLAG_PACKED | FLAG_SORTED | FLAG_VALUES_FILE)),
+    OPTION_ARRAY_INT('l', "literal", HELP("Ids without values files"))
+)
+
+// Write raw values to a temporary file, arg receives "@bin:<path>"
+static void write_values_file(char *path, char *arg, const void *data, size_t size)
+{
+    strcpy(path, "/tmp/cargs_bin_XXXXXX");
+    int fd = mkstemp(path);
+    cr_assert_geq(fd, 0);
+    cr_assert_eq(write(fd, data, size), (ssize_t)size);
+    close(fd);
+    sprintf(arg, "@bin:%s", path);
+}
+
+// Test numeric arrays read from raw values files
+Test(multi_value_access, bin_values_file)
+{
+    long long ids[]     = {10, -20, 5000000000LL, 7};
+    double    weights[] = {0.5, -1.25};
+    char      ids_path[64], ids_arg[80], weights_path[64], weights_arg[80];
+
+    write_values_file(ids_path, ids_arg, ids, sizeof(ids));
+    write_values_file(weights_path, weights_arg, weights, sizeof(weights));
+
+    char *argv[] = {"test_program", "-i", ids_arg, "-w", weights_arg};
+    cargs_t cargs = cargs_init(bin_options, "test_program", "1.0.0");
+    cr_assert_eq(cargs_parse(&cargs, 5, argv), CARGS_SUCCESS, "Parsing should succeed");
+
+    cr_assert(bin_options[1].is_mapped, "The file is the storage of the option");
+    cargs_span_i64_t span = cargs_array_span_i64(&cargs, "ids");
+    cr_assert_eq(span.len, 4);
+    cr_assert_arr_eq(span.data, ids, sizeof(ids), "Values are taken as they are, in file order");
+    cr_assert_float_eq(cargs_array_get(cargs, "weights", 1).as_float, -1.25, 1e-9);
+    cargs_free(&cargs);
+    cr_assert_not(bin_options[1].is_mapped);
+
+    // Values added after a file go to a copy
+    char *more[] = {"test_program", "--ids", ids_arg, "-i", "1,2", "-i", ids_arg};
+    cargs = cargs_init(bin_options, "test_program", "1.0.0");
+    cr_assert_eq(cargs_parse(&cargs, 7, more), CARGS_SUCCESS);
+    cr_assert_not(bin_options[1].is_mapped);
+    cr_assert_eq(cargs_count(cargs, "ids"), 10);
+    cr_assert_eq(cargs_array_get(cargs, "ids", 4).as_int64, 1);
+    cr_assert_eq(cargs_array_get(cargs, "ids", 8).as_int64, 5000000000LL);
+    cargs_free(&cargs);
+
+    unlink(ids_path);
+    unlink(weights_path);
+}
+
+// Test the checks made on values files
+Test(multi_value_access, bin_values_checks)
+{
+    long long sorted[]   = {1, 2, 3, 1000};
+    long long repeated[] = {1, 2, 2, 3};
+    long long shuffled[] = {9, -4, 7, 0};
+    char      odd[]      = {1, 2, 3};
+    char      sorted_path[64], sorted_arg[80], repeated_path[64], repeated_arg[80];
+    char      unsorted_path[64], unsorted_arg[80], odd_path[64], odd_arg[80];
+
+    write_values_file(sorted_path, sorted_arg, sorted, sizeof(sorted));
+    write_values_file(repeated_path, repeated_arg, repeated, sizeof(repeated));
+    write_values_file(unsorted_path, unsorted_arg, shuffled, sizeof(shuffled));
+    write_values_file(odd_path, odd_arg, odd, sizeof(odd));
+
+    char *ok[] = {"test_program", "-s", sorted_arg, "-p", sorted_arg};
+    cargs_t cargs = cargs_init(bin_options, "test_program", "1.0.0");
+    cr_assert_eq(cargs_parse(&cargs, 5, ok), CARGS_SUCCESS);
+    cr_assert(bin_options[2].is_mapped, "Sorted files are checked, not copied");
+    cr_assert(bin_options[4].is_packed, "Mapped arrays can be packed");
+    cr_assert_eq(cargs_array_get(cargs, "packed", 3).as_int64, 1000);
+    cargs_free(&cargs);
+
+    char *dup[] = {"test_program", "-s", repeated_arg};
+    cargs = cargs_init(bin_options, "test_program", "1.0.0");
+    cr_assert_eq(cargs_parse(&cargs, 3, dup), CARGS_SUCCESS);
+    cr_assert_not(bin_options[2].is_mapped, "Values the flags change are copied");
+    cr_assert_eq(cargs_count(cargs, "sorted"), 3, "Duplicates are removed as usual");
+    cr_assert_eq(cargs_array_get(cargs, "sorted", 2).as_int64, 3);
+    cargs_free(&cargs);
+
+    char *unsorted[] = {"test_program", "-p", unsorted_arg};
+    cargs = cargs_init(bin_options, "test_program", "1.0.0");
+    cr_assert_eq(cargs_parse(&cargs, 3, unsorted), CARGS_SUCCESS);
+    cr_assert_eq(cargs_array_get(cargs, "packed", 0).as_int64, -4, "Unsorted files are sorted");
+    cr_assert_eq(cargs_array_get(cargs, "packed", 3).as_int64, 9);
+    cargs_free(&cargs);
+
+    char *size[] = {"test_program", "-i", odd_arg};
+    cargs = cargs_init(bin_options, "test_program", "1.0.0");
+    cr_assert_eq(cargs_parse(&cargs, 3, size), CARGS_ERROR_INVALID_FORMAT);
+    cargs_free(&cargs);
+
+    char *missing[] = {"test_program", "-i", "@bin:/nonexistent/ids.i64"};
+    cargs = cargs_init(bin_options, "test_program", "1.0.0");
+    cr_assert_eq(cargs_parse(&cargs, 3, missing), CARGS_ERROR_INVALID_ARGUMENT);
+    cargs_free(&cargs);
+
+    char *literal[] = {"test_program", "-l", sorted_arg};
+    cargs = cargs_init(bin_options, "test_program", "1.0.0");
+    cr_assert_neq(cargs_parse(&cargs, 3, literal), CARGS_SUCCESS,
+                  "Without FLAG_VALUES_FILE the value is not a file");
+    cr_assert_not(bin_options[5].is_mapped);
+    cargs_free(&cargs);
+
+    unlink(sorted_path);
+    unlink(repeated_path);
+    unlink(unsorted_path);
+    unlink(odd_path);
+}
+
+// Options for streamed values file tests
+CARGS_OPTIONS(
+    file_options,
+    HELP_OPTION(FLAGS(FLAG_EXIT)),
+    OPTION_ARRAY_STRING('I', "include", HELP("Include paths"), FLAGS(FLAG_VALUES_FILE)),
+    OPTION_ARRAY_INT('i', "ids", HELP("Ids"), FLAGS(FLAG_SORTED | FLAG_UNIQUE | FLAG_VALUES_FILE)),
+    OPTION_MAP_INT('l', "limits", HELP("Limits"), FLAGS(FLAG_VALUES_FILE))
+)
+
+// Write text to a temporary file, arg receives prefix followed by the path
+static void write_text_file(char *path, char *arg, const char *prefix, const char *text,
+                            size_t size)
+{
+    strcpy(path, "/tmp/cargs_file_XXXXXX");
+    int fd = mkstemp(path);
+    cr_assert_geq(fd, 0);
+    cr_assert_eq(write(fd, text, size), (ssize_t)size);
+    close(fd);
+    sprintf(arg, "%s%s", prefix, path);
+}
+
+// Test array and map elements read from files, one per line
+Test(multi_value_access, streamed_values_file)
+{
+    const char paths[]  = "src/a,b.c\r\n\n/usr/include\n@home\nlast";
+    const char limits[] = "cpu=4\nmem=512\ncpu=8\n";
+    const char records[] = "with\nnewline\0second\0";
+    char       paths_file[64], paths_arg[80], limits_file[64], limits_arg[80];
+    char       records_file[64], records_arg[80];
+
+    write_text_file(paths_file, paths_arg, "@", paths, sizeof(paths) - 1);
+    write_text_file(limits_file, limits_arg, "--limits=@", limits, sizeof(limits) - 1);
+    write_text_file(records_file, records_arg, "@nul:", records, sizeof(records) - 1);
+
+    char *argv[] = {"test_program", "-I", paths_arg, "-I", "@@literal", limits_arg,
+                    "-I", records_arg};
+    cargs_t cargs = cargs_init(file_options, "test_program", "1.0.0");
+    cr_assert_eq(cargs_parse(&cargs, 8, argv), CARGS_SUCCESS, "Parsing should succeed");
+
+    const char *expected[] = {"src/a,b.c", "/usr/include", "@home", "last", "@literal",
+                              "with\nnewline", "second"};
+    cr_assert_eq(cargs_count(cargs, "include"), 7, "Empty lines are skipped");
+    for (size_t i = 0; i < 7; ++i)
+        cr_assert_str_eq(cargs_array_get(cargs, "include", i).as_string, expected[i]);
+    cr_assert_eq(cargs_count(cargs, "limits"), 2);
+    cr_assert_eq(cargs_map_get(cargs, "limits", "cpu").as_int, 8);
+    cargs_free(&cargs);
+
+    unlink(paths_file);
+    unlink(limits_file);
+    unlink(records_file);
+}
+
+// Longer than the 64 KiB read buffer
+#define LONG_ELEMENT (128 * 1024)
+
+// Test files larger than the read buffer, from stdin
+Test(multi_value_access, streamed_values_large)
+{
+    size_t count = 200000;
+    size_t size  = count * 8 + LONG_ELEMENT;
+    char  *text  = malloc(size);
+    size_t used  = 0;
+
+    cr_assert_not_null(text);
+    // Descending with repeats, the flags run once on the whole file
+    for (size_t i = count; i > 0; --i)
+        used += sprintf(text + used, "%zu\n", i / 2);
+    char name_file[64], name_arg[80];
+    write_text_file(name_file, name_arg, "@", text, used);
+
+    // An element longer than a chunk
+    memset(text, 'x', LONG_ELEMENT);
+    char long_file[64], long_arg[80];
+    write_text_file(long_file, long_arg, "@", text, LONG_ELEMENT);
+
+    int fd = open(name_file, O_RDONLY);
+    cr_assert_geq(fd, 0);
+    dup2(fd, STDIN_FILENO);
+    close(fd);
+
+    char *argv[] = {"test_program", "--ids=@-", "-I", long_arg};
+    cargs_t cargs = cargs_init(file_options, "test_program", "1.0.0");
+    cr_assert_eq(cargs_parse(&cargs, 4, argv), CARGS_SUCCESS, "Parsing should succeed");
+
+    cr_assert_eq(cargs_count(cargs, "ids"), count / 2 + 1);
+    cr_assert_eq(cargs_array_get(cargs, "ids", 0).as_int64, 0);
+    cr_assert_eq(cargs_array_get(cargs, "ids", count / 2).as_int64, (long long)(count / 2));
+    cr_assert_eq(strlen(cargs_array_get(cargs, "include", 0).as_string),
+                 LONG_ELEMENT);
+    cargs_free(&cargs);
+
+    char *missing[] = {"test_program", "-I", "@/nonexistent/paths.txt"};
+    cargs = cargs_init(file_options, "test_program", "1.0.0");
+    cr_assert_eq(cargs_parse(&cargs, 3, missing), CARGS_ERROR_INVALID_ARGUMENT);
+    cargs_free(&cargs);
+
+    free(text);
+    unlink(name_file);
+    unlink(long_file);
+}
+
+// Test that values starting with '@' are kept unless the option reads files
+Test(multi_value_access, values_file_opt_in)
+{
+    char *plain[] = {"test_program", "-s", "@handle", "-s", "@@twice", "-m", "@key=@value"};
+    cargs_t cargs = cargs_init(multi_value_options, "test_program", "1.0.0");
+    cr_assert_eq(cargs_parse(&cargs, 7, plain), CARGS_SUCCESS, "Parsing should succeed");
+    cr_assert_str_eq(cargs_array_get(cargs, "strings", 0).as_string, "@handle");
+    cr_assert_str_eq(cargs_array_get(cargs, "strings", 1).as_string, "@@twice",
+                     "Nothing is unescaped without FLAG_VALUES_FILE");
+    cr_assert_str_eq(cargs_map_get(cargs, "map", "@key").as_string, "@value");
+    cargs_free(&cargs);
+
+    char *lone[] = {"test_program", "-I", "@", "-I", "@@home"};
+    cargs = cargs_init(file_options, "test_program", "1.0.0");
+    cr_assert_eq(cargs_parse(&cargs, 5, lone), CARGS_SUCCESS, "A lone '@' is not a file");
+    cr_assert_str_eq(cargs_array_get(cargs, "include", 0).as_string, "@");
+    cr_assert_str_eq(cargs_array_get(cargs, "include", 1).as_string, "@home");
+    cargs_free(&cargs);
+}
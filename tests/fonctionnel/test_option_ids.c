@@ -0,0 +1,114 @@
+#include <criterion/criterion.h>
+#include "cargs.h"
+#include <string.h>
+
+#define PUSH_OPTIONS(X)                                                                            \
+    X(PUSH_HELP, HELP_OPTION(FLAGS(FLAG_EXIT)))                                                    \
+    X(PUSH_FORCE, OPTION_FLAG('f', "force", HELP("Force")))                                        \
+    X(PUSH_REMOTE, OPTION_STRING('r', "remote", HELP("Remote")))
+
+CARGS_OPTIONS_X(push_id_options, PUSH_OPTIONS)
+
+#define ID_OPTIONS(X)                                                                              \
+    X(OPT_HELP, HELP_OPTION(FLAGS(FLAG_EXIT)))                                                     \
+    X(OPT_VERBOSE, OPTION_FLAG('v', "verbose", HELP("Verbose output")))                            \
+    X(OPT_NETWORK, GROUP_START("Network", GROUP_DESC("Network options")))                          \
+    X(OPT_JOBS, OPTION_INT('j', "jobs", HELP("Parallel jobs")))                                    \
+    X(OPT_RATIO, OPTION_FLOAT('r', "ratio", HELP("Ratio")))                                        \
+    X(OPT_NETWORK_END, GROUP_END())                                                                \
+    X(OPT_OUTPUT, OPTION_STRING('o', "output", HELP("Output file")))                               \
+    X(OPT_PORTS, OPTION_ARRAY_INT('p', "ports", HELP("Ports")))                                    \
+    X(OPT_PUSH, SUBCOMMAND("push", push_id_options, HELP("Push")))
+
+CARGS_OPTIONS_X(id_options, ID_OPTIONS)
+
+// Checked at compile time, an ID at or past the end would not build
+CARGS_CHECK_ID(id_options, OPT_PUSH);
+CARGS_CHECK_ID(push_id_options, PUSH_REMOTE);
+
+Test(option_ids, enum_matches_positions)
+{
+    cr_assert_eq(OPT_HELP, 0);
+    cr_assert_str_eq(id_options[OPT_JOBS].name, "jobs");
+    cr_assert_str_eq(id_options[OPT_OUTPUT].name, "output");
+    cr_assert_eq(id_options[OPT_NETWORK_END].type, TYPE_GROUP);
+    cr_assert_str_eq(id_options[OPT_PUSH].name, "push");
+    cr_assert_eq(id_options[OPT_PUSH + 1].type, TYPE_NONE, "The array ends after the last ID");
+    cr_assert_str_eq(push_id_options[PUSH_REMOTE].name, "remote");
+    cr_assert_eq(id_options_COUNT, OPT_PUSH + 1, "The count follows the last ID");
+    cr_assert_eq(push_id_options_COUNT, 3);
+}
+
+Test(option_ids, typed_accessors)
+{
+    char *argv[] = {"test", "-v", "-j", "8", "--ratio=0.5", "-o", "out.txt", "--ports=80,443"};
+    int   argc   = sizeof(argv) / sizeof(char *);
+
+    cargs_t cargs = cargs_init(id_options, "test", "1.0.0");
+    cr_assert_eq(cargs_parse(&cargs, argc, argv), CARGS_SUCCESS);
+
+    cr_assert(cargs_is_set_id(&cargs, OPT_VERBOSE));
+    cr_assert(cargs_get_bool_id(&cargs, OPT_VERBOSE));
+    cr_assert_eq(cargs_get_int_id(&cargs, OPT_JOBS), 8);
+    cr_assert_float_eq(cargs_get_float_id(&cargs, OPT_RATIO), 0.5, 1e-9);
+    cr_assert_str_eq(cargs_get_string_id(&cargs, OPT_OUTPUT), "out.txt");
+    cr_assert_eq(cargs_get_id(&cargs, OPT_JOBS).as_int, cargs_get(cargs, "jobs").as_int);
+    cr_assert_eq(cargs_count_id(&cargs, OPT_PORTS), 2);
+    cr_assert_eq(cargs_array_get_id(&cargs, OPT_PORTS, 1).as_int, 443);
+    cr_assert_eq(cargs_array_get_id(&cargs, OPT_PORTS, 2).raw, 0, "Out of range reads as {0}");
+    cr_assert_not(cargs_is_set_id(&cargs, OPT_PUSH));
+    cargs_free(&cargs);
+}
+
+Test(option_ids, subcommand_handles)
+{
+    char *argv[] = {"test", "push", "-f", "-r", "origin"};
+
+    cargs_t cargs = cargs_init(id_options, "test", "1.0.0");
+    cr_assert_eq(cargs_parse(&cargs, 5, argv), CARGS_SUCCESS);
+
+    cargs_handle_t push   = cargs_handle_id(&cargs, OPT_PUSH);
+    cargs_handle_t force  = cargs_sub_handle_id(push, PUSH_FORCE);
+    cargs_handle_t remote = cargs_sub_handle_id(push, PUSH_REMOTE);
+    cr_assert(cargs_is_set_h(force));
+    cr_assert_str_eq(cargs_get_h(remote).as_string, "origin");
+    cr_assert_eq(remote._option, cargs_resolve(&cargs, "push.remote")._option);
+
+    cargs_handle_t not_sub = cargs_sub_handle_id(cargs_handle_id(&cargs, OPT_JOBS), PUSH_FORCE);
+    cr_assert_not(cargs_handle_valid(not_sub), "Only subcommands have sub options");
+    cargs_free(&cargs);
+}
+
+Test(option_ids, cloned_options)
+{
+    char *argv[] = {"test", "-j", "4"};
+
+    cargs_option_t *copy = cargs_options_clone(id_options);
+    cr_assert_not_null(copy);
+
+    cargs_t cargs = cargs_init(copy, "test", "1.0.0");
+    cr_assert_eq(cargs_parse(&cargs, 3, argv), CARGS_SUCCESS);
+    cr_assert_eq(cargs_get_int_id(&cargs, OPT_JOBS), 4, "IDs index the array given to cargs_init");
+    cr_assert_not(id_options[OPT_JOBS].is_set);
+    cargs_free(&cargs);
+    cargs_options_destroy(copy);
+}
+
+// Debug builds reject an ID past the end of the array it is used with
+Test(option_ids, out_of_range_id)
+{
+    cargs_t cargs = cargs_init(push_id_options, "test", "1.0.0");
+    cr_assert_not(cargs_handle_valid(cargs_handle_id(&cargs, OPT_PUSH)));
+    cr_assert_not(cargs_is_set_id(&cargs, OPT_PUSH));
+    cr_assert_null(cargs_get_string_id(&cargs, OPT_PUSH));
+    cargs_free(&cargs);
+}
+
+Test(option_ids, out_of_range_sub_id)
+{
+    cargs_t        cargs = cargs_init(id_options, "test", "1.0.0");
+    cargs_handle_t push  = cargs_handle_id(&cargs, OPT_PUSH);
+    cr_assert_not(cargs_handle_valid(cargs_sub_handle_id(push, OPT_PORTS)));
+    cr_assert_not(cargs_handle_valid(cargs_sub_handle_id(push, (size_t)-1)));
+    cargs_free(&cargs);
+}
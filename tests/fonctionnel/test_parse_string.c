@@ -0,0 +1,93 @@
+#include <criterion/criterion.h>
+#include <criterion/redirect.h>
+#include "cargs.h"
+#include <stdlib.h>
+#include <string.h>
+
+CARGS_OPTIONS(
+    scale_options,
+    HELP_OPTION(FLAGS(FLAG_EXIT)),
+    OPTION_INT('r', "replicas", HELP("Number of replicas")),
+    OPTION_ARRAY_STRING('t', "tags", HELP("Tags")),
+    POSITIONAL_STRING("service", HELP("Service"), FLAGS(FLAG_OPTIONAL))
+)
+
+CARGS_OPTIONS(
+    admin_options,
+    HELP_OPTION(FLAGS(FLAG_EXIT)),
+    OPTION_FLAG('v', "verbose", HELP("Verbose output")),
+    SUBCOMMAND("scale", scale_options, HELP("Scale a service"))
+)
+
+Test(parse_string, command_line)
+{
+    const char *line  = "scale --replicas 3 --tags 'a b' -t \"c \\\"d\\\"\" web\\ front";
+    cargs_t     cargs = cargs_init(admin_options, "admin", "1.0.0");
+
+    cr_assert_eq(cargs_parse_string(&cargs, line, strlen(line)), CARGS_SUCCESS);
+    cr_assert(cargs_is_set(cargs, "scale"));
+    cr_assert_eq(cargs_get(cargs, "scale.replicas").as_int, 3);
+    cr_assert_eq(cargs_count(cargs, "scale.tags"), 2);
+    cr_assert_str_eq(cargs_array_get(cargs, "scale.tags", 0).as_string, "a b");
+    cr_assert_str_eq(cargs_array_get(cargs, "scale.tags", 1).as_string, "c \"d\"");
+    cr_assert_str_eq(cargs_get(cargs, "scale.service").as_string, "web front",
+                     "The last token ends the command");
+    cargs_free(&cargs);
+}
+
+Test(parse_string, length_not_terminated)
+{
+    // Only the first length bytes are part of the command
+    const char line[] = "-v scale -r 12 ignored";
+    cargs_t    cargs  = cargs_init(admin_options, "admin", "1.0.0");
+
+    cr_assert_eq(cargs_parse_string(&cargs, line, 14), CARGS_SUCCESS);
+    cr_assert(cargs_is_set(cargs, "verbose"));
+    cr_assert_eq(cargs_get(cargs, "scale.replicas").as_int, 12);
+    cr_assert_not(cargs_is_set(cargs, "scale.service"));
+    cr_assert_str_eq(line, "-v scale -r 12 ignored", "The command itself is left untouched");
+    cargs_free(&cargs);
+}
+
+Test(parse_string, buffer_reused)
+{
+    cargs_t cargs = cargs_init(admin_options, "admin", "1.0.0");
+
+    cr_assert_eq(cargs_parse_string(&cargs, "scale -r 1", 10), CARGS_SUCCESS);
+    char *buffer = cargs.line;
+    cargs_reset(&cargs);
+    cr_assert_eq(cargs_parse_string(&cargs, "scale -r 2 api", 14), CARGS_SUCCESS);
+    cr_assert_eq(cargs.line, buffer, "Short commands reuse the copy of the context");
+    cr_assert_eq(cargs_get(cargs, "scale.replicas").as_int, 2);
+    cr_assert_str_eq(cargs_get(cargs, "scale.service").as_string, "api");
+    cargs_free(&cargs);
+}
+
+Test(parse_string, caller_buffer)
+{
+    char    buffer[] = "scale -t x,y 'my service'";
+    cargs_t cargs    = cargs_init(admin_options, "admin", "1.0.0");
+
+    cr_assert_eq(cargs_parse_buffer(&cargs, buffer, strlen(buffer)), CARGS_SUCCESS);
+    cr_assert_null(cargs.line, "Nothing is copied");
+    const char *service = cargs_get(cargs, "scale.service").as_string;
+    cr_assert_str_eq(service, "my service");
+    cr_assert(service >= buffer && service < buffer + sizeof(buffer), "Values point into buffer");
+    cr_assert_eq(cargs_count(cargs, "scale.tags"), 2);
+    cargs_free(&cargs);
+}
+
+Test(parse_string, errors, .init = cr_redirect_stdout)
+{
+    cargs_t cargs = cargs_init(admin_options, "admin", "1.0.0");
+
+    cr_assert_eq(cargs_parse_string(&cargs, "scale -t 'open", 14), CARGS_ERROR_INVALID_FORMAT);
+    cargs_reset(&cargs);
+    cr_assert_eq(cargs_parse_string(&cargs, "scale -r", 8), CARGS_ERROR_MISSING_VALUE);
+    cargs_reset(&cargs);
+
+    // Response files are only read from the command line of the process
+    cr_assert_eq(cargs_parse_string(&cargs, "scale @/etc/hostname", 20), CARGS_SUCCESS);
+    cr_assert_str_eq(cargs_get(cargs, "scale.service").as_string, "@/etc/hostname");
+    cargs_free(&cargs);
+}
@@ -0,0 +1,129 @@
+#include <criterion/criterion.h>
+#include <criterion/redirect.h>
+#include "cargs.h"
+
+CARGS_OPTIONS(
+    deploy_options,
+    HELP_OPTION(FLAGS(FLAG_EXIT)),
+    OPTION_INT('r', "replicas", HELP("Number of replicas")),
+    OPTION_FLAG('f', "force", HELP("Force")),
+    POSITIONAL_STRING("service", HELP("Service"))
+)
+
+CARGS_OPTIONS(
+    push_options,
+    HELP_OPTION(FLAGS(FLAG_EXIT)),
+    OPTION_FLAG('v', "verbose", HELP("Verbose output")),
+    OPTION_STRING('o', "output", HELP("Output file")),
+    OPTION_ARRAY_INT('p', "ports", HELP("Ports")),
+    SUBCOMMAND("deploy", deploy_options, HELP("Deploy a service"))
+)
+
+// Subcommand missing its help option, checked when first entered
+CARGS_OPTIONS(
+    broken_options,
+    OPTION_FLAG('f', "force", HELP("Force"))
+)
+
+CARGS_OPTIONS(
+    lazy_options,
+    HELP_OPTION(FLAGS(FLAG_EXIT)),
+    SUBCOMMAND("broken", broken_options, HELP("Subcommand with invalid options"))
+)
+
+static int feed_all(cargs_parser_t *parser, char **tokens, size_t count)
+{
+    for (size_t i = 0; i < count; ++i) {
+        int status = cargs_parser_feed(parser, tokens[i]);
+        if (status != CARGS_SUCCESS)
+            return (status);
+    }
+    return (CARGS_SUCCESS);
+}
+
+Test(parser_push, same_result_as_cargs_parse)
+{
+    char *tokens[] = {"-vo", "out.txt", "--ports", "80,443", "-p8080", "deploy",
+                      "--replicas", "3", "-f", "--", "-web-"};
+    cargs_t        cargs = cargs_init(push_options, "program", "1.0.0");
+    cargs_parser_t parser;
+
+    cargs_parser_begin(&cargs, &parser);
+    // Interleaved with other work: one token per call, values arrive after their option
+    cr_assert_eq(feed_all(&parser, tokens, 11), CARGS_SUCCESS);
+    cr_assert_eq(cargs_parser_end(&parser), CARGS_SUCCESS);
+
+    cr_assert(cargs_is_set(cargs, "verbose"));
+    cr_assert_str_eq(cargs_get(cargs, "output").as_string, "out.txt");
+    cr_assert_eq(cargs_count(cargs, "ports"), 3);
+    cr_assert_eq(cargs_array_get(cargs, "ports", 2).as_int, 8080);
+    cr_assert_eq(cargs_get(cargs, "deploy.replicas").as_int, 3);
+    cr_assert(cargs_is_set(cargs, "deploy.force"));
+    cr_assert_str_eq(cargs_get(cargs, "deploy.service").as_string, "-web-");
+
+    // The context is reused for the next command
+    cargs_reset(&cargs);
+    char *next[] = {"deploy", "api"};
+    cargs_parser_begin(&cargs, &parser);
+    cr_assert_eq(feed_all(&parser, next, 2), CARGS_SUCCESS);
+    cr_assert_eq(cargs_parser_end(&parser), CARGS_SUCCESS);
+    cr_assert_str_eq(cargs_get(cargs, "deploy.service").as_string, "api");
+    cr_assert_not(cargs_is_set(cargs, "verbose"));
+    cargs_free(&cargs);
+}
+
+Test(parser_push, missing_value)
+{
+    cargs_t        cargs = cargs_init(push_options, "program", "1.0.0");
+    cargs_parser_t parser;
+
+    cargs_parser_begin(&cargs, &parser);
+    cr_assert_eq(cargs_parser_feed(&parser, "-v"), CARGS_SUCCESS);
+    cr_assert_eq(cargs_parser_feed(&parser, "--output"), CARGS_SUCCESS,
+                 "The value may come with the next token");
+    cr_assert_eq(cargs_parser_end(&parser), CARGS_ERROR_MISSING_VALUE);
+    cargs_free(&cargs);
+}
+
+Test(parser_push, failures_are_kept)
+{
+    cargs_t        cargs = cargs_init(push_options, "program", "1.0.0");
+    cargs_parser_t parser;
+
+    cargs_parser_begin(&cargs, &parser);
+    cr_assert_eq(cargs_parser_feed(&parser, "--unknown"), CARGS_ERROR_INVALID_ARGUMENT);
+    cr_assert_eq(cargs_parser_feed(&parser, "-v"), CARGS_ERROR_INVALID_ARGUMENT);
+    cr_assert_not(cargs_is_set(cargs, "verbose"), "Tokens after a failure are ignored");
+    cr_assert_eq(cargs_parser_end(&parser), CARGS_ERROR_INVALID_ARGUMENT);
+    cargs_free(&cargs);
+
+    // Validation still runs at the end: the service is required
+    cargs = cargs_init(push_options, "program", "1.0.0");
+    cargs_parser_begin(&cargs, &parser);
+    cr_assert_eq(cargs_parser_feed(&parser, "deploy"), CARGS_SUCCESS);
+    cr_assert_neq(cargs_parser_end(&parser), CARGS_SUCCESS);
+    cargs_free(&cargs);
+}
+
+Test(parser_push, help_does_not_exit, .init = cr_redirect_stdout)
+{
+    cargs_t        cargs = cargs_init(push_options, "program", "1.0.0");
+    cargs_parser_t parser;
+
+    cargs_parser_begin(&cargs, &parser);
+    cr_assert_eq(cargs_parser_feed(&parser, "--help"), CARGS_SOULD_EXIT);
+    cr_assert_eq(cargs_parser_end(&parser), CARGS_SOULD_EXIT);
+    cargs_free(&cargs);
+}
+
+Test(parser_push, invalid_subcommand_does_not_exit, .init = cr_redirect_stderr)
+{
+    cargs_t        cargs = cargs_init(lazy_options, "program", "1.0.0");
+    cargs_parser_t parser;
+
+    cargs_parser_begin(&cargs, &parser);
+    cr_assert_eq(cargs_parser_feed(&parser, "broken"), CARGS_ERROR_MISSING_HELP);
+    cr_assert_eq(cargs_parser_feed(&parser, "--force"), CARGS_ERROR_MISSING_HELP);
+    cr_assert_eq(cargs_parser_end(&parser), CARGS_ERROR_MISSING_HELP);
+    cargs_free(&cargs);
+}
@@ -0,0 +1,171 @@
+#include <criterion/criterion.h>
+#include <criterion/redirect.h>
+#include "cargs.h"
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+CARGS_OPTIONS(
+    build_options,
+    HELP_OPTION(FLAGS(FLAG_EXIT)),
+    OPTION_INT('j', "jobs", HELP("Parallel jobs"))
+)
+
+CARGS_OPTIONS(
+    response_options,
+    HELP_OPTION(FLAGS(FLAG_EXIT)),
+    OPTION_FLAG('v', "verbose", HELP("Verbose output")),
+    OPTION_STRING('o', "output", HELP("Output file")),
+    OPTION_INT('c', "count", HELP("Count value")),
+    OPTION_ARRAY_STRING('D', "define", HELP("Definitions")),
+    POSITIONAL_STRING("input", HELP("Input file"), FLAGS(FLAG_OPTIONAL)),
+    SUBCOMMAND("build", build_options, HELP("Build"))
+)
+
+// Write a response file, arg receives "@<path>"
+static void write_response(char *path, char *arg, const char *text)
+{
+    strcpy(path, "/tmp/cargs_rsp_XXXXXX");
+    int fd = mkstemp(path);
+    cr_assert_geq(fd, 0);
+    cr_assert_eq(write(fd, text, strlen(text)), (ssize_t)strlen(text));
+    close(fd);
+    sprintf(arg, "@%s", path);
+}
+
+Test(response_files, expanded_in_place)
+{
+    char path[64], arg[80];
+    write_response(path, arg, "-v --output 'my file.txt'\n-D \"A=1 2\" -DB=3\n--count 42");
+
+    char   *argv[] = {"program", "-D", "first", arg, "input.txt"};
+    cargs_t cargs  = cargs_init(response_options, "program", "1.0.0");
+    cargs.response_files = true;
+    cr_assert_eq(cargs_parse(&cargs, 5, argv), CARGS_SUCCESS);
+
+    cr_assert(cargs_is_set(cargs, "verbose"));
+    cr_assert_str_eq(cargs_get(cargs, "output").as_string, "my file.txt");
+    cr_assert_eq(cargs_get(cargs, "count").as_int, 42, "The last token may have no newline");
+    cr_assert_eq(cargs_count(cargs, "define"), 3);
+    cr_assert_str_eq(cargs_array_get(cargs, "define", 1).as_string, "A=1 2");
+    cr_assert_str_eq(cargs_array_get(cargs, "define", 2).as_string, "B=3");
+    cr_assert_str_eq(cargs_get(cargs, "input").as_string, "input.txt",
+                     "Arguments after the file follow its tokens");
+
+    // A new parse after a reset maps the file again
+    cargs_reset(&cargs);
+    char *again[] = {"program", arg};
+    cr_assert_eq(cargs_parse(&cargs, 2, again), CARGS_SUCCESS);
+    cr_assert_str_eq(cargs_get(cargs, "output").as_string, "my file.txt");
+    cargs_free(&cargs);
+    unlink(path);
+}
+
+Test(response_files, nested_and_subcommands)
+{
+    char inner[64], inner_arg[80], outer[64], outer_arg[80], text[128];
+    write_response(inner, inner_arg, "build --jobs=8\n");
+    sprintf(text, "-c 1 %s", inner_arg);
+    write_response(outer, outer_arg, text);
+
+    char   *argv[] = {"program", outer_arg};
+    cargs_t cargs  = cargs_init(response_options, "program", "1.0.0");
+    cargs.response_files = true;
+    cr_assert_eq(cargs_parse(&cargs, 2, argv), CARGS_SUCCESS);
+    cr_assert_eq(cargs_get(cargs, "count").as_int, 1);
+    cr_assert(cargs_is_set(cargs, "build"));
+    cr_assert_eq(cargs_get(cargs, "build.jobs").as_int, 8);
+    cargs_free(&cargs);
+    unlink(inner);
+    unlink(outer);
+}
+
+Test(response_files, kept_as_arguments)
+{
+    char path[64], arg[80];
+    write_response(path, arg, "-v");
+
+    // Missing files, directories, option values and arguments after "--" are not expanded
+    char   *missing[] = {"program", "@/nonexistent/args.rsp"};
+    cargs_t cargs     = cargs_init(response_options, "program", "1.0.0");
+    cargs.response_files = true;
+    cr_assert_eq(cargs_parse(&cargs, 2, missing), CARGS_SUCCESS);
+    cr_assert_str_eq(cargs_get(cargs, "input").as_string, "@/nonexistent/args.rsp");
+    cargs_free(&cargs);
+
+    char *directory[] = {"program", "@/tmp"};
+    cargs             = cargs_init(response_options, "program", "1.0.0");
+    cargs.response_files = true;
+    cr_assert_eq(cargs_parse(&cargs, 2, directory), CARGS_SUCCESS);
+    cr_assert_str_eq(cargs_get(cargs, "input").as_string, "@/tmp");
+    cargs_free(&cargs);
+
+    char *value[] = {"program", "--output", arg, "--", arg};
+    cargs         = cargs_init(response_options, "program", "1.0.0");
+    cargs.response_files = true;
+    cr_assert_eq(cargs_parse(&cargs, 5, value), CARGS_SUCCESS);
+    cr_assert_str_eq(cargs_get(cargs, "output").as_string, arg);
+    cr_assert_str_eq(cargs_get(cargs, "input").as_string, arg);
+    cr_assert_not(cargs_is_set(cargs, "verbose"));
+    cargs_free(&cargs);
+    unlink(path);
+}
+
+Test(response_files, errors, .init = cr_redirect_stdout)
+{
+    char path[64], arg[80], text[128];
+
+    // A file that includes itself stops at the depth limit
+    write_response(path, arg, "");
+    sprintf(text, "-v %s", arg);
+    FILE *file = fopen(path, "w");
+    cr_assert_not_null(file);
+    fputs(text, file);
+    fclose(file);
+
+    char   *argv[] = {"program", arg};
+    cargs_t cargs  = cargs_init(response_options, "program", "1.0.0");
+    cargs.response_files = true;
+    cr_assert_eq(cargs_parse(&cargs, 2, argv), CARGS_ERROR_INVALID_ARGUMENT);
+    cargs_free(&cargs);
+
+    file = fopen(path, "w");
+    cr_assert_not_null(file);
+    fputs("--output 'unterminated", file);
+    fclose(file);
+    cargs = cargs_init(response_options, "program", "1.0.0");
+    cargs.response_files = true;
+    cr_assert_eq(cargs_parse(&cargs, 2, argv), CARGS_ERROR_INVALID_FORMAT);
+    cargs_free(&cargs);
+    unlink(path);
+}
+
+Test(response_files, off_by_default)
+{
+    char path[64], arg[80];
+    write_response(path, arg, "-v");
+
+    char   *argv[] = {"program", arg};
+    cargs_t cargs  = cargs_init(response_options, "program", "1.0.0");
+    cr_assert_eq(cargs_parse(&cargs, 2, argv), CARGS_SUCCESS);
+    cr_assert_str_eq(cargs_get(cargs, "input").as_string, arg, "The file is not read");
+    cr_assert_not(cargs_is_set(cargs, "verbose"));
+    cargs_free(&cargs);
+
+    char *escaped[] = {"program", "@@user"};
+    cargs           = cargs_init(response_options, "program", "1.0.0");
+    cr_assert_eq(cargs_parse(&cargs, 2, escaped), CARGS_SUCCESS);
+    cr_assert_str_eq(cargs_get(cargs, "input").as_string, "@@user", "Nothing is unescaped");
+    cargs_free(&cargs);
+    unlink(path);
+}
+
+Test(response_files, escaped_arguments)
+{
+    char   *argv[] = {"program", "@@user"};
+    cargs_t cargs  = cargs_init(response_options, "program", "1.0.0");
+    cargs.response_files = true;
+    cr_assert_eq(cargs_parse(&cargs, 2, argv), CARGS_SUCCESS);
+    cr_assert_str_eq(cargs_get(cargs, "input").as_string, "@user");
+    cargs_free(&cargs);
+}
@@ -1,4 +1,5 @@
 #include <criterion/criterion.h>
+#include <criterion/redirect.h>
 #include "cargs/types.h"
 #include "cargs/errors.h"
 #include "cargs/internal/utils.h"
@@ -31,6 +32,18 @@ CARGS_OPTIONS(
                HELP("Subcommand"))
 )
 
+// Subcommand missing its help option
+CARGS_OPTIONS(
+    broken_sub_options,
+    OPTION_FLAG('f', "force", HELP("Force"))
+)
+
+CARGS_OPTIONS(
+    broken_cmd_options,
+    HELP_OPTION(FLAGS(FLAG_EXIT)),
+    SUBCOMMAND("broken", broken_sub_options, HELP("Broken subcommand"))
+)
+
 // Cargs context for tests
 static cargs_t test_cargs;
 
@@ -50,15 +63,25 @@ void setup_subcmd_parsing(void)
     context_init(&test_cargs);
 }
 
+void setup_broken_parsing(void)
+{
+    test_cargs.program_name = "test_program";
+    test_cargs.options = broken_cmd_options;
+    test_cargs.error_stack.count = 0;
+    context_init(&test_cargs);
+}
+
 // Test for handle_long_option
 Test(parsing, handle_long_option, .init = setup_parsing)
 {
     char *argv[] = {"--output=test.txt"};
     int argc = sizeof(argv) / sizeof(char *);
-    int current_index = 0;
+    cargs_tokens_t tokens;
+    tokens_init(&tokens, argc, argv);
+    tokens.index = 0;
     
     // Handle long option with value
-    int result = handle_long_option(&test_cargs, parse_options, "output=test.txt", argv, argc, &current_index);
+    int result = handle_long_option(&test_cargs, parse_options, "output=test.txt", &tokens);
     
     cr_assert_eq(result, CARGS_SUCCESS, "Long option with value should be handled successfully");
     cr_assert_eq(test_cargs.error_stack.count, 0, "No errors should be reported");
@@ -74,14 +97,16 @@ Test(parsing, handle_short_option, .init = setup_parsing)
 {
     char *argv[] = {"program", "-o", "test.txt"};
     int argc = sizeof(argv) / sizeof(char *);
-    int current_index = 1;
+    cargs_tokens_t tokens;
+    tokens_init(&tokens, argc, argv);
+    tokens.index = 1;
     
     // Handle short option with value
-    int result = handle_short_option(&test_cargs, parse_options, "o", argv, argc, &current_index);
+    int result = handle_short_option(&test_cargs, parse_options, "o", &tokens);
     
     cr_assert_eq(result, CARGS_SUCCESS, "Short option with value should be handled successfully");
     cr_assert_eq(test_cargs.error_stack.count, 0, "No errors should be reported");
-    cr_assert_eq(current_index, 2, "Index should be advanced to next argument");
+    cr_assert_eq(tokens.index, 2, "Index should be advanced to next argument");
     
     // Verify that option was correctly set
     cargs_option_t *option = find_option_by_name(parse_options, "output");
@@ -108,29 +133,46 @@ Test(parsing, handle_positional, .init = setup_parsing)
     cr_assert_neq(result, CARGS_SUCCESS, "Invalid positional index should fail");
 }
 
-// Test for handle_subcommand
-Test(parsing, handle_subcommand, .init = setup_subcmd_parsing)
+// Test for parse_token entering a subcommand
+Test(parsing, parse_token_subcommand, .init = setup_subcmd_parsing)
 {
-    char *argv[] = {"-d"};
-    int argc = sizeof(argv) / sizeof(char *);
-    
+    cargs_parser_t state = {._cargs = &test_cargs, ._options = cmd_options};
+    char           sub[] = "sub", debug[] = "-d";
+    cargs_tokens_t tokens;
+    tokens_init(&tokens, 0, NULL);
+
     // Find subcommand to use
     cargs_option_t *subcmd = find_subcommand(cmd_options, "sub");
     cr_assert_not_null(subcmd, "Subcommand should exist");
-    
-    // Handle subcommand
-    int result = handle_subcommand(&test_cargs, subcmd, argc, argv);
-    
+
+    // The state moves to the subcommand level instead of recursing
+    int result = parse_token(&state, sub, &tokens);
     cr_assert_eq(result, CARGS_SUCCESS, "Subcommand should be handled successfully");
+    cr_assert_eq(state._options, sub_parse_options, "State should use the subcommand options");
+    cr_assert_eq(state._positional_index, 0, "Positional index should restart");
     cr_assert_eq(test_cargs.error_stack.count, 0, "No errors should be reported");
     cr_assert_eq(test_cargs.context.subcommand_depth, 1, "Subcommand depth should be 1");
     cr_assert_eq(test_cargs.context.subcommand_stack[0], subcmd, "Subcommand should be on the stack");
-    
-    // Verify that subcommand option was set
+
+    // Following tokens belong to the subcommand
+    result = parse_token(&state, debug, &tokens);
+    cr_assert_eq(result, CARGS_SUCCESS, "Subcommand option should be handled successfully");
     cargs_option_t *debug_option = find_option_by_name(sub_parse_options, "debug");
     cr_assert_eq(debug_option->is_set, true, "Subcommand option should be set");
 }
 
+// Test for enter_subcommand with an invalid subcommand structure
+Test(parsing, enter_subcommand_invalid, .init = setup_broken_parsing)
+{
+    cargs_option_t *subcmd = find_subcommand(broken_cmd_options, "broken");
+    cr_assert_not_null(subcmd, "Subcommand should exist");
+
+    cr_redirect_stderr();
+    int result = enter_subcommand(&test_cargs, subcmd);
+    cr_assert_eq(result, CARGS_ERROR_MISSING_HELP, "The structure error should be returned");
+    cr_assert_gt(test_cargs.error_stack.count, 0, "Errors should be in the error stack");
+}
+
 // Simple test for parse_args
 Test(parsing, parse_args_basic, .init = setup_parsing)
 {
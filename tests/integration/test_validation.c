@@ -1,4 +1,5 @@
 #include <criterion/criterion.h>
+#include <criterion/redirect.h>
 #include "cargs/types.h"
 #include "cargs/errors.h"
 #include "cargs/internal/utils.h"
@@ -34,6 +35,33 @@ CARGS_OPTIONS(
     OPTION_STRING('v', "verbose", HELP("Duplicate option")) // Same name and same short option
 )
 
+CARGS_OPTIONS(
+    scattered_duplicate_options, // Intentionally invalid, duplicates far apart
+    HELP_OPTION(FLAGS(FLAG_EXIT)),
+    OPTION_FLAG('a', "alpha", HELP("Alpha")),
+    OPTION_FLAG('b', "beta", HELP("Beta")),
+    OPTION_FLAG('a', "gamma", HELP("Same short name as alpha")),
+    OPTION_FLAG('c', "alpha", HELP("Same name as alpha")),
+    POSITIONAL_STRING("beta", HELP("Same name as an option of another type"))
+)
+
+CARGS_OPTIONS(
+    broken_nested_options, // Intentionally invalid, no help option
+    OPTION_FLAG('f', "force", HELP("Force"))
+)
+
+CARGS_OPTIONS(
+    broken_sub_options,
+    HELP_OPTION(FLAGS(FLAG_EXIT)),
+    SUBCOMMAND("nested", broken_nested_options, HELP("Nested subcommand"))
+)
+
+CARGS_OPTIONS(
+    broken_tree_options,
+    HELP_OPTION(FLAGS(FLAG_EXIT)),
+    SUBCOMMAND("sub", broken_sub_options, HELP("Subcommand"))
+)
+
 // Contexte cargs pour les tests
 static cargs_t test_cargs;
 
@@ -188,6 +216,25 @@ Test(validation, validate_duplicate_options, .init = setup_validation)
     cr_assert_gt(test_cargs.error_stack.count, 0, "Errors should be reported");
 }
 
+// Test that every duplicated pair is reported once, in declaration order
+Test(validation, validate_scattered_duplicates, .init = setup_validation)
+{
+    int result = validate_structure(&test_cargs, scattered_duplicate_options);
+    cr_assert_eq(result, CARGS_ERROR_DUPLICATE_OPTION, "Duplicates should fail validation");
+    cr_assert_eq(test_cargs.error_stack.count, 3, "One error per duplicated field");
+    cr_assert_str_eq(test_cargs.error_stack.errors[0].message, "a: Short name must be unique");
+    cr_assert_str_eq(test_cargs.error_stack.errors[1].message, "alpha: Name must be unique");
+    cr_assert_str_eq(test_cargs.error_stack.errors[2].message, "alpha: Long name must be unique");
+}
+
+// Test that schema validation reaches every subcommand level
+Test(validation, validate_schema_tree, .init = cr_redirect_stderr)
+{
+    cr_assert_eq(cargs_validate_schema(valid_options, "test_program"), CARGS_SUCCESS);
+    cr_assert_eq(cargs_validate_schema(broken_tree_options, "test_program"),
+                 CARGS_ERROR_MISSING_HELP, "Errors in nested subcommands should be found");
+}
+
 // Test for validating a option without a helper
 Test(validation, validate_option_without_help, .init = setup_validation)
 {
@@ -230,3 +277,71 @@ Test(validation, validate_option_without_help, .init = setup_validation)
     cr_assert_neq(result, CARGS_SUCCESS, "Subcommand without help should fail validation");
     cr_assert_gt(test_cargs.error_stack.count, 0, "Errors should be reported");
 }
+
+// Test for validating the destination of a bound option
+Test(validation, validate_binding, .init = setup_validation)
+{
+    struct bound_s
+    {
+        int    count;
+        char   tag[3];
+        double ratio;
+    };
+
+    cargs_option_t option = {
+        .type = TYPE_OPTION,
+        .name = "count",
+        .lname = "count",
+        .help = "Count",
+        .value_type = VALUE_TYPE_INT,
+        .handler = int_handler,
+        BIND(struct bound_s, count)
+    };
+    cr_assert_eq(validate_option(&test_cargs, valid_options, &option), CARGS_SUCCESS,
+                 "An int bound to an int field should pass validation");
+
+    // String bound to a char array instead of a pointer
+    option.value_type = VALUE_TYPE_STRING;
+    option.handler = string_handler;
+    option.bind_offset = offsetof(struct bound_s, tag);
+    option.bind_size = sizeof(((struct bound_s *)0)->tag);
+    cr_assert_eq(validate_option(&test_cargs, valid_options, &option), CARGS_ERROR_MALFORMED_OPTION,
+                 "A string bound to a 3 bytes field should fail validation");
+    cr_assert_eq(test_cargs.error_stack.count, 1, "An error should be reported");
+
+    // Array options cannot be bound
+    cargs_option_t pos_option = {
+        .type = TYPE_POSITIONAL,
+        .name = "ratios",
+        .help = "Ratios",
+        .value_type = VALUE_TYPE_ARRAY_FLOAT,
+        .handler = string_handler,
+        .flags = FLAG_REQUIRED,
+        BIND(struct bound_s, ratio)
+    };
+    cr_assert_neq(validate_positional(&test_cargs, &pos_option), CARGS_SUCCESS,
+                  "An array bound to a field should fail validation");
+    cr_assert_eq(test_cargs.error_stack.count, 2, "An error should be reported");
+}
+
+// Test for validating the type of a packed option
+Test(validation, validate_packing, .init = setup_validation)
+{
+    cargs_option_t option = {
+        .type = TYPE_OPTION,
+        .name = "ids",
+        .lname = "ids",
+        .help = "Ids",
+        .value_type = VALUE_TYPE_ARRAY_INT,
+        .handler = array_int_handler,
+        .flags = FLAG_PACKED | FLAG_SORTED
+    };
+    cr_assert_eq(validate_option(&test_cargs, valid_options, &option), CARGS_SUCCESS,
+                 "An integer array can be packed");
+
+    option.value_type = VALUE_TYPE_ARRAY_STRING;
+    option.handler = array_string_handler;
+    cr_assert_eq(validate_option(&test_cargs, valid_options, &option), CARGS_ERROR_INVALID_FLAG,
+                 "A string array cannot be packed");
+    cr_assert_eq(test_cargs.error_stack.count, 1, "An error should be reported");
+}
@@ -5,6 +5,7 @@
 #include "cargs/errors.h"
 #include "cargs/internal/utils.h"
 #include "cargs/internal/callbacks/handlers.h"
+#include "cargs/internal/intern.h"
 #include <stdlib.h>
 #include <string.h>
 
@@ -213,9 +214,52 @@ Test(handlers, array_string_handler, .init = setup_handler)
     cr_assert_str_eq(test_option.value.as_array[1].as_string, "two", "Second element should be 'two'");
     cr_assert_str_eq(test_option.value.as_array[2].as_string, "three", "Third element should be 'three'");
     
-    // Free allocated memory
-    for (size_t i = 0; i < test_option.value_count; i++) {
-        free(test_option.value.as_array[i].as_string);
-    }
+    // Elements are packed into the chunks of the option, the free handler releases both
+    cr_assert_not_null(test_option.strings);
+    free_array_string_handler(&test_option);
+}
+
+// Test for array_string_handler packing words of several occurrences
+Test(handlers, array_string_handler_packed, .init = setup_handler)
+{
+    test_option.value_type = VALUE_TYPE_ARRAY_STRING;
+
+    char first[]  = ",on,,x86,";
+    char second[] = "eu-1";
+    char empty[]  = "";
+
+    cr_assert_eq(array_string_handler(&test_cargs, &test_option, first), CARGS_SUCCESS);
+    cr_assert_eq(array_string_handler(&test_cargs, &test_option, second), CARGS_SUCCESS);
+    cr_assert_eq(array_string_handler(&test_cargs, &test_option, empty), CARGS_SUCCESS);
+
+    cr_assert_eq(test_option.value_count, 4, "Empty words between commas are skipped");
+    cr_assert_str_eq(test_option.value.as_array[0].as_string, "on");
+    cr_assert_str_eq(test_option.value.as_array[1].as_string, "x86");
+    cr_assert_str_eq(test_option.value.as_array[2].as_string, "eu-1");
+    cr_assert_str_eq(test_option.value.as_array[3].as_string, "", "A lone empty value is kept");
+    cr_assert_eq(test_option.value.as_array[1].as_string, test_option.value.as_array[0].as_string + 3,
+                 "Short values are packed next to each other");
+    cr_assert_null(test_option.strings->next, "One chunk holds them all");
+    free_array_string_handler(&test_option);
+}
+
+// Test for array_int_handler with values beyond 32 bits
+Test(handlers, array_int_handler_wide_values, .init = setup_handler)
+{
+    test_option.value_type = VALUE_TYPE_ARRAY_INT;
+    test_option.value.as_array = NULL;
+    test_option.value_count = 0;
+    test_option.value_capacity = 0;
+
+    char test_value[] = "5000000000,-3,4294967296-4294967297";
+
+    int result = array_int_handler(&test_cargs, &test_option, test_value);
+    cr_assert_eq(result, CARGS_SUCCESS, "Array int handler should return success");
+    cr_assert_eq(test_option.value_count, 4, "Array should have 4 elements");
+    cr_assert_eq(test_option.value.as_array[0].as_int64, 5000000000LL, "Values are not truncated to int");
+    cr_assert_eq(test_option.value.as_array[1].as_int64, -3, "Negative values are stored on 64 bits");
+    cr_assert_eq(test_option.value.as_array[2].as_int64, 4294967296LL, "Range bounds are not truncated");
+    cr_assert_eq(test_option.value.as_array[3].as_int64, 4294967297LL);
+
     free(test_option.value.as_array);
 }
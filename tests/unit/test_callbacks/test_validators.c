@@ -1,4 +1,7 @@
 #include <criterion/criterion.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
 #include "cargs/types.h"
 #include "cargs/errors.h"
 #include "cargs/internal/utils.h"
@@ -9,6 +12,7 @@ int range_validator(cargs_t *cargs, cargs_option_t *option, validator_data_t dat
 int regex_validator(cargs_t *cargs, const char *value, validator_data_t data);
 int length_validator(cargs_t *cargs, cargs_option_t *option, validator_data_t data);
 int count_validator(cargs_t *cargs, cargs_option_t *option, validator_data_t data);
+int path_validator(cargs_t *cargs, cargs_option_t *option, validator_data_t data);
 
 // Mock cargs context for testing
 static cargs_t test_cargs;
@@ -27,9 +31,9 @@ Test(validators, range_validator_valid, .init = setup)
     cargs_option_t  option;
     
     // Valid cases
-    cargs_value_t val1 = {.as_int = 1};
-    cargs_value_t val2 = {.as_int = 50};
-    cargs_value_t val3 = {.as_int = 100};
+    cargs_value_t val1 = {.as_int64 = 1};
+    cargs_value_t val2 = {.as_int64 = 50};
+    cargs_value_t val3 = {.as_int64 = 100};
 
     option.value = val1;
     cr_assert_eq(range_validator(&test_cargs, &option, data), CARGS_SUCCESS, "Min value should be valid");
@@ -47,8 +51,8 @@ Test(validators, range_validator_invalid, .init = setup)
     cargs_option_t option;
     
     // Invalid cases
-    cargs_value_t val1 = {.as_int = 0};    // Below min
-    cargs_value_t val2 = {.as_int = 101};  // Above max
+    cargs_value_t val1 = {.as_int64 = 0};    // Below min
+    cargs_value_t val2 = {.as_int64 = 101};  // Above max
     
     option.value = val1;
     cr_assert_neq(range_validator(&test_cargs, &option, data), CARGS_SUCCESS, "Value below min should fail");
@@ -69,13 +73,13 @@ Test(validators, range_validator_equal_bounds, .init = setup)
     cargs_option_t option;
     
     // Valid case - matching the only valid value
-    cargs_value_t val1 = {.as_int = 42};
+    cargs_value_t val1 = {.as_int64 = 42};
     option.value = val1;
     cr_assert_eq(range_validator(&test_cargs, &option, data), CARGS_SUCCESS, "Equal bounds value should be valid");
     
     // Invalid cases
-    cargs_value_t val2 = {.as_int = 41};
-    cargs_value_t val3 = {.as_int = 43};
+    cargs_value_t val2 = {.as_int64 = 41};
+    cargs_value_t val3 = {.as_int64 = 43};
     
     option.value = val2;
     cr_assert_neq(range_validator(&test_cargs, &option, data), CARGS_SUCCESS, "Value below equal bounds should fail");
@@ -92,9 +96,9 @@ Test(validators, range_validator_negative_values, .init = setup)
     cargs_option_t option;
     
     // Valid cases
-    cargs_value_t val1 = {.as_int = -100};
-    cargs_value_t val2 = {.as_int = -50};
-    cargs_value_t val3 = {.as_int = -1};
+    cargs_value_t val1 = {.as_int64 = -100};
+    cargs_value_t val2 = {.as_int64 = -50};
+    cargs_value_t val3 = {.as_int64 = -1};
     
     option.value = val1;
     cr_assert_eq(range_validator(&test_cargs, &option, data), CARGS_SUCCESS, "Negative min should be valid");
@@ -106,8 +110,8 @@ Test(validators, range_validator_negative_values, .init = setup)
     cr_assert_eq(range_validator(&test_cargs, &option, data), CARGS_SUCCESS, "Negative max should be valid");
     
     // Invalid cases
-    cargs_value_t val4 = {.as_int = -101};
-    cargs_value_t val5 = {.as_int = 0};
+    cargs_value_t val4 = {.as_int64 = -101};
+    cargs_value_t val5 = {.as_int64 = 0};
     
     option.value = val4;
     cr_assert_neq(range_validator(&test_cargs, &option, data), CARGS_SUCCESS, "Value below negative min should fail");
@@ -318,3 +322,79 @@ Test(validators, count_validator_zero_allowed, .init = setup)
     option.value_count = 1;
     cr_assert_neq(count_validator(&test_cargs, &option, data2), CARGS_SUCCESS, "Below exact required count should fail");
 }
+
+Test(validators, path_validator_single, .init = setup)
+{
+    char path[] = "/tmp/cargs_path_XXXXXX";
+    int  fd     = mkstemp(path);
+    cr_assert_neq(fd, -1, "Temporary file should be created");
+    close(fd);
+
+    cargs_option_t option = {.value_type = VALUE_TYPE_STRING};
+
+    option.value.as_string = path;
+    cr_assert_eq(path_validator(&test_cargs, &option, (validator_data_t){.path = PATH_EXISTS | PATH_IS_FILE}),
+                 CARGS_SUCCESS, "Existing file should be valid");
+    cr_assert_neq(path_validator(&test_cargs, &option, (validator_data_t){.path = PATH_IS_DIR}),
+                  CARGS_SUCCESS, "File should not pass directory check");
+    cr_assert_eq(test_cargs.error_stack.count, 1, "Error should be reported for the file");
+
+    test_cargs.error_stack.count = 0;
+    option.value.as_string = "/tmp";
+    cr_assert_eq(path_validator(&test_cargs, &option, (validator_data_t){.path = PATH_IS_DIR | PATH_READABLE}),
+                 CARGS_SUCCESS, "Existing directory should be valid");
+
+    unlink(path);
+    option.value.as_string = path;
+    cr_assert_neq(path_validator(&test_cargs, &option, (validator_data_t){.path = PATH_EXISTS}),
+                  CARGS_SUCCESS, "Removed file should not exist");
+}
+
+Test(validators, path_validator_batch, .init = setup)
+{
+    // Enough paths to be spread over several workers
+    size_t         count  = 1000;
+    cargs_value_t *values = calloc(count, sizeof(cargs_value_t));
+    cr_assert_not_null(values, "Values should be allocated");
+
+    for (size_t i = 0; i < count; ++i)
+        values[i].as_string = "/tmp";
+    values[10].as_string  = "/nonexistent/cargs/first";
+    values[900].as_string = "/nonexistent/cargs/second";
+
+    cargs_option_t option = {
+        .value_type  = VALUE_TYPE_ARRAY_STRING,
+        .value       = {.as_array = values},
+        .value_count = count,
+    };
+
+    // Failures are reported on stderr, captured here to check their order
+    FILE *captured = tmpfile();
+    cr_assert_not_null(captured);
+    int saved = dup(STDERR_FILENO);
+    fflush(stderr);
+    dup2(fileno(captured), STDERR_FILENO);
+    int status = path_validator(&test_cargs, &option, (validator_data_t){.path = PATH_EXISTS});
+    fflush(stderr);
+    dup2(saved, STDERR_FILENO);
+    close(saved);
+
+    char output[256] = {0};
+    rewind(captured);
+    cr_assert_gt(fread(output, 1, sizeof(output) - 1, captured), 0);
+    fclose(captured);
+    cr_assert_neq(status, CARGS_SUCCESS, "Batch with missing paths should fail");
+    cr_assert_eq(test_cargs.error_stack.count, 2, "Every failing path should be reported");
+    cr_assert_str_eq(output,
+                     "test_prog: Path '/nonexistent/cargs/first' does not exist\n"
+                     "test_prog: Path '/nonexistent/cargs/second' does not exist\n",
+                     "Errors should be reported once each, in value order");
+
+    test_cargs.error_stack.count = 0;
+    values[10].as_string  = "/tmp";
+    values[900].as_string = "/tmp";
+    status = path_validator(&test_cargs, &option, (validator_data_t){.path = PATH_EXISTS | PATH_IS_DIR});
+    cr_assert_eq(status, CARGS_SUCCESS, "Batch of valid paths should pass");
+    cr_assert_eq(test_cargs.error_stack.count, 0, "No errors should be reported for valid paths");
+    free(values);
+}
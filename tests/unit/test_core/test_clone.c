@@ -0,0 +1,151 @@
+#include <criterion/criterion.h>
+#include <criterion/redirect.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "cargs.h"
+#include "cargs/internal/levels.h"
+
+CARGS_OPTIONS(
+    push_options,
+    HELP_OPTION(FLAGS(FLAG_EXIT)),
+    OPTION_INT('n', "count", HELP("Count")),
+    OPTION_FLAG('f', "force", HELP("Force"), REQUIRES("count"))
+)
+
+CARGS_OPTIONS(
+    clone_options,
+    HELP_OPTION(FLAGS(FLAG_EXIT)),
+    OPTION_STRING('o', "output", HELP("Output")),
+    OPTION_STRING('m', "mode", HELP("Mode"),
+                  CHOICES_STRING("fast", "safe", "slow", "auto", "none", "full", "lazy", "eager")),
+    OPTION_ARRAY_INT('l', "levels", HELP("Levels")),
+    SUBCOMMAND("push", push_options, HELP("Push"))
+)
+
+#define CLONE_THREADS    8
+#define CLONE_ITERATIONS 200
+
+typedef struct clone_job_s
+{
+    const void *schema;
+    size_t      schema_size;
+    int         id;
+    int         failures;
+} clone_job_t;
+
+static void *parse_in_thread(void *data)
+{
+    clone_job_t *job = data;
+
+    for (int i = 0; i < CLONE_ITERATIONS; ++i) {
+        char output[32], count[32], levels[32];
+        snprintf(output, sizeof(output), "--output=out-%d-%d", job->id, i);
+        snprintf(levels, sizeof(levels), "--levels=%d,%d", job->id, i);
+        snprintf(count, sizeof(count), "%d", job->id * 1000 + i);
+        char *argv[] = {"test", output, levels, "-m", "safe", "push", "--force", "-n", count};
+
+        cargs_option_t *options = cargs_options_clone(clone_options);
+        if (options == NULL) {
+            job->failures++;
+            continue;
+        }
+
+        cargs_t cargs = cargs_init_schema(options, "test", "1.0.0", job->schema, job->schema_size);
+        if (cargs_parse(&cargs, 9, argv) != CARGS_SUCCESS ||
+            strcmp(cargs_get(cargs, "output").as_string, output + 9) != 0 ||
+            cargs_array_get(cargs, "levels", 0).as_int != job->id ||
+            cargs_array_get(cargs, "levels", 1).as_int != i ||
+            cargs_get(cargs, "push.count").as_int != job->id * 1000 + i)
+            job->failures++;
+
+        cargs_free(&cargs);
+        cargs_options_destroy(options);
+    }
+    return (NULL);
+}
+
+Test(clone, copy_is_reset)
+{
+    char *argv[] = {"test", "--output=file", "push", "-n", "3"};
+
+    cargs_t cargs = cargs_init(clone_options, "test", "1.0.0");
+    cr_assert_eq(cargs_parse(&cargs, 5, argv), CARGS_SUCCESS);
+
+    cargs_option_t *options = cargs_options_clone(clone_options);
+    cr_assert_not_null(options);
+    cr_assert_not(options[1].is_set, "Parsed values are not copied");
+    cr_assert_null(options[1].value.as_string);
+    cr_assert_not(options[4].is_set);
+    cr_assert_eq(options[4].sub_options, push_options, "Subcommands are copied when entered");
+    cr_assert_eq(options[5].type, TYPE_NONE);
+
+    cargs_t        copy  = cargs_init(options, "test", "1.0.0");
+    cargs_handle_t count = cargs_resolve(&copy, "push.count");
+    cr_assert_neq(options[4].sub_options, push_options, "Resolving into push copies it");
+    cr_assert_eq(count._option, &options[4].sub_options[1]);
+    cr_assert_not(cargs_is_set_h(count), "The value parsed by the original is not seen");
+    cargs_free(&copy);
+
+    cr_assert_str_eq(cargs_get(cargs, "output").as_string, "file", "The original is untouched");
+    cr_assert_eq(cargs_get(cargs, "push.count").as_int, 3);
+    cargs_free(&cargs);
+    cargs_options_destroy(options);
+}
+
+Test(clone, contexts_are_independent)
+{
+    char *argv_a[] = {"test", "--output=a", "push", "-n", "1"};
+    char *argv_b[] = {"test", "--mode=fast"};
+
+    cargs_option_t *options_a = cargs_options_clone(clone_options);
+    cargs_option_t *options_b = cargs_options_clone(clone_options);
+    cr_assert(options_a && options_b);
+
+    cargs_t a = cargs_init(options_a, "test", "1.0.0");
+    cargs_t b = cargs_init(options_b, "test", "1.0.0");
+    cr_assert_eq(cargs_parse(&a, 5, argv_a), CARGS_SUCCESS);
+    cr_assert_eq(cargs_parse(&b, 2, argv_b), CARGS_SUCCESS);
+
+    cr_assert_neq(options_a[4].sub_options, push_options, "Entering push copies it");
+    cr_assert_eq(options_b[4].sub_options, push_options);
+    cr_assert_str_eq(cargs_get(a, "output").as_string, "a");
+    cr_assert_not(cargs_is_set(a, "mode"));
+    cr_assert_not(cargs_is_set(b, "output"));
+    cr_assert_str_eq(cargs_get(b, "mode").as_string, "fast");
+    cr_assert_not(clone_options[1].is_set);
+
+    cargs_free(&a);
+    cargs_free(&b);
+    cargs_options_destroy(options_a);
+    cargs_options_destroy(options_b);
+}
+
+Test(clone, concurrent_parses_share_schema)
+{
+    char path[] = "/tmp/cargs_clone_XXXXXX";
+    int  fd     = mkstemp(path);
+    cr_assert_geq(fd, 0);
+    close(fd);
+    cr_assert_eq(cargs_schema_save(clone_options, path), CARGS_SUCCESS);
+
+    size_t      size   = 0;
+    const void *schema = cargs_schema_map(path, &size);
+    cr_assert_not_null(schema);
+
+    pthread_t   threads[CLONE_THREADS];
+    clone_job_t jobs[CLONE_THREADS];
+    for (int i = 0; i < CLONE_THREADS; ++i) {
+        jobs[i] = (clone_job_t){.schema = schema, .schema_size = size, .id = i, .failures = 0};
+        cr_assert_eq(pthread_create(&threads[i], NULL, parse_in_thread, &jobs[i]), 0);
+    }
+    for (int i = 0; i < CLONE_THREADS; ++i) {
+        pthread_join(threads[i], NULL);
+        cr_assert_eq(jobs[i].failures, 0, "Thread %d saw %d wrong parses", i, jobs[i].failures);
+    }
+
+    cargs_schema_unmap(schema, size);
+    unlink(path);
+}
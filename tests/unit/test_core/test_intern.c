@@ -0,0 +1,122 @@
+#include <criterion/criterion.h>
+#include "cargs.h"
+#include "cargs/internal/intern.h"
+#include <stdio.h>
+#include <string.h>
+
+CARGS_OPTIONS(
+    intern_options,
+    HELP_OPTION(FLAGS(FLAG_EXIT)),
+    OPTION_MAP_STRING('e', "env", HELP("Environment")),
+    OPTION_MAP_INT('p', "ports", HELP("Ports"))
+)
+
+Test(intern, same_pointer_for_equal_strings)
+{
+    cargs_t cargs = cargs_init(intern_options, "test", "1.0.0");
+
+    const char *first  = intern_string(&cargs, "USER=me", 4);
+    const char *second = intern_string(&cargs, "USER", 4);
+    cr_assert_not_null(first);
+    cr_assert_str_eq(first, "USER");
+    cr_assert_eq(first, second, "Equal strings are stored once");
+    cr_assert_neq(intern_string(&cargs, "USE", 3), first);
+    cr_assert_eq(intern_find(&cargs, "USER"), first);
+    cr_assert_null(intern_find(&cargs, "HOME"), "Lookups never add strings");
+    cargs_free(&cargs);
+    cr_assert_null(cargs.keys);
+}
+
+Test(intern, empty_pool)
+{
+    cargs_t cargs = cargs_init(intern_options, "test", "1.0.0");
+
+    cr_assert_null(intern_find(&cargs, "key"));
+    cr_assert_null(intern_find(&cargs, NULL));
+    cargs_free(&cargs);
+}
+
+Test(intern, growth_keeps_pointers)
+{
+    cargs_t     cargs = cargs_init(intern_options, "test", "1.0.0");
+    const char *kept[200];
+    char        key[16];
+
+    for (int i = 0; i < 200; ++i) {
+        snprintf(key, sizeof(key), "key%d", i);
+        kept[i] = intern_string(&cargs, key, strlen(key));
+        cr_assert_not_null(kept[i]);
+    }
+    for (int i = 0; i < 200; ++i) {
+        snprintf(key, sizeof(key), "key%d", i);
+        cr_assert_str_eq(kept[i], key);
+        cr_assert_eq(intern_find(&cargs, key), kept[i], "Growing the table does not move strings");
+        cr_assert_eq(intern_string(&cargs, key, strlen(key)), kept[i]);
+    }
+    cargs_free(&cargs);
+}
+
+Test(intern, strings_larger_than_a_chunk)
+{
+    cargs_t cargs = cargs_init(intern_options, "test", "1.0.0");
+    size_t  size  = CARGS_INTERN_CHUNK_SIZE * 2;
+    char   *large = malloc(size + 1);
+
+    cr_assert_not_null(large);
+    memset(large, 'k', size);
+    large[size] = '\0';
+
+    const char *small    = intern_string(&cargs, "small", 5);
+    const char *interned = intern_string(&cargs, large, size);
+    cr_assert_not_null(interned);
+    cr_assert_eq(strlen(interned), size);
+    cr_assert_eq(intern_find(&cargs, large), interned);
+    cr_assert_eq(intern_find(&cargs, "small"), small);
+    free(large);
+    cargs_free(&cargs);
+}
+
+Test(intern, map_keys_shared_across_options)
+{
+    char *argv[] = {"test", "-e", "HOME=/root", "--ports=HOME=22", "-e", "HOME=/home", "-pssh=22"};
+    int   argc   = sizeof(argv) / sizeof(char *);
+
+    cargs_t cargs = cargs_init(intern_options, "test", "1.0.0");
+    cr_assert_eq(cargs_parse(&cargs, argc, argv), CARGS_SUCCESS);
+
+    const cargs_option_t *env   = &intern_options[1];
+    const cargs_option_t *ports = &intern_options[2];
+    cr_assert_eq(env->value_count, 1, "Repeated keys update the existing pair");
+    cr_assert_str_eq(env->value.as_map[0].value.as_string, "/home");
+    cr_assert_eq(env->value.as_map[0].key, ports->value.as_map[0].key,
+                 "Both maps point to the same interned key");
+    cr_assert_eq(cargs_map_get(cargs, "ports", "ssh").as_int, 22);
+    cr_assert_eq(cargs_map_get(cargs, "ports", "ftp").raw, 0);
+    cargs_free(&cargs);
+}
+
+Test(intern, reset_empties_the_pool)
+{
+    cargs_t cargs    = cargs_init(intern_options, "test", "1.0.0");
+    size_t  capacity = 0;
+    char    key[16];
+    char    pair[32];
+
+    for (int i = 0; i < 1000; ++i) {
+        snprintf(key, sizeof(key), "key%d", i);
+        snprintf(pair, sizeof(pair), "%s=value", key);
+        char *argv[] = {"test", "-e", pair};
+        cr_assert_eq(cargs_parse(&cargs, 3, argv), CARGS_SUCCESS);
+        cr_assert_str_eq(cargs_map_get(cargs, "env", key).as_string, "value");
+        cargs_reset(&cargs);
+
+        cr_assert_eq(cargs.keys->count, 0, "Reset forgets the keys of the last parse");
+        cr_assert_null(cargs.keys->chunks->next, "Only the current chunk is kept");
+        cr_assert_null(intern_find(&cargs, key));
+        if (i == 0)
+            capacity = cargs.keys->capacity;
+        cr_assert_eq(cargs.keys->capacity, capacity, "The table is kept and does not grow");
+    }
+    cr_assert_gt(capacity, 0);
+    cargs_free(&cargs);
+}
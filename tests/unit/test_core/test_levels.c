@@ -0,0 +1,312 @@
+#include <criterion/criterion.h>
+#include <criterion/redirect.h>
+#include "cargs.h"
+#include "cargs/internal/levels.h"
+
+CARGS_OPTIONS(
+    level_options,
+    HELP_OPTION(FLAGS(FLAG_EXIT)),
+    OPTION_STRING('r', "region", HELP("Region"),
+                  CHOICES_STRING("us-east-1", "us-east-2", "us-west-1", "us-west-2", "eu-west-1",
+                                 "eu-west-2", "eu-west-3", "eu-north-1", "eu-central-1",
+                                 "ap-south-1", "ap-northeast-1", "ap-southeast-1", "sa-east-1")),
+    OPTION_INT('p', "port", HELP("Port"),
+               CHOICES_INT(8080, -1, 443, 22, 80, 2147483647, 0, 8443, -2147483647, 3000)),
+    OPTION_FLOAT('s', "scale", HELP("Scale"), CHOICES_FLOAT(0.5, 1.0, 1.5, 2.0)),
+    OPTION_ARRAY_STRING('z', "zones", HELP("Zones"), CHOICES_STRING("a", "b", "c")),
+    OPTION_ARRAY_INT('n', "nodes", HELP("Nodes"),
+                     CHOICES_INT(1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12))
+)
+
+static void setup_error_capture(void)
+{
+    cr_redirect_stderr();
+}
+
+static int parse(cargs_t *cargs, char *arg)
+{
+    char *argv[] = {"test", arg};
+
+    *cargs = cargs_init(level_options, "test", "1.0.0");
+    return cargs_parse(cargs, 2, argv);
+}
+
+Test(levels, root_level_built_at_init)
+{
+    cargs_t cargs = cargs_init(level_options, "test", "1.0.0");
+    size_t  index = 0;
+
+    const cargs_level_t *level = level_of(&cargs, &level_options[2], &index);
+    cr_assert_not_null(level);
+    cr_assert_eq(index, 2);
+    cr_assert_eq(level->count, 6);
+    cr_assert_not_null(level->choice_offset);
+    cr_assert_neq(level->choice_offset[1], CARGS_NO_INDEX, "Large choice lists are indexed");
+    cr_assert_eq(level->choice_offset[3], CARGS_NO_INDEX, "Small choice lists are scanned");
+    cargs_free(&cargs);
+    cr_assert_null(cargs.levels);
+}
+
+Test(levels, string_choices_index)
+{
+    cargs_t cargs;
+
+    cr_assert_eq(parse(&cargs, "--region=eu-west-3"), CARGS_SUCCESS);
+    cr_assert_str_eq(cargs_get(cargs, "region").as_string, "eu-west-3");
+    cargs_free(&cargs);
+
+    cr_assert_eq(parse(&cargs, "--region=ap-south-1"), CARGS_SUCCESS);
+    cargs_free(&cargs);
+}
+
+Test(levels, string_choices_index_rejects, .init = setup_error_capture)
+{
+    cargs_t cargs;
+
+    cr_assert_eq(parse(&cargs, "--region=eu-west-4"), CARGS_ERROR_INVALID_CHOICE);
+    cargs_free(&cargs);
+}
+
+Test(levels, int_choices_index, .init = setup_error_capture)
+{
+    cargs_t cargs;
+
+    cr_assert_eq(parse(&cargs, "--port=-1"), CARGS_SUCCESS);
+    cargs_free(&cargs);
+    cr_assert_eq(parse(&cargs, "--port=2147483647"), CARGS_SUCCESS);
+    cargs_free(&cargs);
+    cr_assert_eq(parse(&cargs, "--port=-2147483647"), CARGS_SUCCESS);
+    cargs_free(&cargs);
+    cr_assert_eq(parse(&cargs, "--port=81"), CARGS_ERROR_INVALID_CHOICE);
+    cargs_free(&cargs);
+}
+
+Test(levels, float_choices, .init = setup_error_capture)
+{
+    cargs_t cargs;
+
+    cr_assert_eq(parse(&cargs, "--scale=1.5"), CARGS_SUCCESS);
+    cargs_free(&cargs);
+    cr_assert_eq(parse(&cargs, "--scale=3"), CARGS_ERROR_INVALID_CHOICE);
+    cargs_free(&cargs);
+}
+
+Test(levels, array_choices)
+{
+    cargs_t cargs;
+
+    cr_assert_eq(parse(&cargs, "--zones=a,c"), CARGS_SUCCESS);
+    cr_assert_eq(cargs_count(cargs, "zones"), 2);
+    cargs_free(&cargs);
+}
+
+Test(levels, array_choices_rejects, .init = setup_error_capture)
+{
+    cargs_t cargs;
+
+    cr_assert_eq(parse(&cargs, "--zones=a,d"), CARGS_ERROR_INVALID_CHOICE);
+    cargs_free(&cargs);
+}
+
+Test(levels, array_int_choices_index)
+{
+    cargs_t cargs;
+
+    cr_assert_eq(parse(&cargs, "--nodes=1,12,7"), CARGS_SUCCESS);
+    cargs_free(&cargs);
+}
+
+Test(levels, array_int_choices_index_rejects, .init = setup_error_capture)
+{
+    cargs_t cargs;
+
+    cr_assert_eq(parse(&cargs, "--nodes=1,13"), CARGS_ERROR_INVALID_CHOICE);
+    cargs_free(&cargs);
+}
+
+Test(levels, standalone_option_falls_back_to_scan)
+{
+    cargs_t        cargs  = {0};
+    cargs_option_t option = OPTION_STRING('x', "x", HELP("X"), CHOICES_STRING("one", "two"));
+
+    cr_assert(choices_contain(&cargs, &option, (cargs_value_t){.as_string = "two"}));
+    cr_assert_not(choices_contain(&cargs, &option, (cargs_value_t){.as_string = "three"}));
+}
+
+#define DEP_COUNT 150
+
+static char           dep_names[DEP_COUNT][8];
+static const char    *dep_requires[]  = {"f140", "f3", NULL};
+static const char    *dep_conflicts[] = {"f130", NULL};
+static cargs_option_t dep_options[DEP_COUNT + 2];
+
+CARGS_OPTIONS(
+    dep_help,
+    HELP_OPTION(FLAGS(FLAG_EXIT))
+)
+
+static void setup_dependencies(void)
+{
+    cr_redirect_stderr();
+    dep_options[0] = dep_help[0];
+    for (size_t i = 0; i < DEP_COUNT; ++i) {
+        snprintf(dep_names[i], sizeof(dep_names[i]), "f%zu", i);
+        dep_options[i + 1] = OPTION_FLAG('\0', dep_names[i], HELP("Flag"));
+    }
+    dep_options[1].requires    = dep_requires;
+    dep_options[2].conflicts   = dep_conflicts;
+    dep_options[DEP_COUNT + 1] = OPTION_END();
+}
+
+static int parse_dependencies(cargs_t *cargs, int argc, char **argv)
+{
+    *cargs = cargs_init(dep_options, "test", "1.0.0");
+    return cargs_parse(cargs, argc, argv);
+}
+
+Test(levels, dependencies_resolved_at_init, .init = setup_dependencies)
+{
+    cargs_t cargs = cargs_init(dep_options, "test", "1.0.0");
+    size_t  index = 0;
+
+    const cargs_level_t *level = level_of(&cargs, &dep_options[1], &index);
+    cr_assert_not_null(level);
+    cr_assert_eq(level->words, 3);
+    cr_assert_not_null(level->dep_slot);
+    cr_assert_eq(level->dep_slot[1], 0);
+    cr_assert_eq(level->dep_slot[2], 1);
+    cr_assert_eq(level->dep_slot[3], CARGS_NO_INDEX);
+    cr_assert_eq(level_find_option(&cargs, dep_options, "f140"), &dep_options[141]);
+    cr_assert_null(level_find_option(&cargs, dep_options, "f150"));
+    cargs_free(&cargs);
+}
+
+Test(levels, dependencies_required, .init = setup_dependencies)
+{
+    char   *argv[] = {"test", "--f0", "--f140", "--f3"};
+    cargs_t cargs;
+
+    cr_assert_eq(parse_dependencies(&cargs, 4, argv), CARGS_SUCCESS);
+    cargs_free(&cargs);
+}
+
+Test(levels, dependencies_required_missing, .init = setup_dependencies)
+{
+    char   *argv[] = {"test", "--f0", "--f3"};
+    cargs_t cargs;
+
+    cr_assert_eq(parse_dependencies(&cargs, 3, argv), CARGS_ERROR_MISSING_REQUIRED);
+    cargs_free(&cargs);
+}
+
+Test(levels, dependencies_conflict, .init = setup_dependencies)
+{
+    char   *argv[] = {"test", "--f1", "--f130"};
+    cargs_t cargs;
+
+    cr_assert_eq(parse_dependencies(&cargs, 3, argv), CARGS_ERROR_CONFLICTING_OPTIONS);
+    cargs_free(&cargs);
+}
+
+Test(levels, dependencies_no_conflict, .init = setup_dependencies)
+{
+    char   *argv[] = {"test", "--f1", "--f129"};
+    cargs_t cargs;
+
+    cr_assert_eq(parse_dependencies(&cargs, 3, argv), CARGS_SUCCESS);
+    cargs_free(&cargs);
+}
+
+CARGS_OPTIONS(
+    track_sub_options,
+    HELP_OPTION(FLAGS(FLAG_EXIT)),
+    OPTION_FLAG('f', "force", HELP("Force"))
+)
+
+CARGS_OPTIONS(
+    track_options,
+    HELP_OPTION(FLAGS(FLAG_EXIT)),
+    OPTION_FLAG('a', "alpha", HELP("Alpha")),
+    OPTION_FLAG('b', "beta", HELP("Beta")),
+    OPTION_FLAG('c', "gamma", HELP("Gamma")),
+    GROUP_START("Mode", GROUP_DESC("Mode"), FLAGS(FLAG_EXCLUSIVE)),
+        OPTION_FLAG('x', "fast", HELP("Fast")),
+        OPTION_FLAG('y', "slow", HELP("Slow")),
+    GROUP_END(),
+    SUBCOMMAND("run", track_sub_options, HELP("Run"))
+)
+
+static int parse_tracked(cargs_t *cargs, int argc, char **argv)
+{
+    *cargs = cargs_init(track_options, "test", "1.0.0");
+    return cargs_parse(cargs, argc, argv);
+}
+
+Test(levels, set_options_tracked)
+{
+    char   *argv[] = {"test", "-c", "-a"};
+    cargs_t cargs;
+    size_t  index = 0;
+
+    cr_assert_eq(parse_tracked(&cargs, 3, argv), CARGS_SUCCESS);
+    const cargs_level_t *level = level_of(&cargs, &track_options[1], &index);
+    cr_assert(level_tracks_set(level));
+    cr_assert_eq(level->touched_count, 2, "Only the options set are touched");
+    cr_assert_eq(level->touched[0], 3);
+    cr_assert_eq(level->touched[1], 1);
+    cr_assert(level->set_bits[0] & LEVEL_BIT_MASK(3));
+    cr_assert_not(level->set_bits[0] & LEVEL_BIT_MASK(2));
+    cargs_free(&cargs);
+}
+
+Test(levels, set_iterator_order)
+{
+    char          *argv[] = {"test", "--gamma", "-a", "run", "--force"};
+    const char    *names[] = {"gamma", "alpha", "run", "force"};
+    cargs_t        cargs;
+    cargs_set_it_t it;
+    size_t         count = 0;
+
+    cr_assert_eq(parse_tracked(&cargs, 5, argv), CARGS_SUCCESS);
+    it = cargs_set_it(cargs);
+    while (cargs_set_next(&it)) {
+        cr_assert_lt(count, 4);
+        cr_assert_str_eq(it.name, names[count]);
+        cr_assert(it.option->is_set);
+        count++;
+    }
+    cr_assert_eq(count, 4);
+
+    cargs_set_reset(&it);
+    cr_assert(cargs_set_next(&it));
+    cr_assert_str_eq(it.name, "gamma");
+    cargs_free(&cargs);
+}
+
+Test(levels, set_iterator_without_levels)
+{
+    cargs_t        cargs = {0};
+    cargs_set_it_t it    = cargs_set_it(cargs);
+
+    cr_assert_not(cargs_set_next(&it));
+}
+
+Test(levels, exclusive_group_tracked, .init = setup_error_capture)
+{
+    char   *argv[] = {"test", "--fast", "--slow"};
+    cargs_t cargs;
+
+    cr_assert_eq(parse_tracked(&cargs, 3, argv), CARGS_ERROR_EXCLUSIVE_GROUP);
+    cargs_free(&cargs);
+}
+
+Test(levels, exclusive_group_single_tracked)
+{
+    char   *argv[] = {"test", "--slow", "-b"};
+    cargs_t cargs;
+
+    cr_assert_eq(parse_tracked(&cargs, 3, argv), CARGS_SUCCESS);
+    cr_assert(cargs_is_set(cargs, "slow"));
+    cr_assert_not(cargs_is_set(cargs, "fast"));
+    cargs_free(&cargs);
+}
@@ -5,6 +5,7 @@
 #include <stdio.h>
 #include "cargs.h"
 #include "cargs/errors.h"
+#include "cargs/internal/levels.h"
 #include "cargs/internal/utils.h"
 
 // Valid options definition for testing
@@ -34,6 +35,19 @@ CARGS_OPTIONS(
     OPTION_STRING('v', "verbose", HELP("Duplicate option"))  // Same names
 )
 
+// Valid root options whose subcommand is invalid (missing help option)
+CARGS_OPTIONS(
+    broken_sub_options,
+    OPTION_FLAG('f', "force", HELP("Force"))
+)
+
+CARGS_OPTIONS(
+    lazy_options,
+    HELP_OPTION(FLAGS(FLAG_EXIT)),
+    OPTION_FLAG('v', "verbose", HELP("Verbose output")),
+    SUBCOMMAND("broken", broken_sub_options, HELP("Subcommand with invalid options"))
+)
+
 // Helper function for measuring initialization time
 double measure_init_time(cargs_option_t *options, const char *program_name, 
                          const char *version, int iterations) 
@@ -94,6 +108,18 @@ Test(release_mode, parse_works_correctly_with_valid_options)
     
     cargs_free(&cargs);
 }
+
+Test(release_mode, parse_skips_subcommand_validation)
+{
+    cargs_t cargs = cargs_init(lazy_options, "test_program", "1.0.0");
+    char   *argv[] = {"test_program", "broken", "--force"};
+
+    cr_assert_eq(cargs_parse(&cargs, 3, argv), CARGS_SUCCESS);
+    cr_assert(cargs_is_set(cargs, "broken.force"));
+    cr_assert_not_null(level_find(&cargs, broken_sub_options),
+                       "Release mode still builds the lookup indexes of the subcommand");
+    cargs_free(&cargs);
+}
 #else
 // In this test we expect the program to exit, so we don't need the assert_fail
 // The .exit_code attribute will handle the expected behavior
@@ -129,6 +155,29 @@ Test(release_mode, init_succeeds_with_valid_options)
     
     cargs_free(&cargs);
 }
+
+// Subcommand levels are only validated when parsing enters them
+Test(release_mode, init_defers_subcommand_validation)
+{
+    cargs_t cargs = cargs_init(lazy_options, "test_program", "1.0.0");
+    char   *argv[] = {"test_program", "--verbose"};
+
+    cr_assert_eq(cargs_parse(&cargs, 2, argv), CARGS_SUCCESS);
+    cr_assert_eq(cargs.error_stack.count, 0);
+    cargs_free(&cargs);
+}
+
+Test(release_mode, parse_validates_entered_subcommand, .init = cr_redirect_stderr)
+{
+    cargs_t cargs = cargs_init(lazy_options, "test_program", "1.0.0");
+    char   *argv[] = {"test_program", "broken", "--force"};
+
+    cr_redirect_stdout();
+    cr_assert_eq(cargs_parse(&cargs, 3, argv), CARGS_ERROR_MISSING_HELP,
+                 "The structure error is returned instead of exiting");
+    cr_assert_not(cargs_is_set(cargs, "broken.force"), "Parsing stops at the subcommand");
+    cargs_free(&cargs);
+}
 #endif
 
 // This test is always run and measures performance
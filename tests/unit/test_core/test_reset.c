@@ -0,0 +1,162 @@
+#include <criterion/criterion.h>
+#include <criterion/redirect.h>
+#include <stdlib.h>
+#include <string.h>
+#include "cargs.h"
+#include "cargs/internal/intern.h"
+#include "cargs/internal/levels.h"
+
+CARGS_OPTIONS(
+    push_options,
+    HELP_OPTION(FLAGS(FLAG_EXIT)),
+    OPTION_ARRAY_STRING('t', "tags", HELP("Tags")),
+    OPTION_FLAG('f', "force", HELP("Force"))
+)
+
+CARGS_OPTIONS(
+    reset_options,
+    HELP_OPTION(FLAGS(FLAG_EXIT)),
+    OPTION_STRING('o', "output", HELP("Output")),
+    OPTION_INT('n', "count", HELP("Count"), DEFAULT(5)),
+    OPTION_ARRAY_INT('p', "ports", HELP("Ports")),
+    OPTION_MAP_STRING('e', "env", HELP("Environment")),
+    OPTION_INT('l', "limit", HELP("Limit"), RANGE(1, 10)),
+    SUBCOMMAND("push", push_options, HELP("Push"))
+)
+
+static void setup_reset(void)
+{
+    cr_redirect_stdout();
+    cr_redirect_stderr();
+}
+
+Test(reset, values_and_stacks_cleared, .init = setup_reset)
+{
+    char *argv[] = {"test", "-o", "out", "-n", "9", "-p", "80", "-e", "k=v", "push", "-f",
+                    "-t", "a,b"};
+
+    cargs_t cargs = cargs_init(reset_options, "test", "1.0.0");
+    cr_assert_eq(cargs_parse(&cargs, 13, argv), CARGS_SUCCESS);
+    cr_assert(cargs_has_command(cargs));
+
+    cargs_reset(&cargs);
+    cr_assert_not(cargs_has_command(cargs), "The subcommand stack is emptied");
+    cr_assert_not(cargs_is_set(cargs, "output"));
+    cr_assert_null(cargs_get(cargs, "output").as_string);
+    cr_assert(cargs_is_set(cargs, "count"), "Options with a default stay set");
+    cr_assert_eq(cargs_get(cargs, "count").as_int, 5);
+    cr_assert_not(cargs_is_set(cargs, "ports"));
+    cr_assert_eq(cargs_count(cargs, "ports"), 0);
+    cr_assert_eq(cargs_count(cargs, "env"), 0);
+    cr_assert_not(reset_options[6].is_set);
+    cr_assert_not(push_options[1].is_set);
+    cr_assert_eq(push_options[1].value_count, 0);
+    cr_assert_not(push_options[2].is_set);
+
+    cargs_set_it_t it = cargs_set_it(cargs);
+    cr_assert(cargs_set_next(&it));
+    cr_assert_str_eq(it.name, "count", "Only defaults are left in the set options");
+    cr_assert_not(cargs_set_next(&it));
+    cargs_free(&cargs);
+}
+
+Test(reset, capacity_kept, .init = setup_reset)
+{
+    char *first[] = {"test", "-p", "1", "-p", "2", "-p", "3", "-p", "4", "-p", "5",
+                     "-p", "6", "-p", "7", "-p", "8", "-p", "9", "-p", "10"};
+    char *again[] = {"test", "-p", "30", "-p", "20", "--output=file"};
+
+    cargs_t cargs = cargs_init(reset_options, "test", "1.0.0");
+    cr_assert_eq(cargs_parse(&cargs, 21, first), CARGS_SUCCESS);
+    cr_assert_eq(cargs_count(cargs, "ports"), 10);
+
+    cargs_value_t *buffer   = reset_options[3].value.as_array;
+    size_t         capacity = reset_options[3].value_capacity;
+    cr_assert_gt(capacity, MULTI_VALUE_INITIAL_CAPACITY);
+
+    cargs_reset(&cargs);
+    cr_assert_eq(cargs_parse(&cargs, 6, again), CARGS_SUCCESS);
+    cr_assert_eq(reset_options[3].value.as_array, buffer, "The array buffer is reused");
+    cr_assert_eq(reset_options[3].value_capacity, capacity);
+    cr_assert_eq(cargs_count(cargs, "ports"), 2);
+    cr_assert_eq(cargs_array_get(cargs, "ports", 0).as_int, 30);
+    cr_assert_eq(cargs_array_get(cargs, "ports", 1).as_int, 20);
+    cr_assert_str_eq(cargs_get(cargs, "output").as_string, "file");
+    cargs_free(&cargs);
+}
+
+Test(reset, string_chunks_kept, .init = setup_reset)
+{
+    char *first[] = {"test", "-e", "HOME=/root", "-e", "HOME=/home", "--env=USER=me"};
+    char *again[] = {"test", "-e", "LANG=C"};
+
+    cargs_t cargs = cargs_init(reset_options, "test", "1.0.0");
+    cr_assert_eq(cargs_parse(&cargs, 6, first), CARGS_SUCCESS);
+    cr_assert_str_eq(cargs_map_get(cargs, "env", "HOME").as_string, "/home");
+
+    cargs_intern_chunk_t *chunk = reset_options[4].strings;
+    cr_assert_not_null(chunk);
+
+    cargs_reset(&cargs);
+    cr_assert_eq(cargs_parse(&cargs, 3, again), CARGS_SUCCESS);
+    cr_assert_eq(reset_options[4].strings, chunk, "The string chunk is reused");
+    cr_assert_eq(cargs_map_get(cargs, "env", "LANG").as_string, chunk->data,
+                 "Values are written from the start of the chunk again");
+    cr_assert_eq(cargs_count(cargs, "env"), 1);
+    cr_assert_str_eq(cargs_map_get(cargs, "env", "LANG").as_string, "C");
+    cargs_free(&cargs);
+    cr_assert_null(reset_options[4].strings);
+}
+
+Test(reset, errors_cleared, .init = setup_reset)
+{
+    char *bad[]  = {"test", "--limit=50"};
+    char *good[] = {"test", "--limit=5"};
+
+    cargs_t cargs = cargs_init(reset_options, "test", "1.0.0");
+    cr_assert_neq(cargs_parse(&cargs, 2, bad), CARGS_SUCCESS);
+    cr_assert_gt(cargs.error_stack.count, 0);
+
+    cargs_reset(&cargs);
+    cr_assert_eq(cargs.error_stack.count, 0);
+    cr_assert_eq(cargs_parse(&cargs, 2, good), CARGS_SUCCESS);
+    cr_assert_eq(cargs_get(cargs, "limit").as_int, 5);
+    cargs_free(&cargs);
+}
+
+Test(reset, subcommand_left_then_freed, .init = setup_reset)
+{
+    char *with_sub[]    = {"test", "push", "-t", "a,b,c"};
+    char *without_sub[] = {"test", "-o", "out"};
+
+    cargs_t cargs = cargs_init(reset_options, "test", "1.0.0");
+    cr_assert_eq(cargs_parse(&cargs, 4, with_sub), CARGS_SUCCESS);
+    cr_assert_eq(cargs_count(cargs, "push.tags"), 3);
+
+    cargs_reset(&cargs);
+    cr_assert_eq(cargs_parse(&cargs, 3, without_sub), CARGS_SUCCESS);
+    cr_assert_not(cargs_has_command(cargs));
+    cr_assert_not(push_options[1].is_set);
+
+    // The kept tags buffer is outside the subcommand stack, cargs_free still releases it
+    cr_assert(level_find(&cargs, push_options)->recycled);
+    cargs_free(&cargs);
+}
+
+Test(reset, repeated_parses, .init = setup_reset)
+{
+    cargs_t cargs = cargs_init(reset_options, "test", "1.0.0");
+
+    for (int i = 0; i < 100; ++i) {
+        char count[16];
+        snprintf(count, sizeof(count), "%d", i);
+        char *argv[] = {"test", "-n", count, "-e", "a=1,b=2", "push", "-t", "x"};
+
+        cr_assert_eq(cargs_parse(&cargs, 8, argv), CARGS_SUCCESS);
+        cr_assert_eq(cargs_get(cargs, "count").as_int, i);
+        cr_assert_eq(cargs_count(cargs, "env"), 2);
+        cr_assert_eq(cargs_count(cargs, "push.tags"), 1);
+        cargs_reset(&cargs);
+    }
+    cargs_free(&cargs);
+}
@@ -0,0 +1,183 @@
+#include <criterion/criterion.h>
+#include <criterion/redirect.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "cargs.h"
+#include "cargs/internal/levels.h"
+#include "cargs/internal/schema.h"
+
+CARGS_OPTIONS(
+    deploy_options,
+    HELP_OPTION(FLAGS(FLAG_EXIT)),
+    OPTION_FLAG('f', "force", HELP("Force"), REQUIRES("yes")),
+    OPTION_FLAG('y', "yes", HELP("Confirm"))
+)
+
+CARGS_OPTIONS(
+    schema_options,
+    HELP_OPTION(FLAGS(FLAG_EXIT)),
+    OPTION_STRING('r', "region", HELP("Region"),
+                  CHOICES_STRING("us-east-1", "us-east-2", "us-west-1", "us-west-2", "eu-west-1",
+                                 "eu-west-2", "eu-west-3", "eu-north-1", "eu-central-1")),
+    OPTION_FLAG('q', "quiet", HELP("Quiet"), CONFLICTS("verbose")),
+    OPTION_FLAG('v', "verbose", HELP("Verbose")),
+    SUBCOMMAND("deploy", deploy_options, HELP("Deploy"))
+)
+
+static char schema_path[] = "/tmp/cargs_schema_XXXXXX";
+
+static void setup_schema(void)
+{
+    cr_redirect_stderr();
+    int fd = mkstemp(schema_path);
+    cr_assert_geq(fd, 0);
+    close(fd);
+    cr_assert_eq(cargs_schema_save(schema_options, schema_path), CARGS_SUCCESS);
+}
+
+static void teardown_schema(void)
+{
+    unlink(schema_path);
+}
+
+Test(schema, levels_read_from_blob, .init = setup_schema, .fini = teardown_schema)
+{
+    size_t      size   = 0;
+    const void *schema = cargs_schema_map(schema_path, &size);
+    char       *argv[] = {"test", "--region=eu-west-3", "deploy", "--force", "--yes"};
+    size_t      index  = 0;
+
+    cr_assert_not_null(schema);
+    cargs_t cargs = cargs_init_schema(schema_options, "test", "1.0.0", schema, size);
+    cr_assert(level_of(&cargs, &schema_options[1], &index)->from_schema);
+
+    cr_assert_eq(cargs_parse(&cargs, 5, argv), CARGS_SUCCESS);
+    cr_assert_str_eq(cargs_get(cargs, "region").as_string, "eu-west-3");
+    cr_assert(cargs_is_set(cargs, "deploy.force"));
+    cr_assert(level_of(&cargs, &deploy_options[1], &index)->from_schema,
+              "Subcommand levels come from the blob too");
+    cargs_free(&cargs);
+    cargs_schema_unmap(schema, size);
+}
+
+Test(schema, blob_indexes_reject, .init = setup_schema, .fini = teardown_schema)
+{
+    size_t      size   = 0;
+    const void *schema = cargs_schema_map(schema_path, &size);
+    char       *argv[] = {"test", "--region=eu-west-4"};
+
+    cargs_t cargs = cargs_init_schema(schema_options, "test", "1.0.0", schema, size);
+    cr_assert_eq(cargs_parse(&cargs, 2, argv), CARGS_ERROR_INVALID_CHOICE);
+    cargs_free(&cargs);
+    cargs_schema_unmap(schema, size);
+}
+
+Test(schema, blob_dependencies, .init = setup_schema, .fini = teardown_schema)
+{
+    size_t      size   = 0;
+    const void *schema = cargs_schema_map(schema_path, &size);
+    char       *argv[] = {"test", "-q", "-v"};
+
+    cargs_t cargs = cargs_init_schema(schema_options, "test", "1.0.0", schema, size);
+    cr_assert_eq(cargs_parse(&cargs, 3, argv), CARGS_ERROR_CONFLICTING_OPTIONS);
+    cargs_free(&cargs);
+    cargs_schema_unmap(schema, size);
+}
+
+static uint64_t *read_schema(size_t *size)
+{
+    FILE *file = fopen(schema_path, "rb");
+    cr_assert_not_null(file);
+    fseek(file, 0, SEEK_END);
+    *size = ftell(file);
+    rewind(file);
+
+    uint64_t *blob = malloc(*size + sizeof(uint64_t));
+    cr_assert_eq(fread(blob, 1, *size, file), *size);
+    fclose(file);
+    return (blob);
+}
+
+Test(schema, embedded_blob, .init = setup_schema, .fini = teardown_schema)
+{
+    size_t    size = 0;
+    uint64_t *blob = read_schema(&size);
+
+    char   *argv[] = {"test", "deploy", "--force"};
+    size_t  index  = 0;
+    cargs_t cargs  = cargs_init_schema(schema_options, "test", "1.0.0", blob, size);
+
+    cr_assert(level_of(&cargs, &schema_options[1], &index)->from_schema);
+    cr_assert_eq(cargs_parse(&cargs, 3, argv), CARGS_ERROR_MISSING_REQUIRED);
+    cargs_free(&cargs);
+    free(blob);
+}
+
+Test(schema, changed_options_fall_back, .init = setup_schema, .fini = teardown_schema)
+{
+    size_t      size   = 0;
+    const void *schema = cargs_schema_map(schema_path, &size);
+    char       *argv[] = {"test", "--verbose"};
+    size_t      index  = 0;
+
+    schema_options[2].lname = "silent";
+    cargs_t cargs = cargs_init_schema(schema_options, "test", "1.0.0", schema, size);
+    const cargs_level_t *level = level_of(&cargs, &schema_options[1], &index);
+    cr_assert_not_null(level);
+    cr_assert_not(level->from_schema, "A stale blob must not be used");
+    cr_assert_eq(cargs_parse(&cargs, 2, argv), CARGS_SUCCESS);
+    cargs_free(&cargs);
+    cargs_schema_unmap(schema, size);
+}
+
+Test(schema, invalid_blob_falls_back, .init = setup_schema, .fini = teardown_schema)
+{
+    uint64_t garbage[16];
+    char    *argv[] = {"test", "--region=us-west-2"};
+    size_t   index  = 0;
+
+    memset(garbage, 0x5a, sizeof(garbage));
+    cargs_t cargs = cargs_init_schema(schema_options, "test", "1.0.0", garbage, sizeof(garbage));
+    cr_assert_not(level_of(&cargs, &schema_options[1], &index)->from_schema);
+    cr_assert_eq(cargs_parse(&cargs, 2, argv), CARGS_SUCCESS);
+    cargs_free(&cargs);
+}
+
+Test(schema, bad_indexes_fall_back, .init = setup_schema, .fini = teardown_schema)
+{
+    size_t    size   = 0;
+    uint64_t *blob   = read_schema(&size);
+    char     *argv[] = {"test", "--region=eu-west-3", "-q"};
+    size_t    index  = 0;
+
+    cargs_schema_level_t *root = (cargs_schema_level_t *)((cargs_schema_header_t *)blob + 1);
+    uint32_t             *order = (uint32_t *)((char *)blob + root->choice_order);
+    order[0] = 9;  // One past the choices of --region
+
+    cargs_t cargs = cargs_init_schema(schema_options, "test", "1.0.0", blob, size);
+    const cargs_level_t *level = level_of(&cargs, &schema_options[1], &index);
+    cr_assert_not_null(level);
+    cr_assert_not(level->from_schema, "Out of range indexes must not be trusted");
+    cr_assert_eq(cargs_parse(&cargs, 3, argv), CARGS_SUCCESS);
+    cargs_free(&cargs);
+    free(blob);
+}
+
+Test(schema, bad_subcommand_level_falls_back, .init = setup_schema, .fini = teardown_schema)
+{
+    size_t    size   = 0;
+    uint64_t *blob   = read_schema(&size);
+    char     *argv[] = {"test", "deploy", "--yes"};
+    size_t    index  = 0;
+
+    cargs_schema_level_t *root = (cargs_schema_level_t *)((cargs_schema_header_t *)blob + 1);
+    uint32_t             *subs = (uint32_t *)((char *)blob + root->sub_levels);
+    subs[4] = 2;  // The blob only holds the root and deploy levels
+
+    cargs_t cargs = cargs_init_schema(schema_options, "test", "1.0.0", blob, size);
+    cr_assert_not(level_of(&cargs, &schema_options[1], &index)->from_schema);
+    cr_assert_eq(cargs_parse(&cargs, 3, argv), CARGS_SUCCESS);
+    cargs_free(&cargs);
+    free(blob);
+}
@@ -0,0 +1,79 @@
+#include <criterion/criterion.h>
+#include "cargs/errors.h"
+#include "cargs/internal/tokens.h"
+#include <string.h>
+
+// Split text into at most max tokens, returns the number of tokens
+static size_t split_all(char *text, size_t size, char **tokens, size_t max)
+{
+    char  *cursor = text;
+    char  *token;
+    size_t length;
+    size_t count = 0;
+
+    while (count < max) {
+        cr_assert_eq(tokens_split(&cursor, text + size, &token, &length), CARGS_SUCCESS);
+        if (token == NULL)
+            break;
+        cr_assert_eq(strlen(token), length, "Token %zu is terminated in place", count);
+        tokens[count++] = token;
+    }
+    return (count);
+}
+
+Test(tokens, whitespace_and_quotes)
+{
+    char  text[] = "  -o out.txt\t--name 'a b'\n\"x \\\"y\\\"\" ''  last ";
+    char *tokens[8];
+
+    cr_assert_eq(split_all(text, sizeof(text) - 1, tokens, 8), 7);
+    cr_assert_str_eq(tokens[0], "-o");
+    cr_assert_str_eq(tokens[1], "out.txt");
+    cr_assert_str_eq(tokens[2], "--name");
+    cr_assert_str_eq(tokens[3], "a b");
+    cr_assert_str_eq(tokens[4], "x \"y\"");
+    cr_assert_str_eq(tokens[5], "", "Empty quotes give an empty token");
+    cr_assert_str_eq(tokens[6], "last");
+}
+
+Test(tokens, escapes)
+{
+    char  text[] = "a\\ b 'c\\d' \"e\\f\" pre'mid'\"post\" one\\\ntwo";
+    char *tokens[8];
+
+    cr_assert_eq(split_all(text, sizeof(text) - 1, tokens, 8), 5);
+    cr_assert_str_eq(tokens[0], "a b");
+    cr_assert_str_eq(tokens[1], "c\\d", "Single quotes keep backslashes");
+    cr_assert_str_eq(tokens[2], "e\\f", "Double quotes only escape a few characters");
+    cr_assert_str_eq(tokens[3], "premidpost");
+    cr_assert_str_eq(tokens[4], "onetwo", "Escaped newlines join lines");
+}
+
+Test(tokens, unterminated_quote)
+{
+    char   text[] = "ok 'not closed";
+    char  *cursor = text;
+    char  *token;
+    size_t length;
+
+    cr_assert_eq(tokens_split(&cursor, text + sizeof(text) - 1, &token, &length), CARGS_SUCCESS);
+    cr_assert_str_eq(token, "ok");
+    cr_assert_eq(tokens_split(&cursor, text + sizeof(text) - 1, &token, &length),
+                 CARGS_ERROR_INVALID_FORMAT);
+}
+
+Test(tokens, no_room_for_terminator)
+{
+    char   text[] = {'a', ' ', 'b', 'c'};
+    char  *cursor = text;
+    char  *token;
+    size_t length;
+
+    tokens_split(&cursor, text + 4, &token, &length);
+    cr_assert_str_eq(token, "a");
+    cr_assert_eq(tokens_split(&cursor, text + 4, &token, &length), CARGS_SUCCESS);
+    cr_assert_eq(token, &text[2]);
+    cr_assert_eq(length, 2, "The caller terminates a token ending on the last byte");
+    tokens_split(&cursor, text + 4, &token, &length);
+    cr_assert_null(token);
+}
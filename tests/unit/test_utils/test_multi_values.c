@@ -79,11 +79,11 @@ Test(multi_values, sort_int_array)
 {
     // Create an unsorted array
     cargs_value_t array[5] = {
-        {.as_int = 42},
-        {.as_int = 10},
-        {.as_int = 30},
-        {.as_int = 20},
-        {.as_int = 50}
+        {.as_int64 = 42},
+        {.as_int64 = 10},
+        {.as_int64 = 30},
+        {.as_int64 = 20},
+        {.as_int64 = 50}
     };
     
     // Sort the array
@@ -121,12 +121,12 @@ Test(multi_values, make_int_array_unique)
 {
     // Create an array with duplicates
     cargs_value_t array[6] = {
-        {.as_int = 10},
-        {.as_int = 20},
-        {.as_int = 10},  // Duplicate
-        {.as_int = 30},
-        {.as_int = 20},  // Duplicate
-        {.as_int = 40}
+        {.as_int64 = 10},
+        {.as_int64 = 20},
+        {.as_int64 = 10},  // Duplicate
+        {.as_int64 = 30},
+        {.as_int64 = 20},  // Duplicate
+        {.as_int64 = 40}
     };
     
     // Make the array unique
@@ -149,12 +149,12 @@ Test(multi_values, apply_array_flags)
     option.value_capacity = 6;
     option.value.as_array = malloc(option.value_capacity * sizeof(cargs_value_t));
     
-    option.value.as_array[0].as_int = 30;
-    option.value.as_array[1].as_int = 10;
-    option.value.as_array[2].as_int = 20;
-    option.value.as_array[3].as_int = 10;  // Duplicate
-    option.value.as_array[4].as_int = 30;  // Duplicate
-    option.value.as_array[5].as_int = 20;  // Duplicate
+    option.value.as_array[0].as_int64 = 30;
+    option.value.as_array[1].as_int64 = 10;
+    option.value.as_array[2].as_int64 = 20;
+    option.value.as_array[3].as_int64 = 10;  // Duplicate
+    option.value.as_array[4].as_int64 = 30;  // Duplicate
+    option.value.as_array[5].as_int64 = 20;  // Duplicate
     option.value_count = 6;
     
     // Test with sorting only
@@ -173,12 +173,12 @@ Test(multi_values, apply_array_flags)
     free(option.value.as_array);
     option.value.as_array = malloc(option.value_capacity * sizeof(cargs_value_t));
     
-    option.value.as_array[0].as_int = 30;
-    option.value.as_array[1].as_int = 10;
-    option.value.as_array[2].as_int = 20;
-    option.value.as_array[3].as_int = 10;
-    option.value.as_array[4].as_int = 30;
-    option.value.as_array[5].as_int = 20;
+    option.value.as_array[0].as_int64 = 30;
+    option.value.as_array[1].as_int64 = 10;
+    option.value.as_array[2].as_int64 = 20;
+    option.value.as_array[3].as_int64 = 10;
+    option.value.as_array[4].as_int64 = 30;
+    option.value.as_array[5].as_int64 = 20;
     option.value_count = 6;
     
     // Test with unique only
@@ -196,12 +196,12 @@ Test(multi_values, apply_array_flags)
     free(option.value.as_array);
     option.value.as_array = malloc(option.value_capacity * sizeof(cargs_value_t));
     
-    option.value.as_array[0].as_int = 30;
-    option.value.as_array[1].as_int = 10;
-    option.value.as_array[2].as_int = 20;
-    option.value.as_array[3].as_int = 10;
-    option.value.as_array[4].as_int = 30;
-    option.value.as_array[5].as_int = 20;
+    option.value.as_array[0].as_int64 = 30;
+    option.value.as_array[1].as_int64 = 10;
+    option.value.as_array[2].as_int64 = 20;
+    option.value.as_array[3].as_int64 = 10;
+    option.value.as_array[4].as_int64 = 30;
+    option.value.as_array[5].as_int64 = 20;
     option.value_count = 6;
     
     // Test with both sorted and unique
@@ -298,3 +298,54 @@ Test(multi_values, sort_map_by_keys)
     }
     free(option.value.as_map);
 }
+
+Test(multi_values, sorted_map_insertion)
+{
+    cargs_option_t option;
+    setup_map_option(&option, VALUE_TYPE_MAP_INT);
+    option.flags = FLAG_SORTED_KEY;
+
+    const char *keys[] = {"db.pool.size", "app.name", "db.pool.timeout", "db.host", "zeta",
+                          "db.pool", "db.poolx", "b"};
+    size_t count = sizeof(keys) / sizeof(keys[0]);
+
+    for (size_t i = 0; i < count; i++) {
+        size_t position = map_insert_key(&option, strdup(keys[i]));
+        option.value.as_map[position].value.as_int64 = (long long)i;
+    }
+
+    // Entries are kept sorted by key as they are inserted
+    cr_assert_eq(option.value_count, count, "Every key should be inserted");
+    for (size_t i = 1; i < option.value_count; i++)
+        cr_assert_lt(strcmp(option.value.as_map[i - 1].key, option.value.as_map[i].key), 0,
+                     "Keys should be sorted");
+
+    // Bisection finds every key, with its value
+    for (size_t i = 0; i < count; i++) {
+        int index = map_find_key(&option, keys[i]);
+        cr_assert_geq(index, 0, "Key '%s' should be found", keys[i]);
+        cr_assert_eq(option.value.as_map[index].value.as_int64, (long long)i);
+    }
+    cr_assert_eq(map_find_key(&option, "db"), -1, "Missing keys should not be found");
+    cr_assert_eq(map_find_key(&option, "zz"), -1, "Keys past the end should not be found");
+
+    // Keys with a prefix form one contiguous range
+    size_t start, end;
+    map_prefix_range(&option, "db.pool.", &start, &end);
+    cr_assert_eq(end - start, 2, "Only db.pool.size and db.pool.timeout should match");
+    cr_assert_str_eq(option.value.as_map[start].key, "db.pool.size");
+    cr_assert_str_eq(option.value.as_map[start + 1].key, "db.pool.timeout");
+
+    map_prefix_range(&option, "db.pool", &start, &end);
+    cr_assert_eq(end - start, 4, "db.pool, db.pool.size, db.pool.timeout and db.poolx match");
+
+    map_prefix_range(&option, "nothing", &start, &end);
+    cr_assert_eq(start, end, "A prefix matching no key gives an empty range");
+
+    map_prefix_range(&option, "", &start, &end);
+    cr_assert_eq(end - start, count, "The empty prefix matches every key");
+
+    for (size_t i = 0; i < option.value_count; i++)
+        free((void *)option.value.as_map[i].key);
+    free(option.value.as_map);
+}
@@ -161,21 +161,21 @@ Test(parsing, find_subcommand, .init = setup_subcommands)
 Test(parsing, find_option_by_active_path, .init = setup_subcommands)
 {
     // Test finding option at root level
-    cargs_option_t* option = find_option_by_active_path(test_cargs, "global");
+    cargs_option_t* option = find_option_by_active_path(&test_cargs, "global");
     cr_assert_not_null(option, "Should find option at root level");
     cr_assert_str_eq(option->name, "global", "Should find correct option");
     
     // Test finding option by explicit root path
-    option = find_option_by_active_path(test_cargs, ".global");
+    option = find_option_by_active_path(&test_cargs, ".global");
     cr_assert_not_null(option, "Should find option by explicit root path");
     cr_assert_str_eq(option->name, "global", "Should find correct option");
     
     // Test with subcommand path (should fail since no active subcommand)
-    option = find_option_by_active_path(test_cargs, "sub.debug");
+    option = find_option_by_active_path(&test_cargs, "sub.debug");
     cr_assert_null(option, "Should return NULL when no matching subcommand is active");
     
     // Test with an invalid path
-    option = find_option_by_active_path(test_cargs, "nonexistent.option");
+    option = find_option_by_active_path(&test_cargs, "nonexistent.option");
     cr_assert_null(option, "Should return NULL for invalid path");
     
     // Test with active subcommand
@@ -183,12 +183,12 @@ Test(parsing, find_option_by_active_path, .init = setup_subcommands)
     context_push_subcommand(&test_cargs, sub_cmd);
     
     // Now we should be able to find the subcommand option
-    option = find_option_by_active_path(test_cargs, "debug");
+    option = find_option_by_active_path(&test_cargs, "debug");
     cr_assert_not_null(option, "Should find option in active subcommand");
     cr_assert_str_eq(option->name, "debug", "Should find correct option in subcommand");
     
     // Still should be able to access root option with explicit path
-    option = find_option_by_active_path(test_cargs, ".global");
+    option = find_option_by_active_path(&test_cargs, ".global");
     cr_assert_not_null(option, "Should still find root option with explicit path");
     cr_assert_str_eq(option->name, "global", "Should find correct root option");
     
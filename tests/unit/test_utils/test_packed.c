@@ -0,0 +1,113 @@
+#include <criterion/criterion.h>
+#include "cargs/internal/packed.h"
+#include <limits.h>
+#include <stdlib.h>
+
+static cargs_value_t *make_values(const long long *source, size_t count)
+{
+    cargs_value_t *values = malloc(count * sizeof(*values));
+
+    cr_assert_not_null(values);
+    for (size_t i = 0; i < count; ++i)
+        values[i].as_int64 = source[i];
+    return (values);
+}
+
+// Every accessor must give back the original values
+static void assert_round_trip(const long long *source, size_t count)
+{
+    cargs_value_t  *values = make_values(source, count);
+    cargs_packed_t *packed = packed_encode(values, count);
+    long long      *copy   = malloc(count * sizeof(*copy));
+
+    cr_assert_not_null(packed);
+    cr_assert_not_null(copy);
+    cr_assert_eq(packed->count, count);
+    cr_assert_eq(packed->block_count, (count + CARGS_PACKED_BLOCK - 1) / CARGS_PACKED_BLOCK);
+
+    long long previous = 0;
+    for (size_t i = 0; i < count; ++i) {
+        cr_assert_eq(packed_at(packed, i), source[i], "packed_at(%zu)", i);
+        previous = packed_next(packed, i, previous);
+        cr_assert_eq(previous, source[i], "packed_next(%zu)", i);
+    }
+
+    cr_assert_eq(packed_copy(packed, 0, copy, count), count);
+    cr_assert_arr_eq(copy, source, count * sizeof(*copy));
+    free(copy);
+    free(packed);
+    free(values);
+}
+
+Test(packed, dense_ids)
+{
+    size_t     count  = 1000;
+    long long *source = malloc(count * sizeof(*source));
+
+    for (size_t i = 0; i < count; ++i)
+        source[i] = 5000 + (long long)i;
+    assert_round_trip(source, count);
+
+    cargs_value_t  *values = make_values(source, count);
+    cargs_packed_t *packed = packed_encode(values, count);
+    cr_assert_eq(packed->blocks[0].bits, 0, "Consecutive ids need no bits");
+    cr_assert_eq(packed->blocks[0].step, 1);
+    cr_assert_lt(packed->size, count, "Less than a byte per value");
+    free(packed);
+    free(values);
+    free(source);
+}
+
+Test(packed, sparse_ids)
+{
+    size_t     count  = 4 * CARGS_PACKED_BLOCK + 17;
+    long long *source = malloc(count * sizeof(*source));
+    long long  value  = -1000000;
+
+    srand(42);
+    for (size_t i = 0; i < count; ++i) {
+        value += 1 + rand() % 1000;
+        source[i] = value;
+    }
+    assert_round_trip(source, count);
+
+    cargs_value_t  *values = make_values(source, count);
+    cargs_packed_t *packed = packed_encode(values, count);
+    cr_assert_leq(packed->blocks[1].bits, 10, "Gaps below 1000 fit on 10 bits");
+    cr_assert_lt(packed->size, count * sizeof(cargs_value_t) / 4);
+    free(packed);
+    free(values);
+    free(source);
+}
+
+Test(packed, extreme_and_unsorted_values)
+{
+    long long extremes[] = {LLONG_MIN, -1, 0, 1, LLONG_MAX};
+    long long unsorted[] = {42, -7, LLONG_MAX, 3, LLONG_MIN, 3, 0};
+    long long single[]   = {-123456789012LL};
+
+    assert_round_trip(extremes, 5);
+    assert_round_trip(unsorted, 7);
+    assert_round_trip(single, 1);
+}
+
+Test(packed, copy_ranges)
+{
+    size_t     count  = 3 * CARGS_PACKED_BLOCK;
+    long long *source = malloc(count * sizeof(*source));
+    long long  out[200];
+
+    for (size_t i = 0; i < count; ++i)
+        source[i] = (long long)(i * i);
+    cargs_value_t  *values = make_values(source, count);
+    cargs_packed_t *packed = packed_encode(values, count);
+
+    cr_assert_eq(packed_copy(packed, 100, out, 200), 200, "Ranges can span blocks");
+    cr_assert_arr_eq(out, &source[100], 200 * sizeof(*out));
+    cr_assert_eq(packed_copy(packed, count - 5, out, 200), 5, "Copies stop at the end");
+    cr_assert_arr_eq(out, &source[count - 5], 5 * sizeof(*out));
+    cr_assert_eq(packed_copy(packed, count, out, 1), 0);
+    free(packed);
+    free(values);
+    free(source);
+}
@@ -3,6 +3,8 @@
 #include <criterion/criterion.h>
 #include "cargs/internal/utils.h"
 #include "cargs/types.h"
+#include <stdio.h>
+#include <stdlib.h>
 
 
 Test(value_utils, compare_values)
@@ -50,6 +52,26 @@ Test(value_utils, compare_values)
     cr_assert_neq(cmp_value(VALUE_TYPE_STRING, null_str, str1), 0, "NULL string should not equal non-NULL string");
 }
 
+Test(value_utils, compare_wide_integers)
+{
+    cargs_value_t big   = {.as_int64 = 5000000000LL};
+    cargs_value_t small = {.as_int64 = -5000000000LL};
+    cargs_value_t low   = {.as_int64 = 705032704LL}; // Same lower 32 bits as 5000000000
+
+    cr_assert_gt(cmp_value(VALUE_TYPE_INT, big, small), 0, "Comparison should not overflow");
+    cr_assert_lt(cmp_value(VALUE_TYPE_INT, small, big), 0, "Comparison should not overflow");
+    cr_assert_neq(cmp_value(VALUE_TYPE_INT, big, low), 0, "Upper bits should be compared");
+
+    char  *output = NULL;
+    size_t size   = 0;
+    FILE  *stream = open_memstream(&output, &size);
+    cr_assert_not_null(stream);
+    print_value(stream, VALUE_TYPE_INT, big);
+    fclose(stream);
+    cr_assert_str_eq(output, "5000000000", "Integers should be printed on 64 bits");
+    free(output);
+}
+
 Test(value_utils, choices_to_value)
 {
     // Test integer choices